@@ -445,11 +445,11 @@ void OpenRoad::readDb(const char* filename)
   }
 }
 
-void OpenRoad::writeDb(const char* filename)
+void OpenRoad::writeDb(const char* filename, bool compress)
 {
   FILE* stream = fopen(filename, "w");
   if (stream) {
-    db_->write(stream);
+    db_->write(stream, compress);
     fclose(stream);
   }
 }
@@ -553,6 +553,7 @@ void OpenRoad::setThreadCount(int threads, bool printInfo)
 
   // place limits on tools with threads
   sta_->setThreadCount(threads_);
+  db_->setThreadCount(threads_);
 }
 
 void OpenRoad::setThreadCount(const char* threads, bool printInfo)
@@ -36,6 +36,7 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -95,6 +96,10 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  bool adaptiveWorkers = false;
+  std::string paCacheFile;
+  bool incremental = false;
+  float mazeHeuristicWeight = 1;
 };
 
 class TritonRoute
@@ -181,9 +186,19 @@ class TritonRoute
                  const std::list<std::unique_ptr<fr::frMarker>>& markers,
                  odb::Rect bbox = odb::Rect(0, 0, 0, 0));
   void checkDRC(const char* drc_file, int x0, int y0, int x1, int y1);
+  // extra regions for the next checkDRC
+  void addDRCBox(const odb::Rect& box);
   bool initGuide();
   void prep();
   void processBTermsAboveTopLayer(bool has_routing = false);
+  // changes since the last detailed routing, recorded by the db callbacks
+  // for the incremental flow
+  void addDirtyNet(const std::string& name) { dirty_nets_.insert(name); }
+  void addDirtyInst(const std::string& name) { dirty_insts_.insert(name); }
+  void addDirtyRegion(const odb::Rect& region)
+  {
+    dirty_regions_.push_back(region);
+  }
 
  private:
   std::unique_ptr<fr::frDesign> design_;
@@ -205,14 +220,21 @@ class TritonRoute
   int results_sz_;
   unsigned int cloud_sz_;
   boost::asio::thread_pool dist_pool_;
+  bool routed_;
+  std::set<std::string> dirty_nets_;
+  std::set<std::string> dirty_insts_;
+  std::vector<odb::Rect> dirty_regions_;
+  std::vector<odb::Rect> drc_boxes_;
 
   void initDesign();
   void gr();
   void ta();
   void dr();
+  int mainIncremental();
+  void clearDirty();
   void applyUpdates(const std::vector<std::vector<fr::drUpdate>>& updates);
   void getDRCMarkers(std::list<std::unique_ptr<fr::frMarker>>& markers,
-                     const odb::Rect& requiredDrcBox);
+                     const std::vector<odb::Rect>& requiredDrcBoxes);
   void stackVias(odb::dbBTerm* bterm,
                  int top_layer_idx,
                  int bterm_bottom_layer_idx,
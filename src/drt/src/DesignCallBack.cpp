@@ -38,8 +38,76 @@ static inline int defdist(odb::dbBlock* block, int x)
          / (double) block->getDbUnitsPerMicron();
 }
 
+void DesignCallBack::markInstDirty(odb::dbInst* db_inst)
+{
+  router_->addDirtyInst(db_inst->getName());
+  markInstRegionDirty(db_inst);
+  for (auto iterm : db_inst->getITerms())
+    markNetDirty(iterm->getNet());
+}
+
+void DesignCallBack::markInstRegionDirty(odb::dbInst* db_inst)
+{
+  if (!db_inst->isPlaced())
+    return;
+  auto block = db_inst->getBlock();
+  odb::Rect box = db_inst->getBBox()->getBox();
+  router_->addDirtyRegion(odb::Rect(defdist(block, box.xMin()),
+                                    defdist(block, box.yMin()),
+                                    defdist(block, box.xMax()),
+                                    defdist(block, box.yMax())));
+}
+
+void DesignCallBack::markNetDirty(odb::dbNet* net)
+{
+  if (net != nullptr && !net->isSpecial())
+    router_->addDirtyNet(net->getName());
+}
+
+void DesignCallBack::inDbInstCreate(odb::dbInst* db_inst)
+{
+  markInstDirty(db_inst);
+}
+
+void DesignCallBack::inDbInstCreate(odb::dbInst* db_inst, odb::dbRegion*)
+{
+  markInstDirty(db_inst);
+}
+
+void DesignCallBack::inDbPreMoveInst(odb::dbInst* db_inst)
+{
+  // the routing around the old location has to be repaired too
+  markInstRegionDirty(db_inst);
+}
+
+void DesignCallBack::inDbInstSwapMasterAfter(odb::dbInst* db_inst)
+{
+  markInstDirty(db_inst);
+}
+
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  markNetDirty(iterm->getNet());
+}
+
+void DesignCallBack::inDbITermPreDisconnect(odb::dbITerm* iterm)
+{
+  markNetDirty(iterm->getNet());
+}
+
+void DesignCallBack::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  markNetDirty(bterm->getNet());
+}
+
+void DesignCallBack::inDbBTermPreDisconnect(odb::dbBTerm* bterm)
+{
+  markNetDirty(bterm->getNet());
+}
+
 void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 {
+  markInstDirty(db_inst);
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
@@ -61,6 +129,9 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 
 void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
 {
+  markInstRegionDirty(db_inst);
+  for (auto iterm : db_inst->getITerms())
+    markNetDirty(iterm->getNet());
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
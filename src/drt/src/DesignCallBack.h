@@ -36,10 +36,23 @@ class DesignCallBack : public odb::dbBlockCallBackObj
 {
  public:
   DesignCallBack(triton_route::TritonRoute* router) : router_(router) {}
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region) override;
+  void inDbPreMoveInst(odb::dbInst* inst) override;
   void inDbPostMoveInst(odb::dbInst* inst) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
 
  private:
+  // records the changes for the incremental routing
+  void markInstDirty(odb::dbInst* inst);
+  void markInstRegionDirty(odb::dbInst* inst);
+  void markNetDirty(odb::dbNet* net);
+
   triton_route::TritonRoute* router_;
 };
 }  // namespace fr
@@ -32,6 +32,8 @@
 #include <boost/bind/bind.hpp>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <tuple>
 
 #include "DesignCallBack.h"
 #include "db/tech/frTechObject.h"
@@ -57,6 +59,7 @@
 #include "sta/StaMain.hh"
 #include "stt/SteinerTreeBuilder.h"
 #include "ta/FlexTA.h"
+#include "utl/exception.h"
 using namespace std;
 using namespace fr;
 using namespace triton_route;
@@ -83,7 +86,8 @@ TritonRoute::TritonRoute()
       dist_port_(0),
       results_sz_(0),
       cloud_sz_(0),
-      dist_pool_(1)
+      dist_pool_(1),
+      routed_(false)
 {
 }
 
@@ -303,28 +307,27 @@ void TritonRoute::clearDesign()
   design_ = std::make_unique<frDesign>(logger_);
 }
 
-static void deserializeUpdate(frDesign* design,
-                              const std::string& updateStr,
-                              std::vector<drUpdate>& updates)
-{
-  std::ifstream file(updateStr.c_str());
-  frIArchive ar(file);
-  ar.setDesign(design);
-  registerTypes(ar);
-  ar >> updates;
-  file.close();
-}
-
+// Reads a design update file written by serializeUpdatesBatch or
+// serializeUpdates.
+template <typename T>
 static void deserializeUpdates(frDesign* design,
                                const std::string& updateStr,
-                               std::vector<std::vector<drUpdate>>& updates)
+                               T& updates,
+                               utl::Logger* logger)
 {
-  std::ifstream file(updateStr.c_str());
-  frIArchive ar(file);
+  std::ifstream file(updateStr.c_str(), std::ios::binary);
+  const std::string packed((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+  file.close();
+  frPayloadBuf buf;
+  if (!buf.open(packed)) {
+    logger->error(DRT, 630, "Unsupported design update file {}.", updateStr);
+  }
+  std::istream stream(&buf);
+  frIArchive ar(stream, boost::archive::no_header);
   ar.setDesign(design);
   registerTypes(ar);
   ar >> updates;
-  file.close();
 }
 
 void TritonRoute::updateDesign(const std::vector<std::string>& updatesStrs)
@@ -333,7 +336,7 @@ void TritonRoute::updateDesign(const std::vector<std::string>& updatesStrs)
   std::vector<std::vector<drUpdate>> updates(updatesStrs.size());
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < updatesStrs.size(); i++) {
-    deserializeUpdate(design_.get(), updatesStrs.at(i), updates[i]);
+    deserializeUpdates(design_.get(), updatesStrs.at(i), updates[i], logger_);
   }
   applyUpdates(updates);
 }
@@ -342,7 +345,7 @@ void TritonRoute::updateDesign(const std::string& path)
 {
   omp_set_num_threads(ord::OpenRoad::openRoad()->getThreadCount());
   std::vector<std::vector<drUpdate>> updates;
-  deserializeUpdates(design_.get(), path, updates);
+  deserializeUpdates(design_.get(), path, updates, logger_);
   applyUpdates(updates);
 }
 
@@ -521,6 +524,7 @@ void TritonRoute::initDesign()
     getDesign()->getTopBlock()->removeDeletedInsts();
     return;
   }
+  omp_set_num_threads(MAX_THREADS);
   io::Parser parser(db_, getDesign(), logger_);
   parser.readTechAndLibs(db_);
   processBTermsAboveTopLayer();
@@ -640,7 +644,7 @@ void TritonRoute::endFR()
     frList<std::unique_ptr<frMarker>> markers;
     auto blockBox = design_->getTopBlock()->getBBox();
     GC_IGNORE_PDN_LAYER = -1;
-    getDRCMarkers(markers, blockBox);
+    getDRCMarkers(markers, {blockBox});
     std::vector<std::pair<odb::Rect, odb::dbId<odb::dbSBox>>> allWires;
     for (auto* net : dbBlock->getNets()) {
       if (!net->getSigType().isSupply())
@@ -698,6 +702,9 @@ void TritonRoute::endFR()
                     removedBoxes.size(),
                     pdnLayer->getName());
   }
+  // the db now holds the routing of every change made before this run
+  clearDirty();
+  routed_ = true;
 }
 
 void TritonRoute::reportConstraints()
@@ -745,10 +752,13 @@ void TritonRoute::sendDesignDist()
 static void serializeUpdatesBatch(const std::vector<drUpdate>& batch,
                                   const std::string& file_name)
 {
-  std::ofstream file(file_name.c_str());
-  frOArchive ar(file);
+  std::stringstream stream(std::ios_base::binary | std::ios_base::in
+                           | std::ios_base::out);
+  frOArchive ar(stream, boost::archive::no_header);
   registerTypes(ar);
   ar << batch;
+  std::ofstream file(file_name.c_str(), std::ios::binary);
+  file << packPayload(stream.str());
   file.close();
 }
 
@@ -817,8 +827,142 @@ void TritonRoute::sendDesignUpdates(const std::string& globals_path)
   design_->incrementVersion();
 }
 
+void TritonRoute::clearDirty()
+{
+  dirty_nets_.clear();
+  dirty_insts_.clear();
+  dirty_regions_.clear();
+}
+
+// Reroutes the nets changed since the last detailed routing of this session.
+// The design is read back from the db so the other nets keep their routing.
+// The changed nets are ripped up, get new pin access (for the changed
+// instances), track assignment and detailed routing, and only the clips
+// touching them or the changed instances are worked on.
+int TritonRoute::mainIncremental()
+{
+  if (dirty_nets_.empty() && dirty_insts_.empty() && dirty_regions_.empty()) {
+    logger_->info(
+        DRT, 623, "No design changes since the last detailed routing.");
+    return 0;
+  }
+  MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
+  clearDesign();
+  initDesign();
+  auto block = db_->getChip()->getBlock();
+  auto topBlock = getDesign()->getTopBlock();
+
+  std::vector<odb::dbInst*> insts;
+  for (const auto& name : dirty_insts_) {
+    odb::dbInst* inst = block->findInst(name.c_str());
+    if (inst != nullptr) {
+      insts.push_back(inst);
+    }
+  }
+  if (!insts.empty()) {
+    FlexPA pa(getDesign(), logger_, dist_);
+    pa.setTargetInstances(insts);
+    pa.setDebug(debug_.get(), db_);
+    pa.main();
+  }
+
+  // rip up the changed nets
+  std::set<frNet*> nets;
+  for (const auto& name : dirty_nets_) {
+    frNet* net = topBlock->findNet(name);
+    if (net != nullptr && !net->isSpecial()) {
+      nets.insert(net);
+    }
+  }
+  std::vector<Rect> regions = dirty_regions_;
+  for (frNet* net : nets) {
+    std::vector<frShape*> shapes;
+    for (auto& shape : net->getShapes()) {
+      regions.push_back(shape->getBBox());
+      shapes.push_back(shape.get());
+    }
+    for (auto shape : shapes) {
+      net->removeShape(shape);
+    }
+    std::vector<frVia*> vias;
+    for (auto& via : net->getVias()) {
+      regions.push_back(via->getBBox());
+      vias.push_back(via.get());
+    }
+    for (auto via : vias) {
+      net->removeVia(via);
+    }
+    std::vector<frShape*> pwires;
+    for (auto& pwire : net->getPatchWires()) {
+      pwires.push_back(pwire.get());
+    }
+    for (auto pwire : pwires) {
+      net->removePatchWire(pwire);
+    }
+  }
+  getDesign()->getRegionQuery()->initDRObj();
+  logger_->info(DRT,
+                624,
+                "Incremental routing of {} nets and {} instances.",
+                nets.size(),
+                insts.size());
+
+  if (!initGuide()) {
+    logger_->error(
+        DRT, 625, "Incremental routing needs the global routing guides.");
+  }
+  for (frNet* net : nets) {
+    for (const auto& guide : net->getOrigGuides()) {
+      regions.push_back(guide.getBBox());
+    }
+  }
+  prep();
+  FlexTA ta(getDesign(), logger_, false);
+  ta.setTargetNets(nets);
+  ta.setDebug(debug_.get(), db_);
+  ta.main();
+
+  num_drvs_ = -1;
+  dr_ = std::make_unique<FlexDR>(this, getDesign(), logger_, db_);
+  dr_->setDebug(debug_.get());
+  dr_->setRouteRegions(regions);
+  dr_->main();
+  dr_.reset();
+
+  // write back the changed nets and the nets routed again around them
+  std::vector<frBlockObject*> objs;
+  for (const Rect& region : regions) {
+    objs.clear();
+    getDesign()->getRegionQuery()->queryDRObj(region, objs);
+    for (auto obj : objs) {
+      auto fig = static_cast<frConnFig*>(obj);
+      if (fig->hasNet()) {
+        nets.insert(fig->getNet());
+      }
+    }
+  }
+  io::Writer writer(getDesign(), logger_);
+  writer.setTargetNets(nets);
+  writer.updateDb(db_, false, /* snapshot */ true);
+
+  num_drvs_ = design_->getTopBlock()->getNumMarkers();
+  design_->clearUpdates();
+  design_->incrementVersion();
+  clearDirty();
+  return 0;
+}
+
 int TritonRoute::main()
 {
+  if (INCREMENTAL_DR) {
+    if (routed_) {
+      return mainIncremental();
+    }
+    logger_->info(DRT,
+                  626,
+                  "No previous detailed routing in this session, routing the "
+                  "whole design.");
+  }
   asio::thread_pool pa_pool(1);
   if (!distributed_)
     pa_pool.join();
@@ -917,22 +1061,68 @@ void TritonRoute::pinAccess(std::vector<odb::dbInst*> target_insts)
   writer.updateDb(db_, true);
 }
 
+// The die is tiled by size x size gcells and every tile is checked by its
+// own FlexGCWorker, all tiles in one parallel loop.  The workers see a halo
+// around their tile so a violation near a tile border is found by several
+// of them; it is only kept by the tile holding the lower left corner of
+// its bbox.  When that tile is not checked (outside of the required boxes)
+// the copies found by the checked tiles are merged instead.
 void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
-                                const Rect& requiredDrcBox)
+                                const std::vector<Rect>& requiredDrcBoxes)
 {
+  ProfileTask profile("DRC:check");
   MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
-  std::vector<std::vector<std::unique_ptr<FlexGCWorker>>> workersBatches(1);
-  auto size = 7;
-  auto offset = 0;
-  auto gCellPatterns = design_->getTopBlock()->getGCellPatterns();
-  auto& xgp = gCellPatterns.at(0);
-  auto& ygp = gCellPatterns.at(1);
-  for (int i = offset; i < (int) xgp.getCount(); i += size) {
-    for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      Rect routeBox1 = design_->getTopBlock()->getGCellBox(Point(i, j));
-      const int max_i = min((int) xgp.getCount() - 1, i + size - 1);
-      const int max_j = min((int) ygp.getCount(), j + size - 1);
-      Rect routeBox2 = design_->getTopBlock()->getGCellBox(Point(max_i, max_j));
+  const int size = 7;
+  auto topBlock = design_->getTopBlock();
+  const auto& gCellPatterns = topBlock->getGCellPatterns();
+  const auto& xgp = gCellPatterns.at(0);
+  const auto& ygp = gCellPatterns.at(1);
+  const int numTilesX = ((int) xgp.getCount() + size - 1) / size;
+  const int numTilesY = ((int) ygp.getCount() + size - 1) / size;
+  auto isRequired = [&requiredDrcBoxes](const Rect& box) {
+    for (const Rect& requiredDrcBox : requiredDrcBoxes) {
+      if (requiredDrcBox.intersects(box)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::vector<std::pair<int, int>> tiles;
+  std::vector<bool> isChecked(numTilesX * numTilesY, false);
+  for (int i = 0; i < numTilesX; i++) {
+    for (int j = 0; j < numTilesY; j++) {
+      const int max_i = min((int) xgp.getCount() - 1, (i + 1) * size - 1);
+      const int max_j = min((int) ygp.getCount() - 1, (j + 1) * size - 1);
+      Rect routeBox1 = topBlock->getGCellBox(Point(i * size, j * size));
+      Rect routeBox2 = topBlock->getGCellBox(Point(max_i, max_j));
+      Rect drcBox(routeBox1.xMin(),
+                  routeBox1.yMin(),
+                  routeBox2.xMax(),
+                  routeBox2.yMax());
+      drcBox.bloat(DRCSAFEDIST, drcBox);
+      if (isRequired(drcBox)) {
+        tiles.emplace_back(i, j);
+        isChecked[i * numTilesY + j] = true;
+      }
+    }
+  }
+
+  std::vector<std::vector<std::unique_ptr<frMarker>>> tileMarkers(
+      tiles.size());
+  // markers owned by a tile that is not checked, maybe found more than once
+  std::vector<std::vector<std::unique_ptr<frMarker>>> orphanMarkers(
+      tiles.size());
+  utl::ThreadException exception;
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel for schedule(dynamic)
+  for (int k = 0; k < (int) tiles.size(); k++) {
+    try {
+      const auto [i, j] = tiles[k];
+      const int max_i = min((int) xgp.getCount() - 1, (i + 1) * size - 1);
+      const int max_j = min((int) ygp.getCount() - 1, (j + 1) * size - 1);
+      Rect routeBox1 = topBlock->getGCellBox(Point(i * size, j * size));
+      Rect routeBox2 = topBlock->getGCellBox(Point(max_i, max_j));
       Rect routeBox(routeBox1.xMin(),
                     routeBox1.yMin(),
                     routeBox2.xMax(),
@@ -941,69 +1131,95 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
       Rect drcBox;
       routeBox.bloat(DRCSAFEDIST, drcBox);
       routeBox.bloat(MTSAFEDIST, extBox);
-      if (!drcBox.intersects(requiredDrcBox))
-        continue;
-      auto gcWorker
-          = std::make_unique<FlexGCWorker>(design_->getTech(), logger_);
-      gcWorker->setDrcBox(drcBox);
-      gcWorker->setExtBox(extBox);
-      if (workersBatches.back().size() >= BATCHSIZE)
-        workersBatches.push_back(std::vector<std::unique_ptr<FlexGCWorker>>());
-      workersBatches.back().push_back(std::move(gcWorker));
-    }
-  }
-  std::map<MarkerId, frMarker*> mapMarkers;
-  omp_set_num_threads(MAX_THREADS);
-  for (auto& workers : workersBatches) {
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < workers.size(); i++) {
-      workers[i]->init(design_.get());
-      workers[i]->main();
-    }
-    for (const auto& worker : workers) {
-      for (auto& marker : worker->getMarkers()) {
+      // the worker is dropped as soon as its markers are copied so the
+      // memory stays bounded by the number of threads
+      FlexGCWorker gcWorker(design_->getTech(), logger_);
+      gcWorker.setDrcBox(drcBox);
+      gcWorker.setExtBox(extBox);
+      gcWorker.init(design_.get());
+      gcWorker.main();
+      for (auto& marker : gcWorker.getMarkers()) {
         Rect bbox = marker->getBBox();
-        if (!bbox.intersects(requiredDrcBox))
-          continue;
-        auto layerNum = marker->getLayerNum();
-        auto con = marker->getConstraint();
-        std::vector<frBlockObject*> srcs(2, nullptr);
-        int i = 0;
-        for (auto& src : marker->getSrcs()) {
-          srcs.at(i) = src;
-          i++;
-        }
-        if (mapMarkers.find({bbox, layerNum, con, srcs[0], srcs[1]})
-            != mapMarkers.end()) {
+        if (!isRequired(bbox)) {
           continue;
         }
-        if (mapMarkers.find({bbox, layerNum, con, srcs[1], srcs[0]})
-            != mapMarkers.end()) {
-          continue;
+        const Point owner = topBlock->getGCellIdx(bbox.ll());
+        const int owner_i = owner.x() / size;
+        const int owner_j = owner.y() / size;
+        if (owner_i == i && owner_j == j) {
+          tileMarkers[k].push_back(std::make_unique<frMarker>(*marker));
+        } else if (!isChecked[owner_i * numTilesY + owner_j]) {
+          orphanMarkers[k].push_back(std::make_unique<frMarker>(*marker));
         }
-        markers.push_back(std::make_unique<frMarker>(*marker));
-        mapMarkers[{bbox, layerNum, con, srcs[0], srcs[1]}]
-            = markers.back().get();
+      }
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  using MarkerKey = std::tuple<int,
+                               int,
+                               int,
+                               int,
+                               frLayerNum,
+                               frConstraint*,
+                               std::set<frBlockObject*>>;
+  std::set<MarkerKey> orphanKeys;
+  for (int k = 0; k < (int) tiles.size(); k++) {
+    for (auto& marker : tileMarkers[k]) {
+      markers.push_back(std::move(marker));
+    }
+    for (auto& marker : orphanMarkers[k]) {
+      const Rect bbox = marker->getBBox();
+      MarkerKey key(bbox.xMin(),
+                    bbox.yMin(),
+                    bbox.xMax(),
+                    bbox.yMax(),
+                    marker->getLayerNum(),
+                    marker->getConstraint(),
+                    marker->getSrcs());
+      if (orphanKeys.insert(std::move(key)).second) {
+        markers.push_back(std::move(marker));
       }
     }
-    workers.clear();
   }
 }
 
+void TritonRoute::addDRCBox(const odb::Rect& box)
+{
+  drc_boxes_.push_back(box);
+}
+
 void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
 {
   GC_IGNORE_PDN_LAYER = -1;
   initDesign();
   if (design_->getTopBlock()->getGCellPatterns().empty()) {
-    initGuide();
+    // the gcell grid of the db is enough for checking, only fall back to
+    // the guides when there is none
+    if (db_->getChip()->getBlock()->getGCellGrid() != nullptr) {
+      io::Parser parser(db_, getDesign(), logger_);
+      parser.buildGCellPatterns(db_);
+    } else {
+      initGuide();
+    }
   }
+  std::vector<Rect> requiredDrcBoxes;
+  requiredDrcBoxes.swap(drc_boxes_);
   Rect requiredDrcBox(x1, y1, x2, y2);
-  if (requiredDrcBox.area() == 0) {
+  if (requiredDrcBox.area() != 0) {
+    requiredDrcBoxes.push_back(requiredDrcBox);
+  }
+  if (requiredDrcBoxes.empty()) {
     requiredDrcBox = design_->getTopBlock()->getBBox();
+    requiredDrcBoxes.push_back(requiredDrcBox);
   }
   frList<std::unique_ptr<frMarker>> markers;
-  getDRCMarkers(markers, requiredDrcBox);
-  reportDRC(filename, markers, requiredDrcBox);
+  getDRCMarkers(markers, requiredDrcBoxes);
+  logger_->info(DRT, 627, "Found {} DRC violations.", markers.size());
+  // markers are already restricted to the boxes
+  reportDRC(filename, markers);
 }
 
 void TritonRoute::processBTermsAboveTopLayer(bool has_routing)
@@ -1253,6 +1469,10 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  ADAPTIVE_WORKERS = params.adaptiveWorkers;
+  PA_CACHE_FILE = params.paCacheFile;
+  INCREMENTAL_DR = params.incremental;
+  MAZE_HEURISTIC_WEIGHT = params.mazeHeuristicWeight;
 }
 
 void TritonRoute::addWorkerResults(
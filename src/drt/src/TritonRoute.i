@@ -95,7 +95,11 @@ void detailed_route_cmd(const char* outputMazeFile,
                         int minAccessPoints,
                         bool saveGuideUpdates,
                         const char* repairPDNLayerName,
-                        int drcReportIterStep)
+                        int drcReportIterStep,
+                        bool adaptiveWorkers,
+                        const char* paCacheFile,
+                        bool incremental,
+                        float mazeHeuristicWeight)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   std::optional<int> drcReportIterStepOpt;
@@ -122,7 +126,11 @@ void detailed_route_cmd(const char* outputMazeFile,
                     singleStepDR,
                     minAccessPoints,
                     saveGuideUpdates,
-                    repairPDNLayerName});
+                    repairPDNLayerName,
+                    adaptiveWorkers,
+                    paCacheFile,
+                    incremental,
+                    mazeHeuristicWeight});
   router->main();
   router->setDistributed(false);
 }
@@ -131,7 +139,8 @@ void pin_access_cmd(const char* dbProcessNode,
                     const char* bottomRoutingLayer,
                     const char* topRoutingLayer,
                     int verbose,
-                    int minAccessPoints)
+                    int minAccessPoints,
+                    const char* paCacheFile)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
   triton_route::ParamStruct params;
@@ -140,6 +149,7 @@ void pin_access_cmd(const char* dbProcessNode,
   params.topRoutingLayer = topRoutingLayer;
   params.verbose = verbose;
   params.minAccessPoints = minAccessPoints;
+  params.paCacheFile = paCacheFile;
   router->setParams(params);
   router->pinAccess();
   router->setDistributed(false);
@@ -241,6 +251,12 @@ void step_end()
   router->endFR();
 }
 
+void check_drc_add_box(int x1, int y1, int x2, int y2)
+{
+  auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
+  router->addDRCBox(odb::Rect(x1, y1, x2, y2));
+}
+
 void check_drc_cmd(const char* drc_file, int x1, int y1, int x2, int y2)
 {
   auto* router = ord::OpenRoad::openRoad()->getTritonRoute();
@@ -60,6 +60,10 @@ sta::define_cmd_args "detailed_route" {
     [-min_access_points count]
     [-save_guide_updates]
     [-repair_pdn_vias layer]
+    [-adaptive_workers]
+    [-pin_access_cache filename]
+    [-incremental]
+    [-maze_heuristic_weight weight]
 }
 
 proc detailed_route { args } {
@@ -68,8 +72,10 @@ proc detailed_route { args } {
       -db_process_node -droute_end_iter -via_in_pin_bottom_layer \
       -via_in_pin_top_layer -or_seed -or_k -bottom_routing_layer \
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
-      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
-    flags {-disable_via_gen -distributed -clean_patches -no_pin_access -single_step_dr -save_guide_updates}
+      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step \
+      -pin_access_cache -maze_heuristic_weight} \
+    flags {-disable_via_gen -distributed -clean_patches -no_pin_access -single_step_dr -save_guide_updates \
+      -adaptive_workers -incremental}
   sta::check_argc_eq0 "detailed_route" $args
 
   set enable_via_gen [expr ![info exists flags(-disable_via_gen)]]
@@ -79,6 +85,8 @@ proc detailed_route { args } {
   # development.  It is not listed in the help string intentionally.
   set single_step_dr  [expr [info exists flags(-single_step_dr)]]
   set save_guide_updates  [expr [info exists flags(-save_guide_updates)]]
+  set adaptive_workers [expr [info exists flags(-adaptive_workers)]]
+  set incremental [expr [info exists flags(-incremental)]]
   if { [info exists keys(-param)] } {
     if { [array size keys] > 1 } {
       utl::error DRT 251 "-param cannot be used with other arguments"
@@ -91,6 +99,21 @@ proc detailed_route { args } {
     } else {
       set repair_pdn_vias ""
     }
+    if { [info exists keys(-pin_access_cache)] } {
+      set pa_cache_file $keys(-pin_access_cache)
+    } else {
+      set pa_cache_file ""
+    }
+    if { [info exists keys(-maze_heuristic_weight)] } {
+      set maze_heuristic_weight $keys(-maze_heuristic_weight)
+      sta::check_positive_float "-maze_heuristic_weight" \
+        $maze_heuristic_weight
+      if { $maze_heuristic_weight < 1 } {
+        utl::error DRT 628 "-maze_heuristic_weight must be at least 1."
+      }
+    } else {
+      set maze_heuristic_weight 1
+    }
     if { [info exists keys(-output_maze)] } {
       set output_maze $keys(-output_maze)
     } else {
@@ -202,7 +225,8 @@ proc detailed_route { args } {
       $via_in_pin_bottom_layer $via_in_pin_top_layer \
       $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
       $clean_patches $no_pin_access $single_step_dr $min_access_points \
-      $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+      $save_guide_updates $repair_pdn_vias $drc_report_iter_step \
+      $adaptive_workers $pa_cache_file $incremental $maze_heuristic_weight
   }
 }
 
@@ -292,6 +316,7 @@ sta::define_cmd_args "pin_access" {
     [-bottom_routing_layer layer]
     [-top_routing_layer layer]
     [-min_access_points count]
+    [-pin_access_cache filename]
     [-verbose level]
     [-distributed]
     [-remote_host rhost]
@@ -302,7 +327,8 @@ sta::define_cmd_args "pin_access" {
 proc pin_access { args } {
   sta::parse_key_args "pin_access" args \
       keys {-db_process_node -bottom_routing_layer -top_routing_layer -verbose \
-            -min_access_points -remote_host -remote_port -shared_volume -cloud_size } \
+            -min_access_points -pin_access_cache -remote_host -remote_port \
+            -shared_volume -cloud_size } \
       flags {-distributed}
   sta::check_argc_eq0 "detailed_route_debug" $args
   if [info exists keys(-db_process_node)] {
@@ -332,6 +358,11 @@ proc pin_access { args } {
   } else {
     set min_access_points -1
   }
+  if { [info exists keys(-pin_access_cache)] } {
+    set pa_cache_file $keys(-pin_access_cache)
+  } else {
+    set pa_cache_file ""
+  }
   if { [info exists flags(-distributed)] } {
     if { [info exists keys(-remote_host)] } {
       set rhost $keys(-remote_host)
@@ -355,7 +386,7 @@ proc pin_access { args } {
     }
     drt::detailed_route_distributed $rhost $rport $vol $cloudsz
   }
-  drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose $min_access_points
+  drt::pin_access_cmd $db_process_node $bottom_routing_layer $top_routing_layer $verbose $min_access_points $pa_cache_file
 }
 
 sta::define_cmd_args "detailed_route_run_worker" {
@@ -470,11 +501,12 @@ proc step_dr { args } {
 
 sta::define_cmd_args "check_drc" {
     [-box box]
+    [-boxes boxes]
     [-output_file filename]
 }
 proc check_drc { args } {
   sta::parse_key_args "check_drc" args \
-      keys { -box -output_file } \
+      keys { -box -boxes -output_file } \
       flags {}
   sta::check_argc_eq0 "check_drc" $args
   set box { 0 0 0 0 }
@@ -490,6 +522,15 @@ proc check_drc { args } {
   } else {
     utl::error DRT 613 "-output_file is required for check_drc command"
   }
+  if [info exists keys(-boxes)] {
+    foreach region $keys(-boxes) {
+      if { [llength $region] != 4 } {
+        utl::error DRT 614 "-boxes is a list of boxes of 4 coordinates."
+      }
+      lassign $region rx1 ry1 rx2 ry2
+      drt::check_drc_add_box $rx1 $ry1 $rx2 $ry2
+    }
+  }
   drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2
 }
 
@@ -1,5 +1,7 @@
 #include "frConstraint.h"
 
+#include <set>
+
 #include "frLayer.h"
 using namespace fr;
 
@@ -9,4 +11,149 @@ frCoord frSpacingTableTwConstraint::find(frCoord width1,
 {
   auto dbLayer = layer_->getDbLayer();
   return dbLayer->findTwSpacing(width1, width2, prl);
-}
\ No newline at end of file
+}
+void frLef58MinimumcutConstraint::hash(std::size_t& seed) const
+{
+  hashCombine(seed,
+              db_rule_->getNumCuts(),
+              db_rule_->getCutClassCutsMap(),
+              db_rule_->getWidth(),
+              db_rule_->getWithinCutDist(),
+              db_rule_->getLength(),
+              db_rule_->getLengthWithinDist(),
+              db_rule_->getArea(),
+              db_rule_->getAreaWithinDist(),
+              db_rule_->isPerCutClass(),
+              db_rule_->isWithinCutDistValid(),
+              db_rule_->isFromAbove(),
+              db_rule_->isFromBelow(),
+              db_rule_->isLengthValid(),
+              db_rule_->isAreaValid(),
+              db_rule_->isAreaWithinDistValid(),
+              db_rule_->isSameMetalOverlap(),
+              db_rule_->isFullyEnclosed());
+}
+
+// The class entries of the rule are only reachable through lookups, so the
+// lookups are hashed for every pair of classes named in the table.
+void frLef58CutSpacingTableConstraint::hash(std::size_t& seed) const
+{
+  hashCombine(seed,
+              default_spacing_,
+              default_center2center_,
+              default_centerAndEdge_,
+              db_rule_->getDefault(),
+              db_rule_->getPrl(),
+              db_rule_->getExtension(),
+              db_rule_->isDefaultValid(),
+              db_rule_->isSameMask(),
+              db_rule_->isSameNet(),
+              db_rule_->isSameMetal(),
+              db_rule_->isSameVia(),
+              db_rule_->isLayerValid(),
+              db_rule_->isNoStack(),
+              db_rule_->isNonZeroEnclosure(),
+              db_rule_->isPrlForAlignedCut(),
+              db_rule_->isCenterToCenterValid(),
+              db_rule_->isCenterAndEdgeValid(),
+              db_rule_->isNoPrl(),
+              db_rule_->isPrlValid(),
+              db_rule_->isMaxXY(),
+              db_rule_->isEndExtensionValid(),
+              db_rule_->isSideExtensionValid(),
+              db_rule_->isExactAlignedSpacingValid(),
+              db_rule_->isHorizontal(),
+              db_rule_->isPrlHorizontal(),
+              db_rule_->isVertical(),
+              db_rule_->isPrlVertical(),
+              db_rule_->isNonOppositeEnclosureSpacingValid(),
+              db_rule_->isOppositeEnclosureResizeSpacingValid());
+  if (db_rule_->isLayerValid()) {
+    hashCombine(seed, db_rule_->getSecondLayer()->getName());
+  }
+  std::vector<std::vector<std::pair<int, int>>> table;
+  std::map<std::string, uint> rowMap;
+  std::map<std::string, uint> colMap;
+  db_rule_->getSpacingTable(table, rowMap, colMap);
+  hashCombine(seed, table, rowMap, colMap);
+  // the table names classes as CLASS/SIDE or CLASS/END
+  auto getClasses = [](const std::map<std::string, uint>& map) {
+    std::set<std::string> classes;
+    for (const auto& [name, idx] : map) {
+      classes.insert(name.substr(0, name.find('/')));
+    }
+    return classes;
+  };
+  using Rule = odb::dbTechLayerCutSpacingTableDefRule;
+  const std::set<std::string> rowClasses = getClasses(rowMap);
+  const std::set<std::string> colClasses = getClasses(colMap);
+  for (const std::string& rowClass : rowClasses) {
+    hashCombine(seed, db_rule_->getExactAlignedSpacing(rowClass));
+    for (const std::string& colClass : colClasses) {
+      hashCombine(seed,
+                  db_rule_->isCenterToCenter(rowClass, colClass),
+                  db_rule_->isCenterAndEdge(rowClass, colClass),
+                  db_rule_->isPrlForAlignedCutClasses(rowClass, colClass),
+                  db_rule_->getPrlEntry(rowClass, colClass));
+      for (bool rowSide : {true, false}) {
+        for (bool colSide : {true, false}) {
+          for (auto strategy : {Rule::FIRST, Rule::SECOND}) {
+            hashCombine(seed,
+                        db_rule_->getSpacing(
+                            rowClass, rowSide, colClass, colSide, strategy));
+          }
+        }
+      }
+    }
+  }
+}
+
+void frMetalWidthViaConstraint::hash(std::size_t& seed) const
+{
+  hashCombine(seed,
+              dbRule->getCutLayer()->getName(),
+              dbRule->isViaCutClass(),
+              dbRule->getBelowLayerWidthLow(),
+              dbRule->getBelowLayerWidthHigh(),
+              dbRule->getAboveLayerWidthLow(),
+              dbRule->getAboveLayerWidthHigh(),
+              dbRule->getViaName(),
+              dbRule->isPgVia());
+}
+
+void frLef58AreaConstraint::hash(std::size_t& seed) const
+{
+  auto trimLayer = db_rule_->getTrimLayer();
+  hashCombine(seed,
+              db_rule_->getArea(),
+              db_rule_->getExceptMinWidth(),
+              db_rule_->getExceptEdgeLength(),
+              db_rule_->getExceptEdgeLengths(),
+              db_rule_->getExceptMinSize(),
+              db_rule_->getExceptStep(),
+              db_rule_->getMask(),
+              db_rule_->getRectWidth(),
+              db_rule_->isExceptRectangle(),
+              db_rule_->getOverlap(),
+              trimLayer != nullptr ? trimLayer->getName() : "");
+}
+
+void frLef58KeepOutZoneConstraint::hash(std::size_t& seed) const
+{
+  hashCombine(seed,
+              db_rule_->getFirstCutClass(),
+              db_rule_->getSecondCutClass(),
+              db_rule_->getAlignedSpacing(),
+              db_rule_->getSideExtension(),
+              db_rule_->getForwardExtension(),
+              db_rule_->getEndSideExtension(),
+              db_rule_->getEndForwardExtension(),
+              db_rule_->getSideSideExtension(),
+              db_rule_->getSideForwardExtension(),
+              db_rule_->getSpiralExtension(),
+              db_rule_->isSameMask(),
+              db_rule_->isSameMetal(),
+              db_rule_->isDiffMetal(),
+              db_rule_->isExceptAlignedSide(),
+              db_rule_->isExceptAlignedEnd());
+}
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <algorithm>
+#include <boost/functional/hash.hpp>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -69,6 +70,13 @@ struct drEolSpacingConstraint
   frCoord eolWithin;
 };
 
+// boost::hash_combine of several values
+template <typename... Values>
+void hashCombine(std::size_t& seed, const Values&... values)
+{
+  (boost::hash_combine(seed, values), ...);
+}
+
 // base type for design rule
 class frConstraint
 {
@@ -76,6 +84,8 @@ class frConstraint
   virtual ~frConstraint() {}
   virtual frConstraintTypeEnum typeId() const = 0;
   virtual void report(utl::Logger* logger) const = 0;
+  // combines the values of the rule into seed
+  virtual void hash(std::size_t& seed) const = 0;
   void setLayer(frLayer* layer) { layer_ = layer; }
   void setId(int in) { id_ = in; }
   int getId() const { return id_; }
@@ -233,6 +243,15 @@ class frConstraint
   int id_;
   frLayer* layer_;
   frConstraint() : id_(-1), layer_(nullptr) {}
+
+  // combines an optional sub rule into seed
+  static void hashRule(std::size_t& seed, const frConstraint* rule)
+  {
+    boost::hash_combine(seed, rule != nullptr);
+    if (rule != nullptr) {
+      rule->hash(seed);
+    }
+  }
 };
 
 class frLef58CutClassConstraint : public frConstraint
@@ -261,6 +280,16 @@ class frLef58CutClassConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58CutClassConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    for (const auto& [name, cutClass] : cutClasses) {
+      hashCombine(seed,
+                  name,
+                  cutClass->getViaWidth(),
+                  cutClass->getViaLength(),
+                  cutClass->getNumCut());
+    }
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Cut class");
@@ -278,6 +307,7 @@ class frRecheckConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcRecheckConstraint;
   }
+  void hash(std::size_t& /* seed */) const override {}
   void report(utl::Logger* logger) const override { logger->report("Recheck"); }
 };
 
@@ -290,6 +320,7 @@ class frShortConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcShortConstraint;
   }
+  void hash(std::size_t& /* seed */) const override {}
   void report(utl::Logger* logger) const override { logger->report("Short"); }
 };
 
@@ -301,6 +332,7 @@ class frNonSufficientMetalConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcNonSufficientMetalConstraint;
   }
+  void hash(std::size_t& /* seed */) const override {}
   void report(utl::Logger* logger) const override { logger->report("NSMetal"); }
 };
 
@@ -312,6 +344,7 @@ class frOffGridConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcOffGridConstraint;
   }
+  void hash(std::size_t& /* seed */) const override {}
   void report(utl::Logger* logger) const override
   {
     logger->report("Off grid");
@@ -336,6 +369,10 @@ class frMinEnclosedAreaConstraint : public frConstraint
     return frConstraintTypeEnum::frcMinEnclosedAreaConstraint;
   }
 
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, area, width);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Min enclosed area {} width {}", area, width);
@@ -389,6 +426,27 @@ class frLef58MinStepConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58MinStepConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                minStepLength,
+                insideCorner,
+                outsideCorner,
+                step,
+                maxLength,
+                maxEdges,
+                minAdjLength,
+                convexCorner,
+                exceptWithin,
+                concaveCorner,
+                threeConcaveCorners,
+                width,
+                minAdjLength2,
+                minBetweenLength,
+                exceptSameCorners,
+                eolWidth,
+                concaveCorners);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -479,6 +537,17 @@ class frMinStepConstraint : public frConstraint
     return frConstraintTypeEnum::frcMinStepConstraint;
   }
 
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                minStepLength,
+                minstepType,
+                maxLength,
+                insideCorner,
+                outsideCorner,
+                step,
+                maxEdges);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -544,6 +613,11 @@ class frMinimumcutConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcMinimumcutConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(
+        seed, numCuts, width, cutDistance, connection, length, distance);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -580,6 +654,7 @@ class frLef58MinimumcutConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58MinimumCutConstraint;
   }
+  void hash(std::size_t& seed) const override;
   void report(utl::Logger* logger) const override
   {
     logger->report("LEF58_MINIMUMCUT");
@@ -605,6 +680,10 @@ class frAreaConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcAreaConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, minArea);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Area {}", minArea);
@@ -629,6 +708,10 @@ class frMinWidthConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcMinWidthConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, minWidth);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Width {}", minWidth);
@@ -670,6 +753,10 @@ class frLef58SpacingEndOfLineWithinEncloseCutConstraint : public frConstraint
     return frConstraintTypeEnum::
         frcLef58SpacingEndOfLineWithinEncloseCutConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, below, above, encloseDist, cutToMetalSpace, allCuts);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -746,6 +833,19 @@ class frLef58SpacingEndOfLineWithinEndToEndConstraint : public frConstraint
     return frConstraintTypeEnum::
         frcLef58SpacingEndOfLineWithinEndToEndConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                endToEndSpace,
+                cutSpace,
+                oneCutSpace,
+                twoCutSpace,
+                hExtension,
+                extension,
+                wrongDirExtension,
+                hOtherEndWidth,
+                otherEndWidth);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -833,6 +933,21 @@ class frLef58SpacingEndOfLineWithinParallelEdgeConstraint : public frConstraint
     return frConstraintTypeEnum::
         frcLef58SpacingEndOfLineWithinParallelEdgeConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                subtractEolWidth,
+                parSpace,
+                parWithin,
+                hPrl,
+                prl,
+                hMinLength,
+                minLength,
+                twoEdges,
+                sameMetal,
+                nonEolCornerOnly,
+                parallelSameMask);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -893,6 +1008,10 @@ class frLef58SpacingEndOfLineWithinMaxMinLengthConstraint : public frConstraint
     return frConstraintTypeEnum::
         frcLef58SpacingEndOfLineWithinMaxMinLengthConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, maxLength, length, twoSides);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1037,6 +1156,21 @@ class frLef58SpacingEndOfLineWithinConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58SpacingEndOfLineWithinConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                hOppositeWidth,
+                oppositeWidth,
+                eolWithin,
+                wrongDirWithin,
+                endPrlSpacing,
+                endPrl,
+                sameMask);
+    hashRule(seed, endToEndConstraint.get());
+    hashRule(seed, parallelEdgeConstraint.get());
+    hashRule(seed, maxMinLengthConstraint.get());
+    hashRule(seed, encloseCutConstraint.get());
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1122,6 +1256,12 @@ class frLef58SpacingEndOfLineConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58SpacingEndOfLineConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(
+        seed, eolSpace, eolWidth, exactWidth, wrongDirSpacing, wrongDirSpace);
+    hashRule(seed, withinConstraint.get());
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1183,6 +1323,18 @@ class frLef58EolKeepOutConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58EolKeepOutConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                backwardExt,
+                sideExt,
+                forwardExt,
+                eolWidth,
+                cornerOnly,
+                exceptWithin,
+                withinLow,
+                withinHigh);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1226,6 +1378,10 @@ class frSpacingConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcSpacingConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, minSpacing);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Spacing {}", minSpacing);
@@ -1252,6 +1408,11 @@ class frSpacingSamenetConstraint : public frSpacingConstraint
   {
     return frConstraintTypeEnum::frcSpacingSamenetConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    frSpacingConstraint::hash(seed);
+    hashCombine(seed, pgonly);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Spacing same net pgonly {}", pgonly);
@@ -1291,6 +1452,10 @@ class frSpacingTableInfluenceConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcSpacingTableInfluenceConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, tbl);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Spacing table influence");
@@ -1331,6 +1496,11 @@ class frSpacingEndOfLineConstraint : public frSpacingConstraint
   {
     return frConstraintTypeEnum::frcSpacingEndOfLineConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    frSpacingConstraint::hash(seed);
+    hashCombine(seed, eolWidth, eolWithin, parSpace, parWithin, isTwoEdges);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1377,6 +1547,11 @@ class frLef58EolExtensionConstraint : public frSpacingConstraint
     return frConstraintTypeEnum::frcLef58EolExtensionConstraint;
   }
 
+  void hash(std::size_t& seed) const override
+  {
+    frSpacingConstraint::hash(seed);
+    hashCombine(seed, parallelOnly, extensionTbl);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("EOLEXTENSIONSPACING spacing {} parallelonly {} ",
@@ -1414,6 +1589,7 @@ class frLef58CutSpacingTableConstraint : public frConstraint
   {
     return db_rule_;
   }
+  void hash(std::size_t& seed) const override;
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1469,6 +1645,10 @@ class frSpacingTablePrlConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcSpacingTablePrlConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, tbl);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Spacing table PRL");
@@ -1512,6 +1692,13 @@ class frSpacingTableTwConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcSpacingTableTwConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    for (const frSpacingTableTwRowType& row : rows) {
+      hashCombine(seed, row.width, row.prl);
+    }
+    hashCombine(seed, spacingTbl);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Spacing table tw");
@@ -1563,6 +1750,12 @@ class frSpacingTableConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcSpacingTableConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    if (parallelRunLengthConstraint != nullptr) {
+      hashCombine(seed, *parallelRunLengthConstraint);
+    }
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Spacing table");
@@ -1625,6 +1818,16 @@ class frLef58SpacingTableConstraint : public frSpacingTableConstraint
     return frConstraintTypeEnum::frcLef58SpacingTableConstraint;
   }
 
+  void hash(std::size_t& seed) const override
+  {
+    frSpacingTableConstraint::hash(seed);
+    hashCombine(seed,
+                exceptWithinConstraint,
+                wrongDirection,
+                sameMask,
+                exceptEol,
+                eolWidth);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -1706,6 +1909,23 @@ class frCutSpacingConstraint : public frConstraint
   bool isTwoCuts() const { return (twoCuts == -1); }
   int getTwoCuts() const { return twoCuts; }
 
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                cutSpacing,
+                centerToCenter,
+                sameNet,
+                sameNetConstraint != nullptr,
+                stack,
+                exceptSamePGNet,
+                parallelOverlap,
+                secondLayerName,
+                secondLayerNum,
+                adjacentCuts,
+                cutWithin,
+                cutArea,
+                twoCuts);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("Cut Spacing");
@@ -1942,6 +2162,62 @@ class frLef58CutSpacingConstraint : public frConstraint
     return frConstraintTypeEnum::frcLef58CutSpacingConstraint;
   }
 
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                cutSpacing,
+                sameMask,
+                maxXY,
+                centerToCenter,
+                sameNet,
+                sameMetal,
+                sameVia,
+                secondLayerName,
+                secondLayerNum,
+                stack,
+                orthogonalSpacing,
+                cutClassName,
+                cutClassIdx,
+                shortEdgeOnly,
+                prl,
+                concaveCorner,
+                width,
+                enclosure,
+                edgeLength,
+                parLength,
+                parWithin,
+                edgeEnclosure,
+                adjEnclosure,
+                extension,
+                eolWidth,
+                minLength,
+                maskOverlap,
+                wrongDirection,
+                adjacentCuts,
+                exactAlignedCut,
+                twoCuts,
+                twoCutsSpacing,
+                sameCut,
+                cutWithin1,
+                cutWithin2,
+                exceptSamePGNet,
+                exceptAllWithin,
+                above,
+                below,
+                toAll,
+                noPrl,
+                sideParallelOverlap,
+                parallelOverlap,
+                exceptSameNet,
+                exceptSameMetal,
+                exceptSameMetalOverlap,
+                exceptSameVia,
+                within,
+                longEdgeOnly,
+                exceptTwoEdges,
+                numCut,
+                cutArea);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -2156,6 +2432,25 @@ class frLef58CornerSpacingConstraint : public frConstraint
   }
   void setSameXY(bool in) { sameXY = in; }
   void setCornerToCorner(bool in) { cornerToCorner = in; }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed,
+                cornerType,
+                sameMask,
+                within,
+                eolWidth,
+                length,
+                edgeLength,
+                includeLShape,
+                minLength,
+                exceptNotch,
+                notchLength,
+                exceptSameNet,
+                exceptSameMetal,
+                tbl,
+                sameXY,
+                cornerToCorner);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report(
@@ -2224,6 +2519,10 @@ class frLef58CornerSpacingSpacingConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58CornerSpacingSpacingConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, width);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("58 Corner spacing spacing {}", width);
@@ -2252,6 +2551,11 @@ class frLef58CornerSpacingSpacing1DConstraint
     return frConstraintTypeEnum::frcLef58CornerSpacingSpacing1DConstraint;
   }
 
+  void hash(std::size_t& seed) const override
+  {
+    frLef58CornerSpacingSpacingConstraint::hash(seed);
+    hashCombine(seed, spacing);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("58 Corner spacing 1D {}", spacing);
@@ -2291,6 +2595,11 @@ class frLef58CornerSpacingSpacing2DConstraint
   {
     return frConstraintTypeEnum::frcLef58CornerSpacingSpacing2DConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    frLef58CornerSpacingSpacingConstraint::hash(seed);
+    hashCombine(seed, horizontalSpacing, verticalSpacing);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("58 Corner spacing spacing 2D h {} v {}",
@@ -2322,6 +2631,10 @@ class frLef58RectOnlyConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58RectOnlyConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, exceptNonCorePins);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("RECTONLY exceptNonCorePins {}", exceptNonCorePins);
@@ -2348,6 +2661,10 @@ class frLef58RightWayOnGridOnlyConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58RightWayOnGridOnlyConstraint;
   }
+  void hash(std::size_t& seed) const override
+  {
+    hashCombine(seed, checkMask);
+  }
   void report(utl::Logger* logger) const override
   {
     logger->report("RIGHTWAYONGRIDONLY checkMask {}", checkMask);
@@ -2366,6 +2683,7 @@ class frMetalWidthViaConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcMetalWidthViaConstraint;
   }
+  void hash(std::size_t& seed) const override;
   void report(utl::Logger* logger) const override
   {
     logger->report("METALWIDTHVIAMAP");
@@ -2389,6 +2707,7 @@ class frLef58AreaConstraint : public frConstraint
     return frConstraintTypeEnum::frcLef58AreaConstraint;
   }
 
+  void hash(std::size_t& seed) const override;
   void report(utl::Logger* logger) const override
   {
     auto trim_layer = db_rule_->getTrimLayer();
@@ -2433,6 +2752,7 @@ class frLef58KeepOutZoneConstraint : public frConstraint
   {
     return frConstraintTypeEnum::frcLef58KeepOutZoneConstraint;
   }
+  void hash(std::size_t& seed) const override;
   void report(utl::Logger* logger) const override
   {
     logger->report("LEF58_KEEPOUTZONE");
@@ -261,6 +261,10 @@ class frLayer
   {
     return cutClasses[cutClassIdx];
   }
+  const std::vector<frLef58CutClass*>& getCutClasses() const
+  {
+    return cutClasses;
+  }
 
   void printCutClasses()
   {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/functional/hash.hpp>
 #include <iostream>
 
 #include "frBaseTypes.h"
@@ -104,6 +105,15 @@ class fr1DLookupTbl
   valClass findMax() const { return vals.back(); }
   rowClass getMinRow() const { return rows.front(); }
   rowClass getMaxRow() const { return rows.back(); }
+  friend std::size_t hash_value(const fr1DLookupTbl& tbl)
+  {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, tbl.rowName);
+    boost::hash_combine(seed, tbl.rows);
+    boost::hash_combine(seed, tbl.vals);
+    boost::hash_combine(seed, tbl.lowerBound);
+    return seed;
+  }
 
  private:
   frUInt4 getRowIdx(const rowClass& rowVal) const
@@ -227,6 +237,16 @@ class fr2DLookupTbl
   }
   valClass findMin() const { return vals.front().front(); }
   valClass findMax() const { return vals.back().back(); }
+  friend std::size_t hash_value(const fr2DLookupTbl& tbl)
+  {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, tbl.rowName);
+    boost::hash_combine(seed, tbl.rows);
+    boost::hash_combine(seed, tbl.colName);
+    boost::hash_combine(seed, tbl.cols);
+    boost::hash_combine(seed, tbl.vals);
+    return seed;
+  }
 
   // debug
   void printTbl() const
@@ -90,6 +90,10 @@ class frTechObject
   {
     return viaRuleGenerates;
   }
+  const std::vector<std::unique_ptr<frConstraint>>& getConstraints() const
+  {
+    return uConstraints;
+  }
   bool hasUnidirectionalLayer(odb::dbTechLayer* dbLayer) const
   {
     return unidirectional_layers_.find(dbLayer) != unidirectional_layers_.end();
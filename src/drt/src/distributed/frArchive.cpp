@@ -28,6 +28,10 @@
 
 #include "frArchive.h"
 
+#include <zlib.h>
+
+#include <cstring>
+
 // explicit instantiation of class templates involved
 namespace boost {
 namespace archive {
@@ -43,3 +47,84 @@ template class detail::archive_serializer_map<fr::frOArchive>;
 template class detail::archive_serializer_map<fr::frIArchive>;
 }  // namespace archive
 }  // namespace boost
+
+namespace fr {
+
+namespace {
+constexpr char kPayloadMagic[4] = {'F', 'R', 'P', 'L'};
+
+struct PayloadHeader
+{
+  char magic[4];
+  uint16_t version;
+  uint8_t compressed;
+  uint8_t reserved;
+  uint64_t rawSize;
+};
+}  // namespace
+
+std::string packPayload(const std::string& raw)
+{
+  PayloadHeader header;
+  memcpy(header.magic, kPayloadMagic, sizeof(kPayloadMagic));
+  header.version = kPayloadVersion;
+  header.compressed = 0;
+  header.reserved = 0;
+  header.rawSize = raw.size();
+
+  std::string packed(sizeof(header) + compressBound(raw.size()), '\0');
+  uLongf size = packed.size() - sizeof(header);
+  const int status
+      = compress2(reinterpret_cast<Bytef*>(&packed[sizeof(header)]),
+                  &size,
+                  reinterpret_cast<const Bytef*>(raw.data()),
+                  raw.size(),
+                  Z_BEST_SPEED);
+  if (status == Z_OK && size < raw.size()) {
+    header.compressed = 1;
+    packed.resize(sizeof(header) + size);
+  } else {
+    packed.resize(sizeof(header));
+    packed += raw;
+  }
+  memcpy(&packed[0], &header, sizeof(header));
+  return packed;
+}
+
+bool frPayloadBuf::open(const std::string& packed)
+{
+  PayloadHeader header;
+  if (packed.size() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, packed.data(), sizeof(header));
+  if (memcmp(header.magic, kPayloadMagic, sizeof(kPayloadMagic)) != 0
+      || header.version != kPayloadVersion) {
+    return false;
+  }
+  const char* data = packed.data() + sizeof(header);
+  const size_t size = packed.size() - sizeof(header);
+  char* begin;
+  if (header.compressed) {
+    raw_.resize(header.rawSize);
+    uLongf rawSize = raw_.size();
+    if (uncompress(reinterpret_cast<Bytef*>(&raw_[0]),
+                   &rawSize,
+                   reinterpret_cast<const Bytef*>(data),
+                   size)
+            != Z_OK
+        || rawSize != header.rawSize) {
+      return false;
+    }
+    begin = &raw_[0];
+  } else {
+    if (size != header.rawSize) {
+      return false;
+    }
+    begin = const_cast<char*>(data);
+  }
+  setg(begin, begin, begin + header.rawSize);
+  return true;
+}
+
+}  // namespace fr
@@ -29,6 +29,9 @@
 #pragma once
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
+#include <cstdint>
+#include <streambuf>
+#include <string>
 
 #include "frDesign.h"
 #include "serialization.h"
@@ -77,6 +80,26 @@ struct frIArchive : InputArchive
  private:
   frDesign* design;
 };
+
+// Workers and design updates shipped to remote routers are written without
+// the boost archive header and wrapped in a frame holding a magic number,
+// the format version and the raw size.  The payload is zlib compressed
+// when that makes it smaller.
+constexpr uint16_t kPayloadVersion = 1;
+
+std::string packPayload(const std::string& raw);
+
+// Stream buffer reading a framed payload.  Uncompressed payloads are read
+// in place from the packed string, which must outlive the buffer.
+class frPayloadBuf : public std::streambuf
+{
+ public:
+  // Returns false if packed is not a frame of kPayloadVersion.
+  bool open(const std::string& packed);
+
+ private:
+  std::string raw_;
+};
 }  // namespace fr
 
 // template implementations
@@ -36,8 +36,10 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 
@@ -72,20 +74,23 @@ void serializeWorker(FlexDRWorker* worker, std::string& workerStr)
 {
   std::stringstream stream(std::ios_base::binary | std::ios_base::in
                            | std::ios_base::out);
-  frOArchive ar(stream);
+  frOArchive ar(stream, boost::archive::no_header);
   registerTypes(ar);
   ar << *worker;
-  workerStr = stream.str();
+  workerStr = packPayload(stream.str());
 }
 
 void deserializeWorker(FlexDRWorker* worker,
                        frDesign* design,
-                       const std::string& workerStr)
+                       const std::string& workerStr,
+                       utl::Logger* logger)
 {
-  std::stringstream stream(
-      workerStr,
-      std::ios_base::binary | std::ios_base::in | std::ios_base::out);
-  frIArchive ar(stream);
+  frPayloadBuf buf;
+  if (!buf.open(workerStr)) {
+    logger->error(DRT, 629, "Unsupported worker payload format.");
+  }
+  std::istream stream(&buf);
+  frIArchive ar(stream, boost::archive::no_header);
   ar.setDesign(design);
   registerTypes(ar);
   ar >> *worker;
@@ -110,12 +115,15 @@ FlexDR::FlexDR(triton_route::TritonRoute* router,
       logger_(loggerIn),
       db_(dbIn),
       numWorkUnits_(0),
+      mazeExpansions_(0),
+      maxNetExpansions_(0),
       dist_(nullptr),
       dist_on_(false),
       dist_port_(0),
       increaseClipsize_(false),
       clipSizeInc_(0),
-      iter_(0)
+      iter_(0),
+      meanWorkerRuntime_(0)
 {
 }
 
@@ -154,18 +162,28 @@ std::string FlexDRWorker::reloadedMain()
 void serializeUpdates(const std::vector<std::vector<drUpdate>>& updates,
                       const std::string& file_name)
 {
-  std::ofstream file(file_name.c_str());
-  frOArchive ar(file);
+  std::stringstream stream(std::ios_base::binary | std::ios_base::in
+                           | std::ios_base::out);
+  frOArchive ar(stream, boost::archive::no_header);
   registerTypes(ar);
   ar << updates;
+  std::ofstream file(file_name.c_str(), std::ios::binary);
+  file << packPayload(stream.str());
   file.close();
 }
 
 int FlexDRWorker::main(frDesign* design)
 {
   ProfileTask profile("DRW:main");
+  initMain(design);
+  routeMain();
+  return 0;
+}
+
+void FlexDRWorker::initMain(frDesign* design)
+{
   using namespace std::chrono;
-  high_resolution_clock::time_point t0 = high_resolution_clock::now();
+  mainStartTime_ = high_resolution_clock::now();
   auto micronPerDBU = 1.0 / getTech()->getDBUPerUU();
   if (VERBOSE > 1) {
     logger_->report("start DR worker (BOX) ( {} {} ) ( {} {} )",
@@ -208,7 +226,15 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
-  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+  initEndTime_ = high_resolution_clock::now();
+}
+
+void FlexDRWorker::routeMain()
+{
+  using namespace std::chrono;
+  auto micronPerDBU = 1.0 / getTech()->getDBUPerUU();
+  const high_resolution_clock::time_point t0 = mainStartTime_;
+  const high_resolution_clock::time_point t1 = initEndTime_;
   if (!skipRouting_) {
     route_queue();
   }
@@ -241,8 +267,7 @@ int FlexDRWorker::main(frDesign* design)
              duration_cast<duration<double>>(t3 - t0).count(),
              getInitNumMarkers(),
              num_markers);
-
-  return 0;
+  runtime_ = duration_cast<duration<double>>(t3 - t0).count();
 }
 
 void FlexDRWorker::distributedMain(frDesign* design)
@@ -404,6 +429,9 @@ void FlexDR::init()
   }
 
   iter_ = 0;
+  // the runtime history of an earlier run does not apply to this one
+  gcellRuntime_.clear();
+  meanWorkerRuntime_ = 0;
 
   if (VERBOSE > 0) {
     logger_->info(DRT, 194, "Start detail routing.");
@@ -448,6 +476,271 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+// Runs the workers without barriers between the batches.  A worker reads the
+// design as soon as all the earlier workers overlapping its extBox are
+// committed, and the workers are committed one at a time in their original
+// order.  Committing worker k waits for the workers released by commits
+// before k to finish reading the design, so each worker sees the design
+// after exactly the commits up to its last dependency and the result does
+// not depend on the number of threads or on timing.
+void FlexDR::runWorkersByDependency(
+    vector<unique_ptr<FlexDRWorker>>& workers,
+    const int size,
+    const int offset,
+    const std::function<void()>& workerDone)
+{
+  ProfileTask profile("DR:dependency_schedule");
+  const int numWorkers = workers.size();
+  if (numWorkers == 0) {
+    return;
+  }
+
+  // Workers are binned by the size x size clip they belong to (split clips
+  // share a bin).  MTSAFEDIST is smaller than a clip, so only the workers in
+  // the 8 neighbor bins can overlap (the same assumption as the 2x2
+  // batches).
+  auto binOf = [size, offset](const Rect& gcellBox) {
+    return std::make_pair((gcellBox.xMin() - offset) / size,
+                          (gcellBox.yMin() - offset) / size);
+  };
+  std::map<std::pair<int, int>, vector<int>> bins;
+  for (int i = 0; i < numWorkers; i++) {
+    bins[binOf(workers[i]->getGCellBox())].push_back(i);
+  }
+  // released[k + 1] holds the workers whose last dependency is worker k
+  vector<vector<int>> released(numWorkers + 1);
+  for (int i = 0; i < numWorkers; i++) {
+    const auto [binX, binY] = binOf(workers[i]->getGCellBox());
+    int lastDep = -1;
+    for (int dx = -1; dx <= 1; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        auto it = bins.find({binX + dx, binY + dy});
+        if (it == bins.end()) {
+          continue;
+        }
+        for (const int j : it->second) {
+          if (j < i
+              && workers[j]->getExtBox().intersects(workers[i]->getExtBox())) {
+            lastDep = std::max(lastDep, j);
+          }
+        }
+      }
+    }
+    released[lastDep + 1].push_back(i);
+  }
+
+  // With -adaptive_workers the ready workers start by decreasing predicted
+  // cost so the expensive ones do not end up in the tail of the iteration.
+  // Otherwise they start in their original order.  The start order does not
+  // change the result.
+  vector<double> priority(numWorkers, 0);
+  for (int i = 0; i < numWorkers; i++) {
+    priority[i] = workers[i]->getPredictedCost();
+  }
+  auto byPriority = [&priority](int a, int b) {
+    if (priority[a] != priority[b]) {
+      return priority[a] > priority[b];
+    }
+    return a < b;
+  };
+
+  std::shared_mutex designMutex;
+  for (auto& worker : workers) {
+    worker->setDesignMutex(&designMutex);
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::set<int, decltype(byPriority)> ready(
+      released[0].begin(), released[0].end(), byPriority);
+  int pendingInits = ready.size();
+  vector<bool> routed(numWorkers, false);
+  int nextCommit = 0;
+  bool committing = false;
+  bool abort = false;
+  ThreadException exception;
+
+  auto canCommit = [&]() {
+    return !committing && nextCommit < numWorkers && routed[nextCommit]
+           && pendingInits == 0;
+  };
+
+#pragma omp parallel
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      cv.wait(lock, [&]() {
+        return abort || nextCommit == numWorkers || canCommit()
+               || !ready.empty();
+      });
+      if (abort || nextCommit == numWorkers) {
+        break;
+      }
+      if (canCommit()) {
+        committing = true;
+        auto& worker = workers[nextCommit];
+        lock.unlock();
+        bool failed = false;
+        try {
+          std::unique_lock<std::shared_mutex> designLock(designMutex);
+          if (worker->end(getDesign())) {
+            numWorkUnits_ += 1;
+          }
+          addMazeExpansions(worker.get());
+          if (worker->isCongested()) {
+            increaseClipsize_ = true;
+          }
+        } catch (...) {
+          exception.capture();
+          failed = true;
+        }
+        worker.reset();
+        lock.lock();
+        committing = false;
+        abort = abort || failed;
+        nextCommit++;
+        ready.insert(released[nextCommit].begin(), released[nextCommit].end());
+        pendingInits += released[nextCommit].size();
+        cv.notify_all();
+        continue;
+      }
+      const int i = *ready.begin();
+      ready.erase(ready.begin());
+      lock.unlock();
+      bool failed = false;
+      try {
+        workers[i]->initMain(getDesign());
+      } catch (...) {
+        exception.capture();
+        failed = true;
+      }
+      lock.lock();
+      pendingInits--;
+      abort = abort || failed;
+      const bool skip = abort;
+      cv.notify_all();
+      lock.unlock();
+      if (!skip) {
+        try {
+          workers[i]->routeMain();
+        } catch (...) {
+          exception.capture();
+          failed = true;
+        }
+      }
+      lock.lock();
+      routed[i] = true;
+      abort = abort || failed;
+      if (ADAPTIVE_WORKERS) {
+        saveRuntimeHistory(workers[i].get());
+      }
+      cv.notify_all();
+      lock.unlock();
+      // The progress report reads the markers of the design, which the
+      // committing thread changes.  The committing thread never holds the
+      // mutex and the design lock together, so waiting here is safe.
+      std::shared_lock<std::shared_mutex> designLock(designMutex);
+      lock.lock();
+      workerDone();
+    }
+  }
+  exception.rethrow();
+
+  if (ADAPTIVE_WORKERS) {
+    double totalRuntime = 0;
+    for (const auto& column : gcellRuntime_) {
+      totalRuntime += std::accumulate(column.begin(), column.end(), 0.0);
+    }
+    meanWorkerRuntime_ = totalRuntime / numWorkers;
+  }
+}
+
+// The gcell range [lo, hi] cut in two halves, or left whole when a half
+// would be narrower than two gcells.
+static vector<pair<int, int>> splitClipRange(int lo, int hi)
+{
+  if (hi - lo + 1 < 4) {
+    return {{lo, hi}};
+  }
+  const int mid = lo + (hi - lo + 2) / 2;
+  return {{lo, mid - 1}, {mid, hi}};
+}
+
+// Rough amount of work of a worker: every marker makes it reroute the nets
+// going through its route box.
+int FlexDR::getWorkerLoad(const Rect& routeBox, const Rect& drcBox) const
+{
+  vector<frMarker*> markers;
+  getRegionQuery()->queryMarker(drcBox, markers);
+  vector<frGuide*> guides;
+  getRegionQuery()->queryGuide(routeBox, guides);
+  std::set<frNet*, frBlockObjectComp> nets;
+  for (frGuide* guide : guides) {
+    nets.insert(guide->getNet());
+  }
+  return (markers.size() + 1) * std::max((int) nets.size(), 1);
+}
+
+double FlexDR::getRuntimeHistory(const Rect& gcellBox) const
+{
+  double runtime = 0;
+  for (int x = gcellBox.xMin();
+       x <= std::min(gcellBox.xMax(), (int) gcellRuntime_.size() - 1);
+       x++) {
+    for (int y = gcellBox.yMin();
+         y <= std::min(gcellBox.yMax(), (int) gcellRuntime_[x].size() - 1);
+         y++) {
+      runtime += gcellRuntime_[x][y];
+    }
+  }
+  return runtime;
+}
+
+bool FlexDR::isInRouteRegions(const Rect& routeBox) const
+{
+  if (routeRegions_.empty()) {
+    return true;
+  }
+  for (const Rect& region : routeRegions_) {
+    if (region.intersects(routeBox)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FlexDR::addMazeExpansions(const FlexDRWorker* worker)
+{
+  mazeExpansions_ += worker->getMazeExpansions();
+  maxNetExpansions_
+      = std::max(maxNetExpansions_, worker->getMaxNetExpansions());
+}
+
+// Spreads the runtime of the worker over its gcells.
+void FlexDR::saveRuntimeHistory(const FlexDRWorker* worker)
+{
+  const auto& gCellPatterns = getDesign()->getTopBlock()->getGCellPatterns();
+  const int xGCells = gCellPatterns.at(0).getCount();
+  const int yGCells = gCellPatterns.at(1).getCount();
+  if ((int) gcellRuntime_.size() != xGCells
+      || (int) gcellRuntime_.front().size() != yGCells) {
+    // the gcell grid changed since the history was saved
+    gcellRuntime_.assign(xGCells, vector<float>(yGCells, 0));
+    meanWorkerRuntime_ = 0;
+  }
+  const Rect& gcellBox = worker->getGCellBox();
+  const int xMax = std::min(gcellBox.xMax(), (int) gcellRuntime_.size() - 1);
+  const int yMax
+      = std::min(gcellBox.yMax(), (int) gcellRuntime_.front().size() - 1);
+  const int numGCells
+      = (xMax - gcellBox.xMin() + 1) * (yMax - gcellBox.yMin() + 1);
+  for (int x = gcellBox.xMin(); x <= xMax; x++) {
+    for (int y = gcellBox.yMin(); y <= yMax; y++) {
+      gcellRuntime_[x][y] = worker->getRuntime() / numGCells;
+    }
+  }
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
@@ -494,8 +787,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   auto& xgp = gCellPatterns.at(0);
   auto& ygp = gCellPatterns.at(1);
   int cnt = 0;
-  int tot = (((int) xgp.getCount() - 1 - offset) / size + 1)
-            * (((int) ygp.getCount() - 1 - offset) / size + 1);
+  int tot = 0;  // counted as the workers are made
   int prev_perc = 0;
   bool isExceed = false;
 
@@ -507,33 +799,139 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   vector<vector<vector<unique_ptr<FlexDRWorker>>>> workers(batchStepX
                                                            * batchStepY);
 
+  auto makeWorker = [&](int i, int j, int max_i, int max_j) {
+    auto worker = make_unique<FlexDRWorker>(&via_data_, design_, logger_);
+    Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
+    Rect routeBox2
+        = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
+    Rect routeBox(
+        routeBox1.xMin(), routeBox1.yMin(), routeBox2.xMax(), routeBox2.yMax());
+    Rect extBox;
+    Rect drcBox;
+    routeBox.bloat(MTSAFEDIST, extBox);
+    routeBox.bloat(DRCSAFEDIST, drcBox);
+    worker->setRouteBox(routeBox);
+    worker->setExtBox(extBox);
+    worker->setDrcBox(drcBox);
+    worker->setGCellBox(Rect(i, j, max_i, max_j));
+    worker->setMazeEndIter(mazeEndIter);
+    worker->setDRIter(iter);
+    worker->setDebugSettings(router_->getDebugSettings());
+    if (dist_on_)
+      worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
+    worker->setRipupMode(ripupMode);
+    worker->setFollowGuide(followGuide);
+    // TODO: only pass to relevant workers
+    worker->setGraphics(graphics_.get());
+    worker->setCost(workerDRCCost,
+                    workerMarkerCost,
+                    workerFixedShapeCost,
+                    workerMarkerDecay);
+    return worker;
+  };
+  // scales the load by how slow the area was in the last iteration
+  auto predictCost = [this](FlexDRWorker* worker, int load) {
+    double slowdown = 1;
+    if (meanWorkerRuntime_ > 0) {
+      slowdown
+          += getRuntimeHistory(worker->getGCellBox()) / meanWorkerRuntime_;
+    }
+    worker->setPredictedCost(load * slowdown);
+  };
+  auto addWorker = [&](unique_ptr<FlexDRWorker> worker, int batchIdx) {
+    if (workers[batchIdx].empty()
+        || (!dist_on_ && (int) workers[batchIdx].back().size() >= BATCHSIZE)) {
+      workers[batchIdx].push_back(vector<unique_ptr<FlexDRWorker>>());
+    }
+    workers[batchIdx].back().push_back(std::move(worker));
+    tot++;
+  };
+
+  // With -adaptive_workers clips much busier than the average are cut in
+  // half along each axis that is at least four gcells wide, and the
+  // workers get a predicted cost used to start the expensive ones first.
+  // The split only depends on the design so the result stays deterministic.
+  const bool adaptive = ADAPTIVE_WORKERS && !dist_on_ && iter > 0;
+  vector<int> clipLoads;
+  int splitLoad = std::numeric_limits<int>::max();
+  if (adaptive) {
+    int64_t totalLoad = 0;
+    for (int i = offset; i < (int) xgp.getCount(); i += size) {
+      for (int j = offset; j < (int) ygp.getCount(); j += size) {
+        const int max_i = min((int) xgp.getCount() - 1, i + size - 1);
+        const int max_j = min((int) ygp.getCount(), j + size - 1);
+        Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
+        Rect routeBox2
+            = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
+        Rect routeBox(routeBox1.xMin(),
+                      routeBox1.yMin(),
+                      routeBox2.xMax(),
+                      routeBox2.yMax());
+        Rect drcBox;
+        routeBox.bloat(DRCSAFEDIST, drcBox);
+        clipLoads.push_back(getWorkerLoad(routeBox, drcBox));
+        totalLoad += clipLoads.back();
+      }
+    }
+    // halves are at least two gcells wide
+    if (size >= 4 && !clipLoads.empty()) {
+      const int splitFactor = 4;
+      splitLoad = splitFactor * (totalLoad / (int64_t) clipLoads.size());
+    }
+  }
+  int clipIdx = 0;
+
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
-      auto worker = make_unique<FlexDRWorker>(&via_data_, design_, logger_);
-      Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
       const int max_i = min((int) xgp.getCount() - 1, i + size - 1);
       const int max_j = min((int) ygp.getCount(), j + size - 1);
-      Rect routeBox2
-          = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
-      Rect routeBox(routeBox1.xMin(),
-                    routeBox1.yMin(),
-                    routeBox2.xMax(),
-                    routeBox2.yMax());
-      Rect extBox;
-      Rect drcBox;
-      routeBox.bloat(MTSAFEDIST, extBox);
-      routeBox.bloat(DRCSAFEDIST, drcBox);
-      worker->setRouteBox(routeBox);
-      worker->setExtBox(extBox);
-      worker->setDrcBox(drcBox);
-      worker->setGCellBox(Rect(i, j, max_i, max_j));
-      worker->setMazeEndIter(mazeEndIter);
-      worker->setDRIter(iter);
-      worker->setDebugSettings(router_->getDebugSettings());
-      if (dist_on_)
-        worker->setDistributed(dist_, dist_ip_, dist_port_, dist_dir_);
+      int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
+      const int clipLoad = adaptive ? clipLoads[clipIdx++] : 0;
+      if (!routeRegions_.empty()) {
+        Rect routeBox1 = getDesign()->getTopBlock()->getGCellBox(Point(i, j));
+        Rect routeBox2
+            = getDesign()->getTopBlock()->getGCellBox(Point(max_i, max_j));
+        if (!isInRouteRegions(Rect(routeBox1.xMin(),
+                                   routeBox1.yMin(),
+                                   routeBox2.xMax(),
+                                   routeBox2.yMax()))) {
+          yIdx++;
+          continue;
+        }
+      }
+      if (clipLoad > splitLoad) {
+        for (const auto& [lo_i, hi_i] : splitClipRange(i, max_i)) {
+          for (const auto& [lo_j, hi_j] : splitClipRange(j, max_j)) {
+            debugPrint(logger_,
+                       DRT,
+                       "adaptive_workers",
+                       1,
+                       "subclip {} {} {} {} of clip {} {} {} {}",
+                       lo_i,
+                       lo_j,
+                       hi_i,
+                       hi_j,
+                       i,
+                       j,
+                       max_i,
+                       max_j);
+            auto worker = makeWorker(lo_i, lo_j, hi_i, hi_j);
+            predictCost(worker.get(),
+                        getWorkerLoad(worker->getRouteBox(),
+                                      worker->getDrcBox()));
+            addWorker(std::move(worker), batchIdx);
+          }
+        }
+        yIdx++;
+        continue;
+      }
+      auto worker = makeWorker(i, j, max_i, max_j);
+      if (adaptive) {
+        predictCost(worker.get(), clipLoad);
+      }
       if (!iter) {
+        const Rect& routeBox = worker->getRouteBox();
         // if (routeBox.xMin() == 441000 && routeBox.yMin() == 816100) {
         //   cout << "@@@ debug: " << i << " " << j << endl;
         // }
@@ -541,22 +939,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
         auto bp = initDR_mergeBoundaryPin(i, j, size, routeBox);
         worker->setDRIter(0, bp);
       }
-      worker->setRipupMode(ripupMode);
-      worker->setFollowGuide(followGuide);
-      // TODO: only pass to relevant workers
-      worker->setGraphics(graphics_.get());
-      worker->setCost(workerDRCCost,
-                      workerMarkerCost,
-                      workerFixedShapeCost,
-                      workerMarkerDecay);
-
-      int batchIdx = (xIdx % batchStepX) * batchStepY + yIdx % batchStepY;
-      if (workers[batchIdx].empty()
-          || (!dist_on_
-              && (int) workers[batchIdx].back().size() >= BATCHSIZE)) {
-        workers[batchIdx].push_back(vector<unique_ptr<FlexDRWorker>>());
-      }
-      workers[batchIdx].back().push_back(std::move(worker));
+      addWorker(std::move(worker), batchIdx);
 
       yIdx++;
     }
@@ -568,6 +951,39 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
+  mazeExpansions_ = 0;
+  maxNetExpansions_ = 0;
+  auto workerDone = [&]() {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          getDesign()->getTopBlock()->getNumMarkers());
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+  if (!dist_on_) {
+    // keep the batch order as the commit order; the batches below are only
+    // used by distributed runs
+    vector<unique_ptr<FlexDRWorker>> orderedWorkers;
+    for (auto& workerBatch : workers) {
+      for (auto& workersInBatch : workerBatch) {
+        for (auto& worker : workersInBatch) {
+          orderedWorkers.push_back(std::move(worker));
+        }
+      }
+    }
+    workers.clear();
+    runWorkersByDependency(orderedWorkers, size, offset, workerDone);
+  }
   // parallel execution
   for (auto& workerBatch : workers) {
     ProfileTask profile("DR:checkerboard");
@@ -598,25 +1014,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
               else
                 workersInBatch[i]->main(getDesign());
 #pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
+              workerDone();
             } catch (...) {
               exception.capture();
             }
@@ -648,7 +1046,8 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
               for (int i = 0; i < workers.size(); i++) {
                 deserializeWorker(workersInBatch.at(workers.at(i).first).get(),
                                   design_,
-                                  workers.at(i).second);
+                                  workers.at(i).second,
+                                  logger_);
               }
             }
             logger_->report("    Deserialized Batches:{}.", t);
@@ -661,6 +1060,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
         for (int i = 0; i < (int) workersInBatch.size(); i++) {
           if (workersInBatch[i]->end(getDesign()))
             numWorkUnits_ += 1;
+          addMazeExpansions(workersInBatch[i].get());
           if (workersInBatch[i]->isCongested())
             increaseClipsize_ = true;
         }
@@ -669,6 +1069,12 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     }
   }
 
+  // drop the grid graph storage kept for reuse by the routing threads, so
+  // it does not outlive the iteration
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel
+  FlexGridGraph::releaseThreadPool();
+
   if (!iter) {
     removeGCell2BoundaryPin();
   }
@@ -700,6 +1106,13 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
              1,
              "Number of work units = {}.",
              numWorkUnits_);
+  debugPrint(logger_,
+             utl::DRT,
+             "workers",
+             1,
+             "Maze expansions = {}, max per net = {}.",
+             mazeExpansions_,
+             maxNetExpansions_);
   if (VERBOSE > 0) {
     logger_->info(DRT,
                   199,
@@ -762,6 +1175,10 @@ void FlexDR::end(bool done)
   if (done && VERBOSE > 0) {
     logger_->info(DRT, 198, "Complete detail routing.");
   }
+  if (done) {
+    gcellRuntime_.clear();
+    meanWorkerRuntime_ = 0;
+  }
 
   using ULL = unsigned long long;
   const auto size = getTech()->getLayers().size();
@@ -1244,6 +1661,7 @@ void FlexDRWorker::serialize(Archive& ar, const unsigned int version)
   (ar) & markers_;
   (ar) & bestMarkers_;
   (ar) & isCongested_;
+  (ar) & maxNetExpansions_;
   if (is_loading(ar)) {
     gridGraph_.setTech(design_->getTech());
     gridGraph_.setWorker(this);
@@ -1280,7 +1698,7 @@ std::unique_ptr<FlexDRWorker> FlexDRWorker::load(const std::string& workerStr,
                                                  FlexDRGraphics* graphics)
 {
   auto worker = std::make_unique<FlexDRWorker>();
-  deserializeWorker(worker.get(), design, workerStr);
+  deserializeWorker(worker.get(), design, workerStr, logger);
 
   // We need to fix up the fields we want from the current run rather
   // than the stored ones.
@@ -32,8 +32,11 @@
 
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <shared_mutex>
 
 #include "db/drObj/drMarker.h"
 #include "db/drObj/drNet.h"
@@ -115,6 +118,12 @@ class FlexDR
 
   const FlexDRViaData* getViaData() const { return &via_data_; }
   void setDebug(frDebugSettings* settings);
+  // only create workers for the clips touching these regions (all clips if
+  // empty); used by the incremental flow
+  void setRouteRegions(const std::vector<Rect>& regions)
+  {
+    routeRegions_ = regions;
+  }
 
   // For post-deserialization update
   void setLogger(Logger* logger) { logger_ = logger; }
@@ -153,6 +162,8 @@ class FlexDR
   std::unique_ptr<FlexDRGraphics> graphics_;
   std::string debugNetName_;
   int numWorkUnits_;
+  int64_t mazeExpansions_;
+  int64_t maxNetExpansions_;
 
   // distributed
   dst::Distributed* dist_;
@@ -164,11 +175,26 @@ class FlexDR
   bool increaseClipsize_;
   float clipSizeInc_;
   int iter_;
+  // runtime of the last iteration per gcell, used to order the workers
+  // with -adaptive_workers
+  std::vector<std::vector<float>> gcellRuntime_;
+  double meanWorkerRuntime_;
+  std::vector<Rect> routeRegions_;
 
   // others
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  void runWorkersByDependency(
+      std::vector<std::unique_ptr<FlexDRWorker>>& workers,
+      int size,
+      int offset,
+      const std::function<void()>& workerDone);
+  int getWorkerLoad(const Rect& routeBox, const Rect& drcBox) const;
+  double getRuntimeHistory(const Rect& gcellBox) const;
+  void saveRuntimeHistory(const FlexDRWorker* worker);
+  void addMazeExpansions(const FlexDRWorker* worker);
+  bool isInRouteRegions(const Rect& routeBox) const;
 
   void init_halfViaEncArea();
 
@@ -277,7 +303,11 @@ class FlexDRWorker
         dist_port_(0),
         dist_on_(false),
         isCongested_(false),
-        save_updates_(false)
+        save_updates_(false),
+        designMutex_(nullptr),
+        runtime_(0),
+        predictedCost_(0),
+        maxNetExpansions_(0)
   {
   }
   FlexDRWorker()
@@ -306,7 +336,11 @@ class FlexDRWorker
         dist_port_(0),
         dist_on_(false),
         isCongested_(false),
-        save_updates_(false)
+        save_updates_(false),
+        designMutex_(nullptr),
+        runtime_(0),
+        predictedCost_(0),
+        maxNetExpansions_(0)
   {
   }
   // setters
@@ -328,6 +362,16 @@ class FlexDRWorker
     boundaryPin_ = std::move(bp);
   }
   bool isCongested() const { return isCongested_; }
+  // Guards the design region query against workers committed while this one
+  // is routing.
+  void setDesignMutex(std::shared_mutex* mutex) { designMutex_ = mutex; }
+  // seconds spent in main()
+  double getRuntime() const { return runtime_; }
+  void setPredictedCost(double cost) { predictedCost_ = cost; }
+  // maze search nodes expanded by the worker and by its costliest net
+  int64_t getMazeExpansions() const { return gridGraph_.getNumExpanded(); }
+  int64_t getMaxNetExpansions() const { return maxNetExpansions_; }
+  double getPredictedCost() const { return predictedCost_; }
   void setBoundaryPins(std::map<frNet*,
                                 std::set<std::pair<Point, frLayerNum>>,
                                 frBlockObjectComp>& bp)
@@ -439,6 +483,10 @@ class FlexDRWorker
   const FlexGridGraph& getGridGraph() const { return gridGraph_; }
   // others
   int main(frDesign* design);
+  // main() split in the part reading the design and the routing part, which
+  // only reads the design through the region query in hasAccessPoint().
+  void initMain(frDesign* design);
+  void routeMain();
   void distributedMain(frDesign* design);
   void updateDesign(frDesign* design);
   std::string reloadedMain();
@@ -545,6 +593,13 @@ class FlexDRWorker
   bool isCongested_;
   bool save_updates_;
 
+  std::shared_mutex* designMutex_;
+  std::chrono::high_resolution_clock::time_point mainStartTime_;
+  std::chrono::high_resolution_clock::time_point initEndTime_;
+  double runtime_;
+  double predictedCost_;
+  int64_t maxNetExpansions_;
+
   // init
   void init(const frDesign* design);
   void initNets(const frDesign* design);
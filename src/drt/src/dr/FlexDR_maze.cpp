@@ -2630,7 +2630,13 @@ bool FlexDRWorker::hasAccessPoint(const Point& pt, frLayerNum lNum, frNet* net)
 {
   frRegionQuery::Objects<frBlockObject> result;
   Rect bx(pt.x(), pt.y(), pt.x(), pt.y());
-  design_->getRegionQuery()->query(bx, lNum, result);
+  {
+    std::shared_lock<std::shared_mutex> lock;
+    if (designMutex_) {
+      lock = std::shared_lock<std::shared_mutex>(*designMutex_);
+    }
+    design_->getRegionQuery()->query(bx, lNum, result);
+  }
   for (auto& rqObj : result) {
     switch (rqObj.second->typeId()) {
       case frcInstTerm: {
@@ -2876,6 +2882,7 @@ bool FlexDRWorker::routeNet(drNet* net)
                   centerPt);
 
   vector<FlexMazeIdx> path;  // astar must return with >= 1 idx
+  const int64_t startExpansions = gridGraph_.getNumExpanded();
   bool isFirstConn = true;
   bool searchSuccess = true;
   while (!unConnPins.empty()) {
@@ -2912,6 +2919,8 @@ bool FlexDRWorker::routeNet(drNet* net)
       break;
     }
   }
+  maxNetExpansions_ = std::max(
+      maxNetExpansions_, gridGraph_.getNumExpanded() - startExpansions);
   if (searchSuccess) {
     if (CLEAN_PATCHES) {
       gcWorker_->setTargetNet(net->getFrNet());
@@ -71,24 +71,43 @@ void FlexGridGraph::initGrids(
   getDim(xDim, yDim, zDim);
   const int capacity = xDim * yDim * zDim;
 
-  nodes_.clear();
-  nodes_.resize(capacity, Node());
-  // new
-  prevDirs_.clear();
-  srcs_.clear();
-  dsts_.clear();
-
-  prevDirs_.resize(capacity * 3, 0);
-  srcs_.resize(capacity, 0);
-  dsts_.resize(capacity, 0);
+  acquireStorage();
+  nodes_.assign(capacity, Node());
   guides_.clear();
-  if (followGuide) {
-    guides_.resize(capacity, 0);
-  } else {
-    guides_.resize(capacity, 1);
+  guides_.resize(capacity, !followGuide);
+}
+
+frVector<FlexGridGraph::Node>& FlexGridGraph::nodePool()
+{
+  thread_local frVector<Node> pool;
+  return pool;
+}
+
+void FlexGridGraph::acquireStorage()
+{
+  if (nodes_.capacity() < nodePool().capacity()) {
+    nodes_.swap(nodePool());
   }
 }
 
+void FlexGridGraph::releaseStorage()
+{
+  // keep the larger of the two node buffers for the next worker, unless it
+  // is too large to hold on to
+  nodes_.clear();
+  if (nodes_.capacity() > nodePool().capacity()
+      && nodes_.capacity() <= maxPooledNodes) {
+    nodes_.swap(nodePool());
+  }
+  frVector<Node>().swap(nodes_);
+  std::vector<bool>().swap(guides_);
+}
+
+void FlexGridGraph::releaseThreadPool()
+{
+  frVector<Node>().swap(nodePool());
+}
+
 bool FlexGridGraph::outOfDieVia(frMIdx x,
                                 frMIdx y,
                                 frMIdx z,
@@ -431,24 +450,33 @@ void FlexGridGraph::initTracks(
 
 void FlexGridGraph::resetStatus()
 {
-  resetSrc();
-  resetDst();
-  resetPrevNodeDir();
+  // clear the search state of all nodes in one pass
+  for (Node& node : nodes_) {
+    node.isSrc = false;
+    node.isDst = false;
+    node.prevAstarNodeDir = 0;
+  }
 }
 
 void FlexGridGraph::resetSrc()
 {
-  srcs_.assign(srcs_.size(), 0);
+  for (Node& node : nodes_) {
+    node.isSrc = false;
+  }
 }
 
 void FlexGridGraph::resetDst()
 {
-  dsts_.assign(dsts_.size(), 0);
+  for (Node& node : nodes_) {
+    node.isDst = false;
+  }
 }
 
 void FlexGridGraph::resetPrevNodeDir()
 {
-  prevDirs_.assign(prevDirs_.size(), 0);
+  for (Node& node : nodes_) {
+    node.prevAstarNodeDir = 0;
+  }
 }
 
 // print the grid graph with edge and vertex for debug purpose
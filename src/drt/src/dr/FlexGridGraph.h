@@ -56,6 +56,7 @@ class FlexGridGraph
         zHeights_(),
         ggDRCCost_(0),
         ggMarkerCost_(0),
+        numExpanded_(0),
         ggFixedShapeCost_(0),
         halfViaEncArea_(nullptr),
         ndr_(nullptr),
@@ -640,16 +641,22 @@ class FlexGridGraph
   }
 
   // unsafe access, no idx check
-  void setSrc(frMIdx x, frMIdx y, frMIdx z) { srcs_[getIdx(x, y, z)] = 1; }
+  void setSrc(frMIdx x, frMIdx y, frMIdx z)
+  {
+    nodes_[getIdx(x, y, z)].isSrc = true;
+  }
   void setSrc(const FlexMazeIdx& mi)
   {
-    srcs_[getIdx(mi.x(), mi.y(), mi.z())] = 1;
+    nodes_[getIdx(mi.x(), mi.y(), mi.z())].isSrc = true;
   }
   // unsafe access, no idx check
-  void setDst(frMIdx x, frMIdx y, frMIdx z) { dsts_[getIdx(x, y, z)] = 1; }
+  void setDst(frMIdx x, frMIdx y, frMIdx z)
+  {
+    nodes_[getIdx(x, y, z)].isDst = true;
+  }
   void setDst(const FlexMazeIdx& mi)
   {
-    dsts_[getIdx(mi.x(), mi.y(), mi.z())] = 1;
+    nodes_[getIdx(mi.x(), mi.y(), mi.z())].isDst = true;
   }
   // unsafe access
   void setSVia(frMIdx x, frMIdx y, frMIdx z)
@@ -696,16 +703,22 @@ class FlexGridGraph
     nodes_[getIdx(x, y, z)].hasGridCostUp = true;
   }
   // unsafe access, no idx check
-  void resetSrc(frMIdx x, frMIdx y, frMIdx z) { srcs_[getIdx(x, y, z)] = 0; }
+  void resetSrc(frMIdx x, frMIdx y, frMIdx z)
+  {
+    nodes_[getIdx(x, y, z)].isSrc = false;
+  }
   void resetSrc(const FlexMazeIdx& mi)
   {
-    srcs_[getIdx(mi.x(), mi.y(), mi.z())] = 0;
+    nodes_[getIdx(mi.x(), mi.y(), mi.z())].isSrc = false;
   }
   // unsafe access, no idx check
-  void resetDst(frMIdx x, frMIdx y, frMIdx z) { dsts_[getIdx(x, y, z)] = 0; }
+  void resetDst(frMIdx x, frMIdx y, frMIdx z)
+  {
+    nodes_[getIdx(x, y, z)].isDst = false;
+  }
   void resetDst(const FlexMazeIdx& mi)
   {
-    dsts_[getIdx(mi.x(), mi.y(), mi.z())] = 0;
+    nodes_[getIdx(mi.x(), mi.y(), mi.z())].isDst = false;
   }
   void resetGridCost(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir)
   {
@@ -848,14 +861,7 @@ class FlexGridGraph
   int nTracksY() { return yCoords_.size(); }
   void cleanup()
   {
-    nodes_.clear();
-    nodes_.shrink_to_fit();
-    srcs_.clear();
-    srcs_.shrink_to_fit();
-    dsts_.clear();
-    dsts_.shrink_to_fit();
-    guides_.clear();
-    guides_.shrink_to_fit();
+    releaseStorage();
     xCoords_.clear();
     xCoords_.shrink_to_fit();
     yCoords_.clear();
@@ -869,6 +875,10 @@ class FlexGridGraph
     wavefront_.cleanup();
     wavefront_.fit();
   }
+  // frees the node storage kept for reuse by the calling thread
+  static void releaseThreadPool();
+  // nodes expanded by search() since the graph was created
+  int64_t getNumExpanded() const { return numExpanded_; }
 
   void printNode(frMIdx x, frMIdx y, frMIdx z)
   {
@@ -916,17 +926,15 @@ class FlexGridGraph
     frUInt4 isBlockedEast : 1;
     frUInt4 isBlockedNorth : 1;
     frUInt4 isBlockedUp : 1;
-    frUInt4 unused1 : 1;
-    frUInt4 unused2 : 1;
+    frUInt4 isSrc : 1;
+    frUInt4 isDst : 1;
     // Byte 1
     frUInt4 hasSpecialVia : 1;
     frUInt4 overrideShapeCostVia : 1;
     frUInt4 hasGridCostEast : 1;
     frUInt4 hasGridCostNorth : 1;
     frUInt4 hasGridCostUp : 1;
-    frUInt4 unused3 : 1;
-    frUInt4 unused4 : 1;
-    frUInt4 unused5 : 1;
+    frUInt4 prevAstarNodeDir : 3;
     // Byte 2
     frUInt4 routeShapeCostPlanar : cost_bits;
     // Byte 3
@@ -952,9 +960,6 @@ class FlexGridGraph
   static_assert(sizeof(Node) == 8);
 #endif
   frVector<Node> nodes_;
-  std::vector<bool> prevDirs_;
-  std::vector<bool> srcs_;
-  std::vector<bool> dsts_;
   std::vector<bool> guides_;
   frVector<frCoord> xCoords_;
   frVector<frCoord> yCoords_;
@@ -964,6 +969,7 @@ class FlexGridGraph
   Rect dieBox_;
   frUInt4 ggDRCCost_;
   frUInt4 ggMarkerCost_;
+  int64_t numExpanded_;
   frUInt4 ggFixedShapeCost_;
   // temporary variables
   FlexWavefront wavefront_;
@@ -984,6 +990,7 @@ class FlexGridGraph
         zHeights_(),
         ggDRCCost_(0),
         ggMarkerCost_(0),
+        numExpanded_(0),
         halfViaEncArea_(nullptr),
         ndr_(nullptr),
         dstTaperBox(nullptr)
@@ -993,39 +1000,43 @@ class FlexGridGraph
   // unsafe access, no idx check
   void setPrevAstarNodeDir(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir)
   {
-    auto baseIdx = 3 * getIdx(x, y, z);
-    prevDirs_[baseIdx] = ((unsigned short) dir >> 2) & 1;
-    prevDirs_[baseIdx + 1] = ((unsigned short) dir >> 1) & 1;
-    prevDirs_[baseIdx + 2] = ((unsigned short) dir) & 1;
+    nodes_[getIdx(x, y, z)].prevAstarNodeDir = (unsigned short) dir;
   }
 
   // unsafe access, no check
   frDirEnum getPrevAstarNodeDir(const FlexMazeIdx& idx) const
   {
-    auto baseIdx = 3 * getIdx(idx.x(), idx.y(), idx.z());
-    return (frDirEnum) (((unsigned short) (prevDirs_[baseIdx]) << 2)
-                        + ((unsigned short) (prevDirs_[baseIdx + 1]) << 1)
-                        + ((unsigned short) (prevDirs_[baseIdx + 2]) << 0));
+    return (frDirEnum) nodes_[getIdx(idx.x(), idx.y(), idx.z())]
+        .prevAstarNodeDir;
   }
 
   // unsafe access, no check
   bool isSrc(frMIdx x, frMIdx y, frMIdx z) const
   {
-    return srcs_[getIdx(x, y, z)];
+    return nodes_[getIdx(x, y, z)].isSrc;
   }
   // unsafe access, no check
   bool isDst(frMIdx x, frMIdx y, frMIdx z) const
   {
-    return dsts_[getIdx(x, y, z)];
+    return nodes_[getIdx(x, y, z)].isDst;
   }
   bool isDst(frMIdx x, frMIdx y, frMIdx z, frDirEnum dir) const
   {
     getNextGrid(x, y, z, dir);
-    bool b = dsts_[getIdx(x, y, z)];
+    bool b = nodes_[getIdx(x, y, z)].isDst;
     getPrevGrid(x, y, z, dir);
     return b;
   }
 
+  // The node storage of a finished worker is kept per thread and reused by
+  // the next worker of the thread, so the clip graphs do not go back to the
+  // allocator after every worker.  Graphs above maxPooledNodes (16MB) are
+  // freed instead, and FlexDR empties the pools after every iteration.
+  static constexpr size_t maxPooledNodes = 1 << 21;
+  static frVector<Node>& nodePool();
+  void acquireStorage();
+  void releaseStorage();
+
   // internal getters
   frMIdx getIdx(frMIdx xIdx, frMIdx yIdx, frMIdx zIdx) const
   {
@@ -1040,6 +1051,14 @@ class FlexGridGraph
     return zDirModifier + partialCoordinates;
   }
 
+  frCost weightEstCost(frCost estCost) const
+  {
+    if (MAZE_HEURISTIC_WEIGHT == 1) {
+      return estCost;
+    }
+    return estCost * MAZE_HEURISTIC_WEIGHT;
+  }
+
   frUInt4 addToByte(frUInt4 augend, frUInt4 summand)
   {
     frUInt4 result = augend + summand;
@@ -1218,9 +1237,6 @@ class FlexGridGraph
     }
     (ar) & drWorker_;
     (ar) & nodes_;
-    (ar) & prevDirs_;
-    (ar) & srcs_;
-    (ar) & dsts_;
     (ar) & guides_;
     (ar) & xCoords_;
     (ar) & yCoords_;
@@ -1230,6 +1246,7 @@ class FlexGridGraph
     (ar) & dieBox_;
     (ar) & ggDRCCost_;
     (ar) & ggMarkerCost_;
+    (ar) & numExpanded_;
     (ar) & halfViaEncArea_;
   }
   friend class boost::serialization::access;
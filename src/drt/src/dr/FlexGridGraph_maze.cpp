@@ -110,7 +110,7 @@ void FlexGridGraph::expand(FlexWavefrontGrid& currGrid,
                                       nextTLength,
                                       currDist,
                                       nextPathCost,
-                                      nextPathCost + nextEstCost,
+                                      nextPathCost + weightEstCost(nextEstCost),
                                       currGrid.getBackTraceBuffer());
   if (dir == frDirEnum::U || dir == frDirEnum::D) {
     nextWavefrontGrid.resetLength();
@@ -837,7 +837,8 @@ bool FlexGridGraph::search(vector<FlexMazeIdx>& connComps,
         std::numeric_limits<frCoord>::max(),
         currDist,
         0,
-        getEstCost(idx, dstMazeIdx1, dstMazeIdx2, frDirEnum::UNKNOWN));
+        weightEstCost(
+            getEstCost(idx, dstMazeIdx1, dstMazeIdx2, frDirEnum::UNKNOWN)));
     if (ndr_ && AUTO_TAPER_NDR_NETS) {
       auto it = mazeIdx2TaperBox.find(idx);
       if (it != mazeIdx2TaperBox.end())
@@ -852,6 +853,7 @@ bool FlexGridGraph::search(vector<FlexMazeIdx>& connComps,
         != frDirEnum::UNKNOWN) {
       continue;
     }
+    numExpanded_++;
     if (graphics_) {
       graphics_->searchNode(this, currGrid);
     }
@@ -779,11 +779,14 @@ void frRegionQuery::Impl::init()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numLayers; i++) {
     shapes_.at(i) = boost::move(RTree<frBlockObject*>(allShapes.at(i)));
     allShapes.at(i).clear();
     allShapes.at(i).shrink_to_fit();
-    if (VERBOSE > 0) {
+  }
+  if (VERBOSE > 0) {
+    for (int i = 0; i < numLayers; i++) {
       logger_->info(DRT,
                     24,
                     "  Complete {}.",
@@ -824,11 +827,14 @@ void frRegionQuery::Impl::initOrigGuide(
       }
     }
   }
-  for (auto i = 0; i < numLayers; i++) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numLayers; i++) {
     origGuides_.at(i) = boost::move(RTree<frNet*>(allShapes.at(i)));
     allShapes.at(i).clear();
     allShapes.at(i).shrink_to_fit();
-    if (VERBOSE > 0) {
+  }
+  if (VERBOSE > 0) {
+    for (int i = 0; i < numLayers; i++) {
       logger_->info(DRT,
                     28,
                     "  Complete {}.",
@@ -867,11 +873,14 @@ void frRegionQuery::Impl::initGuide()
       }
     }
   }
-  for (auto i = 0; i < numLayers; i++) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numLayers; i++) {
     guides_.at(i) = boost::move(RTree<frGuide*>(allGuides.at(i)));
     allGuides.at(i).clear();
     allGuides.at(i).shrink_to_fit();
-    if (VERBOSE > 0) {
+  }
+  if (VERBOSE > 0) {
+    for (int i = 0; i < numLayers; i++) {
       logger_->info(DRT,
                     35,
                     "  Complete {} (guide).",
@@ -917,7 +926,8 @@ void frRegionQuery::Impl::initRPin()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numLayers; i++) {
     rpins_.at(i) = boost::move(RTree<frRPin*>(allRPins.at(i)));
     allRPins.at(i).clear();
     allRPins.at(i).shrink_to_fit();
@@ -945,9 +955,13 @@ void frRegionQuery::Impl::initDRObj()
     for (auto& via : net->getVias()) {
       addDRObj(via.get(), allShapes);
     }
+    for (auto& pwire : net->getPatchWires()) {
+      addDRObj(pwire.get(), allShapes);
+    }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numLayers; i++) {
     drObjs_.at(i) = boost::move(RTree<frBlockObject*>(allShapes.at(i)));
     allShapes.at(i).clear();
     allShapes.at(i).shrink_to_fit();
@@ -972,7 +986,8 @@ void frRegionQuery::Impl::initGRObj()
     }
   }
 
-  for (auto i = 0; i < numLayers; i++) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < numLayers; i++) {
     grObjs_.at(i) = boost::move(RTree<grBlockObject*>(allShapes.at(i)));
     allShapes.at(i).clear();
     allShapes.at(i).shrink_to_fit();
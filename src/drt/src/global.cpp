@@ -46,6 +46,7 @@ string DRC_RPT_FILE;
 std::optional<int> DRC_RPT_ITER_STEP;
 string CMAP_FILE;
 string GUIDE_REPORT_FILE;
+string PA_CACHE_FILE;
 
 // to be removed
 int OR_SEED = -1;
@@ -54,7 +55,6 @@ double OR_K = 0;
 string DBPROCESSNODE = "";
 int MAX_THREADS = 1;
 int BATCHSIZE = 1024;
-int BATCHSIZETA = 8;
 int MTSAFEDIST = 2000;
 int DRCSAFEDIST = 500;
 int VERBOSE = 1;
@@ -71,6 +71,8 @@ bool CLEAN_PATCHES = false;
 bool DO_PA = true;
 bool SINGLE_STEP_DR = false;
 bool SAVE_GUIDE_UPDATES = false;
+bool ADAPTIVE_WORKERS = false;
+bool INCREMENTAL_DR = false;
 
 std::string VIAINPIN_BOTTOMLAYER_NAME;
 std::string VIAINPIN_TOPLAYER_NAME;
@@ -103,6 +105,7 @@ float TASHAPEBLOATWIDTH = 1.5;
 frUInt4 VIACOST = 4;
 // new cost used
 frUInt4 GRIDCOST = 2;
+float MAZE_HEURISTIC_WEIGHT = 1;
 frUInt4 ROUTESHAPECOST = 8;
 frUInt4 MARKERCOST = 32;
 frUInt4 MARKERBLOATWIDTH = 1;
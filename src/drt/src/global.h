@@ -42,13 +42,13 @@ extern std::string DRC_RPT_FILE;
 extern std::optional<int> DRC_RPT_ITER_STEP;
 extern std::string CMAP_FILE;
 extern std::string GUIDE_REPORT_FILE;
+extern std::string PA_CACHE_FILE;
 // to be removed
 extern int OR_SEED;
 extern double OR_K;
 
 extern int MAX_THREADS;
 extern int BATCHSIZE;
-extern int BATCHSIZETA;
 extern int MTSAFEDIST;
 extern int DRCSAFEDIST;
 extern int VERBOSE;
@@ -65,6 +65,8 @@ extern bool CLEAN_PATCHES;
 extern bool DO_PA;
 extern bool SINGLE_STEP_DR;
 extern bool SAVE_GUIDE_UPDATES;
+extern bool ADAPTIVE_WORKERS;
+extern bool INCREMENTAL_DR;
 // extern int TEST;
 extern std::string VIAINPIN_BOTTOMLAYER_NAME;
 extern std::string VIAINPIN_TOPLAYER_NAME;
@@ -98,6 +100,9 @@ extern float TASHAPEBLOATWIDTH;
 extern fr::frUInt4 VIACOST;
 
 extern fr::frUInt4 GRIDCOST;
+// weight of the distance estimate in the maze search; above 1 the search
+// expands fewer nodes and the path cost is at most that factor worse
+extern float MAZE_HEURISTIC_WEIGHT;
 extern fr::frUInt4 ROUTESHAPECOST;
 extern fr::frUInt4 MARKERCOST;
 extern fr::frUInt4 MARKERBLOATWIDTH;
@@ -42,6 +42,7 @@
 #include "odb/dbWireCodec.h"
 #include "triton_route/TritonRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 using namespace std;
 using namespace fr;
@@ -127,84 +128,114 @@ void io::Parser::setTracks(odb::dbBlock* block)
 
 void io::Parser::setInsts(odb::dbBlock* block)
 {
+  std::vector<odb::dbInst*> dbInsts;
+  std::vector<unique_ptr<frInst>> insts;
+  std::vector<std::pair<int, int>> firstIds;  // first term and blockage id
   for (auto inst : block->getInsts()) {
     if (design_->name2master_.find(inst->getMaster()->getName())
         == design_->name2master_.end())
       logger_->error(
           DRT, 95, "Library cell {} not found.", inst->getMaster()->getName());
-    if (tmpBlock_->name2inst_.find(inst->getName())
-        != tmpBlock_->name2inst_.end())
-      logger_->error(DRT, 96, "Same cell name: {}.", inst->getName());
     frMaster* master = design_->name2master_.at(inst->getMaster()->getName());
     auto uInst = make_unique<frInst>(inst->getName(), master);
-    auto tmpInst = uInst.get();
-    tmpInst->setId(numInsts_);
+    uInst->setId(numInsts_);
     numInsts_++;
+    firstIds.emplace_back(numTerms_, numBlockages_);
+    numTerms_ += master->getTerms().size();
+    numBlockages_ += master->getBlockages().size();
+    dbInsts.push_back(inst);
+    insts.push_back(std::move(uInst));
+  }
+
+  // The terms and blockages of an instance only depend on its master and
+  // placement, so they are built in parallel.
+  const int grid = tech_->getManufacturingGrid();
+  utl::ThreadException exception;
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < (int) insts.size(); i++) {
+    try {
+      setInst(dbInsts[i], insts[i].get(), firstIds[i], grid);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
 
-    int x, y;
-    inst->getLocation(x, y);
-    tmpInst->setOrigin(Point(x, y));
-    tmpInst->setOrient(inst->getOrient());
-    int numInstTerms = 0;
-    tmpInst->setPinAccessIdx(inst->getPinAccessIdx());
-    dbTransform xform = tmpInst->getUpdatedXform();
-    int grid = tech_->getManufacturingGrid();
-    for (auto& uTerm : tmpInst->getMaster()->getTerms()) {
-      for (auto& pin : uTerm->getPins()) {
-        for (auto& uFig : pin->getFigs()) {
-          if (uFig->typeId() == frcRect) {
-            auto shape = uFig.get();
-            Rect box = shape->getBBox();
-            xform.apply(box);
-            if (box.xMin() % grid || box.yMin() % grid || box.xMax() % grid
-                || box.yMax() % grid) {
+  for (auto& uInst : insts) {
+    if (tmpBlock_->name2inst_.find(uInst->getName())
+        != tmpBlock_->name2inst_.end())
+      logger_->error(DRT, 96, "Same cell name: {}.", uInst->getName());
+    tmpBlock_->addInst(std::move(uInst));
+  }
+}
+
+void io::Parser::setInst(odb::dbInst* inst,
+                         frInst* tmpInst,
+                         const std::pair<int, int>& firstIds,
+                         int grid)
+{
+  int termId = firstIds.first;
+  int blockageId = firstIds.second;
+  int x, y;
+  inst->getLocation(x, y);
+  tmpInst->setOrigin(Point(x, y));
+  tmpInst->setOrient(inst->getOrient());
+  int numInstTerms = 0;
+  tmpInst->setPinAccessIdx(inst->getPinAccessIdx());
+  dbTransform xform = tmpInst->getUpdatedXform();
+  for (auto& uTerm : tmpInst->getMaster()->getTerms()) {
+    for (auto& pin : uTerm->getPins()) {
+      for (auto& uFig : pin->getFigs()) {
+        if (uFig->typeId() == frcRect) {
+          auto shape = uFig.get();
+          Rect box = shape->getBBox();
+          xform.apply(box);
+          if (box.xMin() % grid || box.yMin() % grid || box.xMax() % grid
+              || box.yMax() % grid) {
+            logger_->error(
+                DRT,
+                416,
+                "Term {} of {} contains offgrid pin shape. Pin shape {} is "
+                "not a multiple of the manufacturing grid {}.",
+                uTerm->getName(),
+                tmpInst->getName(),
+                box,
+                grid);
+          }
+        } else if (uFig->typeId() == frcPolygon) {
+          auto polygon = static_cast<frPolygon*>(uFig.get());
+          for (Point pt : polygon->getPoints()) {
+            xform.apply(pt);
+            if (pt.getX() % grid || pt.getY() % grid) {
               logger_->error(
                   DRT,
-                  416,
-                  "Term {} of {} contains offgrid pin shape. Pin shape {} is "
-                  "not a multiple of the manufacturing grid {}.",
+                  417,
+                  "Term {} of {} contains offgrid pin shape. Polygon point "
+                  "{} is not a multiple of the manufacturing grid {}.",
                   uTerm->getName(),
                   tmpInst->getName(),
-                  box,
+                  pt,
                   grid);
             }
-          } else if (uFig->typeId() == frcPolygon) {
-            auto polygon = static_cast<frPolygon*>(uFig.get());
-            for (Point pt : polygon->getPoints()) {
-              xform.apply(pt);
-              if (pt.getX() % grid || pt.getY() % grid) {
-                logger_->error(
-                    DRT,
-                    417,
-                    "Term {} of {} contains offgrid pin shape. Polygon point "
-                    "{} is not a multiple of the manufacturing grid {}.",
-                    uTerm->getName(),
-                    tmpInst->getName(),
-                    pt,
-                    grid);
-              }
-            }
           }
         }
       }
-
-      auto term = uTerm.get();
-      unique_ptr<frInstTerm> instTerm = make_unique<frInstTerm>(tmpInst, term);
-      instTerm->setId(numTerms_++);
-      instTerm->setIndexInOwner(numInstTerms++);
-      int pinCnt = term->getPins().size();
-      instTerm->setAPSize(pinCnt);
-      tmpInst->addInstTerm(std::move(instTerm));
-    }
-    for (auto& uBlk : tmpInst->getMaster()->getBlockages()) {
-      auto blk = uBlk.get();
-      unique_ptr<frInstBlockage> instBlk
-          = make_unique<frInstBlockage>(tmpInst, blk);
-      instBlk->setId(numBlockages_);
-      numBlockages_++;
-      tmpInst->addInstBlockage(std::move(instBlk));
     }
-    tmpBlock_->addInst(std::move(uInst));
+
+    auto term = uTerm.get();
+    unique_ptr<frInstTerm> instTerm = make_unique<frInstTerm>(tmpInst, term);
+    instTerm->setId(termId++);
+    instTerm->setIndexInOwner(numInstTerms++);
+    int pinCnt = term->getPins().size();
+    instTerm->setAPSize(pinCnt);
+    tmpInst->addInstTerm(std::move(instTerm));
+  }
+  for (auto& uBlk : tmpInst->getMaster()->getBlockages()) {
+    auto blk = uBlk.get();
+    unique_ptr<frInstBlockage> instBlk
+        = make_unique<frInstBlockage>(tmpInst, blk);
+    instBlk->setId(blockageId++);
+    tmpInst->addInstBlockage(std::move(instBlk));
   }
 }
 
@@ -540,258 +571,352 @@ void io::Parser::getSBoxCoords(odb::dbSBox* box,
 
 void io::Parser::setNets(odb::dbBlock* block)
 {
+  std::vector<odb::dbNet*> dbNets;
   for (auto net : block->getNets()) {
-    bool is_special = net->isSpecial();
-    if (!is_special && net->getSigType().isSupply()) {
+    dbNets.push_back(net);
+  }
+
+  // A net only touches its own frNet and the terms connected to it, so the
+  // nets are converted in parallel and added to the block in db order.
+  std::vector<unique_ptr<frNet>> nets(dbNets.size());
+  utl::ThreadException exception;
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < (int) dbNets.size(); i++) {
+    try {
+      nets[i] = createNet(dbNets[i]);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (auto& uNetIn : nets) {
+    uNetIn->setId(numNets_);
+    numNets_++;
+    if (uNetIn->isSpecial())
+      tmpBlock_->addSNet(std::move(uNetIn));
+    else
+      tmpBlock_->addNet(std::move(uNetIn));
+  }
+}
+
+unique_ptr<frNet> io::Parser::createNet(odb::dbNet* net)
+{
+  bool is_special = net->isSpecial();
+  if (!is_special && net->getSigType().isSupply()) {
+    logger_->error(DRT,
+                   305,
+                   "Net {} of signal type {} is not routable by TritonRoute. "
+                   "Move to special nets.",
+                   net->getName(),
+                   net->getSigType().getString());
+  }
+  unique_ptr<frNet> uNetIn = make_unique<frNet>(net->getName());
+  auto netIn = uNetIn.get();
+  if (net->getNonDefaultRule())
+    uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
+        net->getNonDefaultRule()->getName()));
+  if (net->getSigType() == dbSigType::CLOCK)
+    uNetIn->updateIsClock(true);
+  if (is_special)
+    uNetIn->setIsSpecial(true);
+  for (auto term : net->getBTerms()) {
+    if (term->getSigType().isSupply() && !net->getSigType().isSupply())
       logger_->error(DRT,
-                     305,
-                     "Net {} of signal type {} is not routable by TritonRoute. "
-                     "Move to special nets.",
+                     306,
+                     "Net {} of signal type {} cannot be connected to bterm "
+                     "{} with signal type {}",
                      net->getName(),
-                     net->getSigType().getString());
-    }
-    unique_ptr<frNet> uNetIn = make_unique<frNet>(net->getName());
-    auto netIn = uNetIn.get();
-    if (net->getNonDefaultRule())
-      uNetIn->updateNondefaultRule(design_->getTech()->getNondefaultRule(
-          net->getNonDefaultRule()->getName()));
-    if (net->getSigType() == dbSigType::CLOCK)
-      uNetIn->updateIsClock(true);
-    if (is_special)
-      uNetIn->setIsSpecial(true);
-    netIn->setId(numNets_);
-    numNets_++;
-    for (auto term : net->getBTerms()) {
-      if (term->getSigType().isSupply() && !net->getSigType().isSupply())
-        logger_->error(DRT,
-                       306,
-                       "Net {} of signal type {} cannot be connected to bterm "
-                       "{} with signal type {}",
-                       net->getName(),
-                       net->getSigType().getString(),
-                       term->getName(),
-                       term->getSigType().getString());
-      if (tmpBlock_->name2term_.find(term->getName())
-          == tmpBlock_->name2term_.end())
-        logger_->error(DRT, 104, "Terminal {} not found.", term->getName());
-      auto frbterm = tmpBlock_->name2term_[term->getName()];  // frBTerm*
-      frbterm->addToNet(netIn);
-      netIn->addBTerm(frbterm);
-      if (!is_special) {
-        // graph enablement
-        auto termNode = make_unique<frNode>();
-        termNode->setPin(frbterm);
-        termNode->setType(frNodeTypeEnum::frcPin);
-        netIn->addNode(termNode);
-      }
-    }
-    for (auto term : net->getITerms()) {
-      if (term->getSigType().isSupply() && !net->getSigType().isSupply())
-        logger_->error(DRT,
-                       307,
-                       "Net {} of signal type {} cannot be connected to iterm "
-                       "{}/{} with signal type {}",
-                       net->getName(),
-                       net->getSigType().getString(),
-                       term->getInst()->getName(),
-                       term->getMTerm()->getName(),
-                       term->getSigType().getString());
-      if (tmpBlock_->name2inst_.find(term->getInst()->getName())
-          == tmpBlock_->name2inst_.end())
-        logger_->error(
-            DRT, 105, "Component {} not found.", term->getInst()->getName());
-      auto inst = tmpBlock_->name2inst_[term->getInst()->getName()];
-      // gettin inst term
-      auto frterm = inst->getMaster()->getTerm(term->getMTerm()->getName());
-      if (frterm == nullptr)
-        logger_->error(DRT,
-                       106,
-                       "Component pin {}/{} not found.",
-                       term->getInst()->getName(),
-                       term->getMTerm()->getName());
-      int idx = frterm->getIndexInOwner();
-      auto& instTerms = inst->getInstTerms();
-      auto instTerm = instTerms[idx].get();
-      assert(instTerm->getTerm()->getName() == term->getMTerm()->getName());
-
-      instTerm->addToNet(netIn);
-      netIn->addInstTerm(instTerm);
-      if (!is_special) {
-        // graph enablement
-        auto instTermNode = make_unique<frNode>();
-        instTermNode->setPin(instTerm);
-        instTermNode->setType(frNodeTypeEnum::frcPin);
-        netIn->addNode(instTermNode);
-      }
-    }
-    // initialize
-    string layerName = "";
-    string viaName = "";
-    string shape = "";
-    bool hasBeginPoint = false;
-    bool hasEndPoint = false;
-    bool beginInVia = false;
-    frCoord beginX = -1;
-    frCoord beginY = -1;
-    frCoord beginExt = -1;
-    frCoord nextX = -1;
-    frCoord nextY = -1;
-    frCoord endX = -1;
-    frCoord endY = -1;
-    frCoord endExt = -1;
-    odb::dbTechLayer* prevLayer = nullptr;
-    odb::dbTechLayer* lower_layer = nullptr;
-    odb::dbTechLayer* top_layer = nullptr;
-    bool hasRect = false;
-    frCoord left = -1;
-    frCoord bottom = -1;
-    frCoord right = -1;
-    frCoord top = -1;
-    frCoord width = 0;
-    odb::dbWireDecoder decoder;
-
-    if (!net->isSpecial() && net->getWire() != nullptr) {
-      decoder.begin(net->getWire());
-      odb::dbWireDecoder::OpCode pathId = decoder.next();
-      while (pathId != odb::dbWireDecoder::END_DECODE) {
-        // for each path start
-        layerName = "";
-        viaName = "";
-        shape = "";
-        hasBeginPoint = false;
-        hasEndPoint = false;
-        beginInVia = false;
-        beginX = -1;
-        beginY = -1;
-        beginExt = -1;
-        endX = -1;
-        endY = -1;
-        endExt = -1;
-        hasRect = false;
-        left = -1;
-        bottom = -1;
-        right = -1;
-        top = -1;
-        width = 0;
-        bool endpath = false;
-        do {
-          switch (pathId) {
-            case odb::dbWireDecoder::PATH:
-            case odb::dbWireDecoder::JUNCTION:
-            case odb::dbWireDecoder::SHORT:
-            case odb::dbWireDecoder::VWIRE:
-              prevLayer = decoder.getLayer();
-              layerName = prevLayer->getName();
-              if (tech_->name2layer.find(layerName) == tech_->name2layer.end())
-                logger_->error(DRT, 107, "Unsupported layer {}.", layerName);
-              break;
-            case odb::dbWireDecoder::POINT:
-
-              if (!hasBeginPoint) {
-                decoder.getPoint(beginX, beginY);
-                hasBeginPoint = true;
-              } else {
-                decoder.getPoint(endX, endY);
-                hasEndPoint = true;
-              }
-              break;
-            case odb::dbWireDecoder::POINT_EXT:
-              if (!hasBeginPoint) {
-                decoder.getPoint(beginX, beginY, beginExt);
-                hasBeginPoint = true;
-              } else {
-                decoder.getPoint(endX, endY, endExt);
-                hasEndPoint = true;
-              }
-              break;
-            case odb::dbWireDecoder::VIA:
-              viaName = string(decoder.getVia()->getName());
-              lower_layer = decoder.getVia()->getBottomLayer();
-              top_layer = decoder.getVia()->getTopLayer();
-              layerName = prevLayer == top_layer ? lower_layer->getName()
-                                                 : top_layer->getName();
-              if (!hasBeginPoint) {
-                beginX = nextX;
-                beginY = nextY;
-                hasBeginPoint = true;
-                beginInVia = true;
-              }
-              break;
-            case odb::dbWireDecoder::TECH_VIA:
-              viaName = string(decoder.getTechVia()->getName());
-              lower_layer = decoder.getTechVia()->getBottomLayer();
-              top_layer = decoder.getTechVia()->getTopLayer();
-              layerName = prevLayer == top_layer ? lower_layer->getName()
-                                                 : top_layer->getName();
-              if (!hasBeginPoint) {
-                beginX = nextX;
-                beginY = nextY;
-                hasBeginPoint = true;
-                beginInVia = true;
-              }
-              break;
-            case odb::dbWireDecoder::RECT:
-              decoder.getRect(left, bottom, right, top);
-              hasRect = true;
-              break;
-            case odb::dbWireDecoder::ITERM:
-            case odb::dbWireDecoder::BTERM:
-            case odb::dbWireDecoder::RULE:
-            case odb::dbWireDecoder::END_DECODE:
-              break;
-            default:
-              break;
-          }
-          pathId = decoder.next();
-          if ((int) pathId <= 3 || pathId == odb::dbWireDecoder::TECH_VIA
-              || pathId == odb::dbWireDecoder::VIA
-              || pathId == odb::dbWireDecoder::END_DECODE) {
-            if (hasEndPoint) {
-              nextX = endX;
-              nextY = endY;
+                     net->getSigType().getString(),
+                     term->getName(),
+                     term->getSigType().getString());
+    if (tmpBlock_->name2term_.find(term->getName())
+        == tmpBlock_->name2term_.end())
+      logger_->error(DRT, 104, "Terminal {} not found.", term->getName());
+    auto frbterm = tmpBlock_->name2term_.at(term->getName());  // frBTerm*
+    frbterm->addToNet(netIn);
+    netIn->addBTerm(frbterm);
+    if (!is_special) {
+      // graph enablement
+      auto termNode = make_unique<frNode>();
+      termNode->setPin(frbterm);
+      termNode->setType(frNodeTypeEnum::frcPin);
+      netIn->addNode(termNode);
+    }
+  }
+  for (auto term : net->getITerms()) {
+    if (term->getSigType().isSupply() && !net->getSigType().isSupply())
+      logger_->error(DRT,
+                     307,
+                     "Net {} of signal type {} cannot be connected to iterm "
+                     "{}/{} with signal type {}",
+                     net->getName(),
+                     net->getSigType().getString(),
+                     term->getInst()->getName(),
+                     term->getMTerm()->getName(),
+                     term->getSigType().getString());
+    if (tmpBlock_->name2inst_.find(term->getInst()->getName())
+        == tmpBlock_->name2inst_.end())
+      logger_->error(
+          DRT, 105, "Component {} not found.", term->getInst()->getName());
+    auto inst = tmpBlock_->name2inst_.at(term->getInst()->getName());
+    // gettin inst term
+    auto frterm = inst->getMaster()->getTerm(term->getMTerm()->getName());
+    if (frterm == nullptr)
+      logger_->error(DRT,
+                     106,
+                     "Component pin {}/{} not found.",
+                     term->getInst()->getName(),
+                     term->getMTerm()->getName());
+    int idx = frterm->getIndexInOwner();
+    auto& instTerms = inst->getInstTerms();
+    auto instTerm = instTerms[idx].get();
+    assert(instTerm->getTerm()->getName() == term->getMTerm()->getName());
+
+    instTerm->addToNet(netIn);
+    netIn->addInstTerm(instTerm);
+    if (!is_special) {
+      // graph enablement
+      auto instTermNode = make_unique<frNode>();
+      instTermNode->setPin(instTerm);
+      instTermNode->setType(frNodeTypeEnum::frcPin);
+      netIn->addNode(instTermNode);
+    }
+  }
+  // initialize
+  string layerName = "";
+  string viaName = "";
+  string shape = "";
+  bool hasBeginPoint = false;
+  bool hasEndPoint = false;
+  bool beginInVia = false;
+  frCoord beginX = -1;
+  frCoord beginY = -1;
+  frCoord beginExt = -1;
+  frCoord nextX = -1;
+  frCoord nextY = -1;
+  frCoord endX = -1;
+  frCoord endY = -1;
+  frCoord endExt = -1;
+  odb::dbTechLayer* prevLayer = nullptr;
+  odb::dbTechLayer* lower_layer = nullptr;
+  odb::dbTechLayer* top_layer = nullptr;
+  bool hasRect = false;
+  frCoord left = -1;
+  frCoord bottom = -1;
+  frCoord right = -1;
+  frCoord top = -1;
+  frCoord width = 0;
+  odb::dbWireDecoder decoder;
+
+  if (!net->isSpecial() && net->getWire() != nullptr) {
+    decoder.begin(net->getWire());
+    odb::dbWireDecoder::OpCode pathId = decoder.next();
+    while (pathId != odb::dbWireDecoder::END_DECODE) {
+      // for each path start
+      layerName = "";
+      viaName = "";
+      shape = "";
+      hasBeginPoint = false;
+      hasEndPoint = false;
+      beginInVia = false;
+      beginX = -1;
+      beginY = -1;
+      beginExt = -1;
+      endX = -1;
+      endY = -1;
+      endExt = -1;
+      hasRect = false;
+      left = -1;
+      bottom = -1;
+      right = -1;
+      top = -1;
+      width = 0;
+      bool endpath = false;
+      do {
+        switch (pathId) {
+          case odb::dbWireDecoder::PATH:
+          case odb::dbWireDecoder::JUNCTION:
+          case odb::dbWireDecoder::SHORT:
+          case odb::dbWireDecoder::VWIRE:
+            prevLayer = decoder.getLayer();
+            layerName = prevLayer->getName();
+            if (tech_->name2layer.find(layerName) == tech_->name2layer.end())
+              logger_->error(DRT, 107, "Unsupported layer {}.", layerName);
+            break;
+          case odb::dbWireDecoder::POINT:
+
+            if (!hasBeginPoint) {
+              decoder.getPoint(beginX, beginY);
+              hasBeginPoint = true;
             } else {
-              nextX = beginX;
-              nextY = beginY;
+              decoder.getPoint(endX, endY);
+              hasEndPoint = true;
             }
-            endpath = true;
+            break;
+          case odb::dbWireDecoder::POINT_EXT:
+            if (!hasBeginPoint) {
+              decoder.getPoint(beginX, beginY, beginExt);
+              hasBeginPoint = true;
+            } else {
+              decoder.getPoint(endX, endY, endExt);
+              hasEndPoint = true;
+            }
+            break;
+          case odb::dbWireDecoder::VIA:
+            viaName = string(decoder.getVia()->getName());
+            lower_layer = decoder.getVia()->getBottomLayer();
+            top_layer = decoder.getVia()->getTopLayer();
+            layerName = prevLayer == top_layer ? lower_layer->getName()
+                                               : top_layer->getName();
+            if (!hasBeginPoint) {
+              beginX = nextX;
+              beginY = nextY;
+              hasBeginPoint = true;
+              beginInVia = true;
+            }
+            break;
+          case odb::dbWireDecoder::TECH_VIA:
+            viaName = string(decoder.getTechVia()->getName());
+            lower_layer = decoder.getTechVia()->getBottomLayer();
+            top_layer = decoder.getTechVia()->getTopLayer();
+            layerName = prevLayer == top_layer ? lower_layer->getName()
+                                               : top_layer->getName();
+            if (!hasBeginPoint) {
+              beginX = nextX;
+              beginY = nextY;
+              hasBeginPoint = true;
+              beginInVia = true;
+            }
+            break;
+          case odb::dbWireDecoder::RECT:
+            decoder.getRect(left, bottom, right, top);
+            hasRect = true;
+            break;
+          case odb::dbWireDecoder::ITERM:
+          case odb::dbWireDecoder::BTERM:
+          case odb::dbWireDecoder::RULE:
+          case odb::dbWireDecoder::END_DECODE:
+            break;
+          default:
+            break;
+        }
+        pathId = decoder.next();
+        if ((int) pathId <= 3 || pathId == odb::dbWireDecoder::TECH_VIA
+            || pathId == odb::dbWireDecoder::VIA
+            || pathId == odb::dbWireDecoder::END_DECODE) {
+          if (hasEndPoint) {
+            nextX = endX;
+            nextY = endY;
+          } else {
+            nextX = beginX;
+            nextY = beginY;
           }
-        } while (!endpath);
-        auto layerNum = tech_->name2layer[layerName]->getLayerNum();
-        if (hasRect) {
-          continue;
+          endpath = true;
         }
-        if (hasEndPoint) {
-          auto tmpP = make_unique<frPathSeg>();
-          if (beginX > endX || beginY > endY) {
-            tmpP->setPoints(Point(endX, endY), Point(beginX, beginY));
-            swap(beginExt, endExt);
+      } while (!endpath);
+      auto layerNum = tech_->name2layer.at(layerName)->getLayerNum();
+      if (hasRect) {
+        // patch wire: a rect relative to the path point
+        auto tmpP = make_unique<frPatchWire>();
+        tmpP->setOrigin(Point(beginX, beginY));
+        tmpP->setOffsetBox(Rect(left, bottom, right, top));
+        tmpP->setLayerNum(layerNum);
+        netIn->addPatchWire(std::move(tmpP));
+        continue;
+      }
+      if (hasEndPoint) {
+        auto tmpP = make_unique<frPathSeg>();
+        if (beginX > endX || beginY > endY) {
+          tmpP->setPoints(Point(endX, endY), Point(beginX, beginY));
+          swap(beginExt, endExt);
+        } else {
+          tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
+        }
+        tmpP->addToNet(netIn);
+        tmpP->setLayerNum(layerNum);
+
+        width = (width) ? width : tech_->name2layer.at(layerName)->getWidth();
+        auto defaultBeginExt = width / 2;
+        auto defaultEndExt = width / 2;
+
+        frEndStyleEnum tmpBeginEnum;
+        if (beginExt == -1) {
+          tmpBeginEnum = frcExtendEndStyle;
+        } else if (beginExt == 0) {
+          tmpBeginEnum = frcTruncateEndStyle;
+        } else {
+          tmpBeginEnum = frcVariableEndStyle;
+        }
+        frEndStyle tmpBeginStyle(tmpBeginEnum);
+
+        frEndStyleEnum tmpEndEnum;
+        if (endExt == -1) {
+          tmpEndEnum = frcExtendEndStyle;
+        } else if (endExt == 0) {
+          tmpEndEnum = frcTruncateEndStyle;
+        } else {
+          tmpEndEnum = frcVariableEndStyle;
+        }
+        frEndStyle tmpEndStyle(tmpEndEnum);
+
+        frSegStyle tmpSegStyle;
+        tmpSegStyle.setWidth(width);
+        tmpSegStyle.setBeginStyle(
+            tmpBeginStyle,
+            tmpBeginEnum == frcExtendEndStyle ? defaultBeginExt : beginExt);
+        tmpSegStyle.setEndStyle(
+            tmpEndStyle,
+            tmpEndEnum == frcExtendEndStyle ? defaultEndExt : endExt);
+        tmpP->setStyle(tmpSegStyle);
+        netIn->addShape(std::move(tmpP));
+      }
+      if (viaName != "") {
+        if (tech_->name2via.find(viaName) == tech_->name2via.end()) {
+          logger_->error(DRT, 108, "Unsupported via in db.");
+        } else {
+          Point p;
+          if (hasEndPoint && !beginInVia) {
+            p = {endX, endY};
           } else {
-            tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
+            p = {beginX, beginY};
           }
+          auto viaDef = tech_->name2via.at(viaName);
+          auto tmpP = make_unique<frVia>(viaDef);
+          tmpP->setOrigin(p);
+          tmpP->addToNet(netIn);
+          netIn->addVia(std::move(tmpP));
+        }
+      }
+      // for each path end
+    }
+  }
+  if (net->isSpecial()) {
+    for (auto swire : net->getSWires()) {
+      for (auto box : swire->getWires()) {
+        if (!box->isVia()) {
+          getSBoxCoords(box, beginX, beginY, endX, endY, width);
+          auto layerNum = tech_->name2layer.at(box->getTechLayer()->getName())
+                              ->getLayerNum();
+          auto tmpP = make_unique<frPathSeg>();
+          tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
           tmpP->addToNet(netIn);
           tmpP->setLayerNum(layerNum);
-
-          width = (width) ? width : tech_->name2layer[layerName]->getWidth();
-          auto defaultBeginExt = width / 2;
-          auto defaultEndExt = width / 2;
+          width = (width) ? width : tech_->getLayer(layerNum)->getWidth();
+          auto defaultExt = width / 2;
 
           frEndStyleEnum tmpBeginEnum;
-          if (beginExt == -1) {
+          if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
             tmpBeginEnum = frcExtendEndStyle;
-          } else if (beginExt == 0) {
-            tmpBeginEnum = frcTruncateEndStyle;
           } else {
-            tmpBeginEnum = frcVariableEndStyle;
+            tmpBeginEnum = frcTruncateEndStyle;
           }
           frEndStyle tmpBeginStyle(tmpBeginEnum);
-
           frEndStyleEnum tmpEndEnum;
-          if (endExt == -1) {
+          if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
             tmpEndEnum = frcExtendEndStyle;
-          } else if (endExt == 0) {
-            tmpEndEnum = frcTruncateEndStyle;
           } else {
-            tmpEndEnum = frcVariableEndStyle;
+            tmpEndEnum = frcTruncateEndStyle;
           }
           frEndStyle tmpEndStyle(tmpEndEnum);
 
@@ -799,99 +924,35 @@ void io::Parser::setNets(odb::dbBlock* block)
           tmpSegStyle.setWidth(width);
           tmpSegStyle.setBeginStyle(
               tmpBeginStyle,
-              tmpBeginEnum == frcExtendEndStyle ? defaultBeginExt : beginExt);
+              tmpBeginEnum == frcExtendEndStyle ? defaultExt : 0);
           tmpSegStyle.setEndStyle(
-              tmpEndStyle,
-              tmpEndEnum == frcExtendEndStyle ? defaultEndExt : endExt);
+              tmpEndStyle, tmpEndEnum == frcExtendEndStyle ? defaultExt : 0);
           tmpP->setStyle(tmpSegStyle);
           netIn->addShape(std::move(tmpP));
-        }
-        if (viaName != "") {
-          if (tech_->name2via.find(viaName) == tech_->name2via.end()) {
-            logger_->error(DRT, 108, "Unsupported via in db.");
-          } else {
-            Point p;
-            if (hasEndPoint && !beginInVia) {
-              p = {endX, endY};
-            } else {
-              p = {beginX, beginY};
-            }
-            auto viaDef = tech_->name2via[viaName];
+        } else {
+          if (box->getTechVia())
+            viaName = box->getTechVia()->getName();
+          else if (box->getBlockVia())
+            viaName = box->getBlockVia()->getName();
+
+          if (tech_->name2via.find(viaName) == tech_->name2via.end())
+            logger_->error(DRT, 109, "Unsupported via in db.");
+          else {
+            int x, y;
+            box->getViaXY(x, y);
+            Point p(x, y);
+            auto viaDef = tech_->name2via.at(viaName);
             auto tmpP = make_unique<frVia>(viaDef);
             tmpP->setOrigin(p);
             tmpP->addToNet(netIn);
             netIn->addVia(std::move(tmpP));
           }
         }
-        // for each path end
       }
     }
-    if (net->isSpecial()) {
-      for (auto swire : net->getSWires()) {
-        for (auto box : swire->getWires()) {
-          if (!box->isVia()) {
-            getSBoxCoords(box, beginX, beginY, endX, endY, width);
-            auto layerNum = tech_->name2layer[box->getTechLayer()->getName()]
-                                ->getLayerNum();
-            auto tmpP = make_unique<frPathSeg>();
-            tmpP->setPoints(Point(beginX, beginY), Point(endX, endY));
-            tmpP->addToNet(netIn);
-            tmpP->setLayerNum(layerNum);
-            width = (width) ? width : tech_->name2layer[layerName]->getWidth();
-            auto defaultExt = width / 2;
-
-            frEndStyleEnum tmpBeginEnum;
-            if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
-              tmpBeginEnum = frcExtendEndStyle;
-            } else {
-              tmpBeginEnum = frcTruncateEndStyle;
-            }
-            frEndStyle tmpBeginStyle(tmpBeginEnum);
-            frEndStyleEnum tmpEndEnum;
-            if (box->getWireShapeType() == odb::dbWireShapeType::NONE) {
-              tmpEndEnum = frcExtendEndStyle;
-            } else {
-              tmpEndEnum = frcTruncateEndStyle;
-            }
-            frEndStyle tmpEndStyle(tmpEndEnum);
-
-            frSegStyle tmpSegStyle;
-            tmpSegStyle.setWidth(width);
-            tmpSegStyle.setBeginStyle(
-                tmpBeginStyle,
-                tmpBeginEnum == frcExtendEndStyle ? defaultExt : 0);
-            tmpSegStyle.setEndStyle(
-                tmpEndStyle, tmpEndEnum == frcExtendEndStyle ? defaultExt : 0);
-            tmpP->setStyle(tmpSegStyle);
-            netIn->addShape(std::move(tmpP));
-          } else {
-            if (box->getTechVia())
-              viaName = box->getTechVia()->getName();
-            else if (box->getBlockVia())
-              viaName = box->getBlockVia()->getName();
-
-            if (tech_->name2via.find(viaName) == tech_->name2via.end())
-              logger_->error(DRT, 109, "Unsupported via in db.");
-            else {
-              int x, y;
-              box->getViaXY(x, y);
-              Point p(x, y);
-              auto viaDef = tech_->name2via[viaName];
-              auto tmpP = make_unique<frVia>(viaDef);
-              tmpP->setOrigin(p);
-              tmpP->addToNet(netIn);
-              netIn->addVia(std::move(tmpP));
-            }
-          }
-        }
-      }
-    }
-    netIn->setType(net->getSigType());
-    if (is_special)
-      tmpBlock_->addSNet(std::move(uNetIn));
-    else
-      tmpBlock_->addNet(std::move(uNetIn));
   }
+  netIn->setType(net->getSigType());
+  return uNetIn;
 }
 
 void updatefrAccessPoint(odb::dbAccessPoint* db_ap,
@@ -2986,6 +3047,9 @@ void io::Writer::fillConnFigs(bool isTA)
     logger_->info(DRT, 180, "Post processing.");
   }
   for (auto& net : getDesign()->getTopBlock()->getNets()) {
+    if (!targetNets_.empty() && targetNets_.count(net.get()) == 0) {
+      continue;
+    }
     fillConnFigs_net(net.get(), isTA);
   }
   if (isTA) {
@@ -3037,116 +3101,142 @@ void io::Writer::updateDbConn(odb::dbBlock* block,
                               odb::dbTech* db_tech,
                               bool snapshot)
 {
-  odb::dbWireEncoder _wire_encoder;
+  // Creating the wires changes the block so it stays serial.  Encoding
+  // only reads the db, so each net gets its own encoder and they run in
+  // parallel.  The wires are then committed in net order, which keeps the
+  // result independent of the thread count.
+  std::vector<odb::dbNet*> nets;
+  std::vector<odb::dbWireEncoder> encoders;
+  nets.reserve(connFigs_.size());
+  encoders.reserve(connFigs_.size());
   for (auto net : block->getNets()) {
-    if (connFigs_.find(net->getName()) != connFigs_.end()) {
-      odb::dbWire* wire = net->getWire();
-      if (wire == nullptr) {
-        wire = odb::dbWire::create(net);
-        _wire_encoder.begin(wire);
-      } else if (snapshot) {
-        odb::dbWire::destroy(wire);
-        wire = odb::dbWire::create(net);
-        _wire_encoder.begin(wire);
-      } else {
-        _wire_encoder.append(wire);
-      }
+    if (connFigs_.find(net->getName()) == connFigs_.end()) {
+      continue;
+    }
+    odb::dbWire* wire = net->getWire();
+    bool append = false;
+    if (wire == nullptr) {
+      wire = odb::dbWire::create(net);
+    } else if (snapshot) {
+      odb::dbWire::destroy(wire);
+      wire = odb::dbWire::create(net);
+    } else {
+      append = true;
+    }
+    nets.push_back(net);
+    encoders.emplace_back();
+    if (append) {
+      encoders.back().append(wire);
+    } else {
+      encoders.back().begin(wire);
+    }
+  }
 
-      for (auto& connFig : connFigs_.at(net->getName())) {
-        switch (connFig->typeId()) {
-          case frcPathSeg: {
-            auto pathSeg = std::dynamic_pointer_cast<frPathSeg>(connFig);
-            auto layerName
-                = getTech()->getLayer(pathSeg->getLayerNum())->getName();
-            auto layer = db_tech->findLayer(layerName.c_str());
-            if (pathSeg->isTapered() || !net->getNonDefaultRule())
-              _wire_encoder.newPath(layer, odb::dbWireType("ROUTED"));
-            else
-              _wire_encoder.newPath(
-                  layer,
-                  odb::dbWireType("ROUTED"),
-                  net->getNonDefaultRule()->getLayerRule(layer));
-            auto [begin, end] = pathSeg->getPoints();
-            frSegStyle segStyle = pathSeg->getStyle();
-            if (segStyle.getBeginStyle() == frEndStyle(frcExtendEndStyle)) {
-              if (segStyle.getBeginExt() != layer->getWidth() / 2)
-                _wire_encoder.addPoint(
-                    begin.x(), begin.y(), segStyle.getBeginExt(), 0);
-              else
-                _wire_encoder.addPoint(begin.x(), begin.y());
-            } else if (segStyle.getBeginStyle()
-                       == frEndStyle(frcTruncateEndStyle)) {
-              _wire_encoder.addPoint(begin.x(), begin.y(), 0, 0);
-            } else if (segStyle.getBeginStyle()
-                       == frEndStyle(frcVariableEndStyle)) {
-              _wire_encoder.addPoint(
-                  begin.x(), begin.y(), segStyle.getBeginExt(), 0);
-            }
-            if (segStyle.getEndStyle() == frEndStyle(frcExtendEndStyle)) {
-              if (segStyle.getEndExt() != layer->getWidth() / 2)
-                _wire_encoder.addPoint(
-                    end.x(), end.y(), segStyle.getEndExt(), 0);
-              else
-                _wire_encoder.addPoint(end.x(), end.y());
-            } else if (segStyle.getEndStyle()
-                       == frEndStyle(frcTruncateEndStyle)) {
-              _wire_encoder.addPoint(end.x(), end.y(), 0, 0);
-            } else if (segStyle.getBeginStyle()
-                       == frEndStyle(frcVariableEndStyle)) {
-              _wire_encoder.addPoint(end.x(), end.y(), segStyle.getEndExt(), 0);
-            }
-            break;
-          }
-          case frcVia: {
-            auto via = std::dynamic_pointer_cast<frVia>(connFig);
-            auto layerName = getTech()
-                                 ->getLayer(via->getViaDef()->getLayer1Num())
-                                 ->getName();
-            auto viaName = via->getViaDef()->getName();
-            auto layer = db_tech->findLayer(layerName.c_str());
-            if (!net->getNonDefaultRule() || via->isTapered())
-              _wire_encoder.newPath(layer, odb::dbWireType("ROUTED"));
-            else
-              _wire_encoder.newPath(
-                  layer,
-                  odb::dbWireType("ROUTED"),
-                  net->getNonDefaultRule()->getLayerRule(layer));
-            Point origin = via->getOrigin();
-            _wire_encoder.addPoint(origin.x(), origin.y());
-            odb::dbTechVia* tech_via = db_tech->findVia(viaName.c_str());
-            if (tech_via != nullptr) {
-              _wire_encoder.addTechVia(tech_via);
-            } else {
-              odb::dbVia* db_via = block->findVia(viaName.c_str());
-              _wire_encoder.addVia(db_via);
-            }
-            break;
-          }
-          case frcPatchWire: {
-            auto pwire = std::dynamic_pointer_cast<frPatchWire>(connFig);
-            auto layerName
-                = getTech()->getLayer(pwire->getLayerNum())->getName();
-            auto layer = db_tech->findLayer(layerName.c_str());
-            _wire_encoder.newPath(layer, odb::dbWireType("ROUTED"));
-            Point origin = pwire->getOrigin();
-            Rect offsetBox = pwire->getOffsetBox();
-            _wire_encoder.addPoint(origin.x(), origin.y());
-            _wire_encoder.addRect(offsetBox.xMin(),
-                                  offsetBox.yMin(),
-                                  offsetBox.xMax(),
-                                  offsetBox.yMax());
-            break;
-          }
-          default: {
-            _wire_encoder.clear();
-            logger_->error(DRT,
-                           114,
-                           "Unknown connFig type while writing net {}.",
-                           net->getName());
-          }
+  utl::ThreadException exception;
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int) nets.size(); i++) {
+    try {
+      encodeConn(block, db_tech, nets[i], encoders[i]);
+    } catch (...) {
+      exception.capture();
+    }
+  }
+  exception.rethrow();
+
+  for (auto& encoder : encoders) {
+    encoder.end();
+  }
+}
+
+void io::Writer::encodeConn(odb::dbBlock* block,
+                            odb::dbTech* db_tech,
+                            odb::dbNet* net,
+                            odb::dbWireEncoder& encoder)
+{
+  for (auto& connFig : connFigs_.at(net->getName())) {
+    switch (connFig->typeId()) {
+      case frcPathSeg: {
+        auto pathSeg = std::dynamic_pointer_cast<frPathSeg>(connFig);
+        auto layerName = getTech()->getLayer(pathSeg->getLayerNum())->getName();
+        auto layer = db_tech->findLayer(layerName.c_str());
+        if (pathSeg->isTapered() || !net->getNonDefaultRule())
+          encoder.newPath(layer, odb::dbWireType("ROUTED"));
+        else
+          encoder.newPath(layer,
+                          odb::dbWireType("ROUTED"),
+                          net->getNonDefaultRule()->getLayerRule(layer));
+        auto [begin, end] = pathSeg->getPoints();
+        frSegStyle segStyle = pathSeg->getStyle();
+        if (segStyle.getBeginStyle() == frEndStyle(frcExtendEndStyle)) {
+          if (segStyle.getBeginExt() != layer->getWidth() / 2)
+            encoder.addPoint(begin.x(), begin.y(), segStyle.getBeginExt(), 0);
+          else
+            encoder.addPoint(begin.x(), begin.y());
+        } else if (segStyle.getBeginStyle()
+                   == frEndStyle(frcTruncateEndStyle)) {
+          encoder.addPoint(begin.x(), begin.y(), 0, 0);
+        } else if (segStyle.getBeginStyle()
+                   == frEndStyle(frcVariableEndStyle)) {
+          encoder.addPoint(begin.x(), begin.y(), segStyle.getBeginExt(), 0);
+        }
+        if (segStyle.getEndStyle() == frEndStyle(frcExtendEndStyle)) {
+          if (segStyle.getEndExt() != layer->getWidth() / 2)
+            encoder.addPoint(end.x(), end.y(), segStyle.getEndExt(), 0);
+          else
+            encoder.addPoint(end.x(), end.y());
+        } else if (segStyle.getEndStyle()
+                   == frEndStyle(frcTruncateEndStyle)) {
+          encoder.addPoint(end.x(), end.y(), 0, 0);
+        } else if (segStyle.getBeginStyle()
+                   == frEndStyle(frcVariableEndStyle)) {
+          encoder.addPoint(end.x(), end.y(), segStyle.getEndExt(), 0);
         }
+        break;
+      }
+      case frcVia: {
+        auto via = std::dynamic_pointer_cast<frVia>(connFig);
+        auto layerName
+            = getTech()->getLayer(via->getViaDef()->getLayer1Num())->getName();
+        auto viaName = via->getViaDef()->getName();
+        auto layer = db_tech->findLayer(layerName.c_str());
+        if (!net->getNonDefaultRule() || via->isTapered())
+          encoder.newPath(layer, odb::dbWireType("ROUTED"));
+        else
+          encoder.newPath(layer,
+                          odb::dbWireType("ROUTED"),
+                          net->getNonDefaultRule()->getLayerRule(layer));
+        Point origin = via->getOrigin();
+        encoder.addPoint(origin.x(), origin.y());
+        odb::dbTechVia* tech_via = db_tech->findVia(viaName.c_str());
+        if (tech_via != nullptr) {
+          encoder.addTechVia(tech_via);
+        } else {
+          odb::dbVia* db_via = block->findVia(viaName.c_str());
+          encoder.addVia(db_via);
+        }
+        break;
+      }
+      case frcPatchWire: {
+        auto pwire = std::dynamic_pointer_cast<frPatchWire>(connFig);
+        auto layerName = getTech()->getLayer(pwire->getLayerNum())->getName();
+        auto layer = db_tech->findLayer(layerName.c_str());
+        encoder.newPath(layer, odb::dbWireType("ROUTED"));
+        Point origin = pwire->getOrigin();
+        Rect offsetBox = pwire->getOffsetBox();
+        encoder.addPoint(origin.x(), origin.y());
+        encoder.addRect(offsetBox.xMin(),
+                        offsetBox.yMin(),
+                        offsetBox.xMax(),
+                        offsetBox.yMax());
+        break;
+      }
+      default: {
+        encoder.clear();
+        logger_->error(DRT,
+                       114,
+                       "Unknown connFig type while writing net {}.",
+                       net->getName());
       }
-      _wire_encoder.end();
     }
   }
 }
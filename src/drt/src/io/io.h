@@ -31,6 +31,7 @@
 #include <boost/icl/interval_set.hpp>
 #include <list>
 #include <memory>
+#include <set>
 
 #include "frDesign.h"
 
@@ -38,9 +39,12 @@ namespace odb {
 class dbDatabase;
 class dbTechNonDefaultRule;
 class dbBlock;
+class dbInst;
+class dbNet;
 class dbTech;
 class dbSBox;
 class dbTechLayer;
+class dbWireEncoder;
 }  // namespace odb
 namespace utl {
 class Logger;
@@ -71,6 +75,7 @@ class Parser
   void postProcessGuide();
   void initDefaultVias();
   void initRPin();
+  void buildGCellPatterns(odb::dbDatabase* db);
   auto& getTrackOffsetMap() { return trackOffsetMap_; }
   std::vector<frTrackPattern*>& getPrefTrackPatterns()
   {
@@ -84,6 +89,10 @@ class Parser
   void setDieArea(odb::dbBlock*);
   void setTracks(odb::dbBlock*);
   void setInsts(odb::dbBlock*);
+  void setInst(odb::dbInst* inst,
+               frInst* tmpInst,
+               const std::pair<int, int>& firstIds,
+               int grid);
   void setObstructions(odb::dbBlock*);
   void setBTerms(odb::dbBlock*);
   odb::Rect getViaBoxForTermAboveMaxLayer(odb::dbBTerm* term,
@@ -93,6 +102,7 @@ class Parser
                                   frLayerNum finalLayerNum);
   void setVias(odb::dbBlock*);
   void setNets(odb::dbBlock*);
+  std::unique_ptr<frNet> createNet(odb::dbNet* net);
   void setAccessPoints(odb::dbDatabase*);
   void getSBoxCoords(odb::dbSBox*,
                      frCoord&,
@@ -114,7 +124,6 @@ class Parser
   void convertLef58MinCutConstraints();
 
   // postProcess functions
-  void buildGCellPatterns(odb::dbDatabase* db);
   void buildGCellPatterns_helper(frCoord& GCELLGRIDX,
                                  frCoord& GCELLGRIDY,
                                  frCoord& GCELLOFFSETX,
@@ -262,6 +271,8 @@ class Writer
                 bool pin_access = false,
                 bool snapshot = false);
   void updateTrackAssignment(odb::dbBlock* block);
+  // only write the routing of these nets (all nets if empty)
+  void setTargetNets(const std::set<frNet*>& nets) { targetNets_ = nets; }
 
  private:
   void fillViaDefs();
@@ -278,6 +289,10 @@ class Writer
           std::map<frCoord, std::vector<std::shared_ptr<frPathSeg>>>>>&
           mergedPathSegs);
   void updateDbConn(odb::dbBlock* block, odb::dbTech* db_tech, bool snapshot);
+  void encodeConn(odb::dbBlock* block,
+                  odb::dbTech* db_tech,
+                  odb::dbNet* net,
+                  odb::dbWireEncoder& encoder);
   void updateDbVias(odb::dbBlock* block, odb::dbTech* db_tech);
   void updateDbAccessPoints(odb::dbBlock* block, odb::dbTech* db_tech);
 
@@ -287,6 +302,7 @@ class Writer
   std::map<frString, std::list<std::shared_ptr<frConnFig>>>
       connFigs_;  // all connFigs ready to def
   std::vector<frViaDef*> viaDefs_;
+  std::set<frNet*> targetNets_;
 };
 
 }  // namespace fr::io
@@ -83,18 +83,25 @@ void FlexPA::setDebug(frDebugSettings* settings, odb::dbDatabase* db)
 void FlexPA::init()
 {
   ProfileTask profile("PA:init");
-  for (auto& master : design_->getMasters())
-    for (auto& term : master->getTerms())
+  // with target instances the access of the other instances (as read from
+  // the db) stays valid and is kept
+  if (target_insts_.empty()) {
+    for (auto& master : design_->getMasters())
+      for (auto& term : master->getTerms())
+        for (auto& pin : term->getPins())
+          pin->clearPinAccess();
+    for (auto& term : design_->getTopBlock()->getTerms())
       for (auto& pin : term->getPins())
         pin->clearPinAccess();
-  for (auto& term : design_->getTopBlock()->getTerms())
-    for (auto& pin : term->getPins())
-      pin->clearPinAccess();
+  }
   initViaRawPriority();
   initTrackCoords();
 
   initUniqueInstance();
   initPinAccess();
+  if (!PA_CACHE_FILE.empty()) {
+    readCache();
+  }
 }
 
 void FlexPA::applyPatternsFile(const char* file_path)
@@ -113,6 +120,7 @@ void FlexPA::prep()
   ProfileTask profile("PA:prep");
   prepPoint();
   revertAccessPoints();
+  applyCachedAccessPoints();
   if (isDistributed()) {
     std::vector<paUpdate> updates;
     paUpdate update;
@@ -165,6 +173,9 @@ int FlexPA::main()
 
   init();
   prep();
+  if (!PA_CACHE_FILE.empty()) {
+    writeCache();
+  }
 
   int stdCellPinCnt = 0;
   for (auto& inst : getDesign()->getTopBlock()->getInsts()) {
@@ -184,6 +195,9 @@ int FlexPA::main()
   if (VERBOSE > 0) {
     logger_->report("#scanned instances     = {}", inst2unique_.size());
     logger_->report("#unique  instances     = {}", uniqueInstances_.size());
+    if (!PA_CACHE_FILE.empty()) {
+      logger_->report("#cached  instances     = {}", cachedUniqueCnt_);
+    }
     logger_->report("#stdCellGenAp          = {}", stdCellPinGenApCnt_);
     logger_->report("#stdCellValidPlanarAp  = {}", stdCellPinValidPlanarApCnt_);
     logger_->report("#stdCellValidViaAp     = {}", stdCellPinValidViaApCnt_);
@@ -49,6 +49,7 @@ namespace fr {
 typedef std::tuple<bool, frCoord, frCoord, bool, frCoord, frCoord, bool>
     viaRawPriorityTuple;
 class FlexPinAccessPattern;
+class FlexPinAccessCacheEntry;
 class FlexDPNode;
 class FlexPAGraphics;
 
@@ -122,6 +123,12 @@ class FlexPA
       masterOT2Insts;  // master orient track-offset to instances
   frCollection<odb::dbInst*> target_insts_;
 
+  // pin access cache (PA_CACHE_FILE), keyed by the unique instance signature
+  std::map<std::string, std::unique_ptr<FlexPinAccessCacheEntry>> cache_;
+  std::vector<std::string> uniqueCacheKeys_;  // empty if not cacheable
+  std::vector<bool> uniqueCached_;
+  int cachedUniqueCnt_ = 0;
+
   std::string remote_host_;
   ushort remote_port_;
   std::string shared_vol_;
@@ -153,6 +160,15 @@ class FlexPA
   void initTrackCoords();
   void initViaRawPriority();
   void checkFigsOnGrid(const frMPin* pin);
+  // cache
+  std::size_t getCacheRuleHash();
+  std::size_t getCacheMasterHash(frMaster* master);
+  void initCacheKeys();
+  void readCache();
+  void writeCache();
+  bool isCached(int uniqueInstIdx) const;
+  void applyCachedAccessPoints();
+  void applyCachedPatterns();
   // prep
   void prep();
   void prepPoint();
@@ -433,6 +449,24 @@ class FlexPinAccessPattern
   friend class boost::serialization::access;
 };
 
+// Pin access of one unique instance class as stored in the pin access cache.
+// Access points are relative to the instance origin and patterns refer to
+// them by (pin index, access point index), -1 for none.
+class FlexPinAccessCacheEntry
+{
+ public:
+  // one per pin, in instTerm and pin order
+  std::vector<std::unique_ptr<frPinAccess>> pinAccess;
+  // per pattern: the pattern access points followed by the left and right
+  // boundary access points
+  std::vector<std::vector<std::pair<int, int>>> patterns;
+
+ private:
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version);
+  friend class boost::serialization::access;
+};
+
 // dynamic programming related
 class FlexDPNode
 {
@@ -0,0 +1,370 @@
+/* Authors: Lutong Wang and Bangqi Xu */
+/*
+ * Copyright (c) 2019, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/utility.hpp>
+#include <fstream>
+
+#include "FlexPA.h"
+#include "distributed/frArchive.h"
+#include "frProfileTask.h"
+#include "serialization.h"
+
+using namespace std;
+using namespace fr;
+
+// bump when the cache layout or the pin access algorithm changes
+static const int cacheVersion = 1;
+
+static void hashRect(size_t& seed, const Rect& box)
+{
+  boost::hash_combine(seed, box.xMin());
+  boost::hash_combine(seed, box.yMin());
+  boost::hash_combine(seed, box.xMax());
+  boost::hash_combine(seed, box.yMax());
+}
+
+static void hashPinFig(size_t& seed, frPinFig* fig)
+{
+  if (fig->typeId() == frcRect) {
+    auto rect = static_cast<frRect*>(fig);
+    boost::hash_combine(seed, rect->getLayerNum());
+    hashRect(seed, rect->getBBox());
+  } else if (fig->typeId() == frcPolygon) {
+    auto polygon = static_cast<frPolygon*>(fig);
+    boost::hash_combine(seed, polygon->getLayerNum());
+    for (const Point& pt : polygon->getPoints()) {
+      boost::hash_combine(seed, pt.x());
+      boost::hash_combine(seed, pt.y());
+    }
+  }
+}
+
+// Everything besides the master and the track offsets that changes the pin
+// access of a unique instance: the layers, vias and the values of every
+// constraint of the router, preferred tracks and the router settings used
+// by pin access.  Via definitions are serialized by id, so their order is
+// part of the hash.
+size_t FlexPA::getCacheRuleHash()
+{
+  size_t seed = 0;
+  boost::hash_combine(seed, cacheVersion);
+  auto tech = getTech();
+  boost::hash_combine(seed, DBPROCESSNODE);
+  boost::hash_combine(seed, tech->getManufacturingGrid());
+  for (auto& layer : tech->getLayers()) {
+    boost::hash_combine(seed, layer->getName());
+    boost::hash_combine(seed, (int) layer->getType().getValue());
+    boost::hash_combine(seed, (int) layer->getDir().getValue());
+    boost::hash_combine(seed, layer->getWidth());
+    boost::hash_combine(seed, layer->getMinWidth());
+    boost::hash_combine(seed, layer->getPitch());
+    boost::hash_combine(seed, layer->getNumMasks());
+    for (auto cutClass : layer->getCutClasses()) {
+      boost::hash_combine(seed, cutClass->getName());
+      boost::hash_combine(seed, cutClass->getViaWidth());
+      boost::hash_combine(seed, cutClass->getViaLength());
+    }
+  }
+  for (auto& viaDef : tech->getVias()) {
+    boost::hash_combine(seed, viaDef->getName());
+    for (auto figs : {&viaDef->getLayer1Figs(),
+                      &viaDef->getCutFigs(),
+                      &viaDef->getLayer2Figs()}) {
+      for (auto& fig : *figs) {
+        hashPinFig(seed, fig.get());
+      }
+    }
+  }
+  for (auto& constraint : tech->getConstraints()) {
+    boost::hash_combine(seed, (int) constraint->typeId());
+    constraint->hash(seed);
+  }
+  for (auto& ndr : tech->getNondefaultRules()) {
+    boost::hash_combine(seed, ndr->getName());
+    boost::hash_combine(seed, ndr->isHardSpacing());
+    for (auto& layer : tech->getLayers()) {
+      const int z = layer->getLayerNum();
+      boost::hash_combine(seed, ndr->getWidth(z));
+      boost::hash_combine(seed, ndr->getSpacing(z));
+      boost::hash_combine(seed, ndr->getWireExtension(z));
+      boost::hash_combine(seed, ndr->getMinCuts(z));
+    }
+  }
+  vector<frTrackPattern*> prefTrackPatterns;
+  getPrefTrackPatterns(prefTrackPatterns);
+  for (auto tp : prefTrackPatterns) {
+    boost::hash_combine(seed, tp->getLayerNum());
+    boost::hash_combine(seed, tp->isHorizontal());
+    boost::hash_combine(seed, tp->getTrackSpacing());
+  }
+  boost::hash_combine(seed, BOTTOM_ROUTING_LAYER);
+  boost::hash_combine(seed, TOP_ROUTING_LAYER);
+  boost::hash_combine(seed, VIAINPIN_BOTTOMLAYERNUM);
+  boost::hash_combine(seed, VIAINPIN_TOPLAYERNUM);
+  boost::hash_combine(seed, MINNUMACCESSPOINT_STDCELLPIN);
+  boost::hash_combine(seed, MINNUMACCESSPOINT_MACROCELLPIN);
+  boost::hash_combine(seed, ACCESS_PATTERN_END_ITERATION_NUM);
+  boost::hash_combine(seed, USENONPREFTRACKS);
+  boost::hash_combine(seed, AUTO_TAPER_NDR_NETS);
+  boost::hash_combine(seed, ENABLE_VIA_GEN);
+  return seed;
+}
+
+size_t FlexPA::getCacheMasterHash(frMaster* master)
+{
+  size_t seed = 0;
+  hashRect(seed, master->getDieBox());
+  for (auto& term : master->getTerms()) {
+    boost::hash_combine(seed, term->getName());
+    boost::hash_combine(seed, (int) term->getType().getValue());
+    for (auto& pin : term->getPins()) {
+      boost::hash_combine(seed, pin->getFigs().size());
+      for (auto& fig : pin->getFigs()) {
+        hashPinFig(seed, fig.get());
+      }
+    }
+  }
+  for (auto& blockage : master->getBlockages()) {
+    for (auto& fig : blockage->getPin()->getFigs()) {
+      hashPinFig(seed, fig.get());
+    }
+  }
+  return seed;
+}
+
+// The key of a unique instance is its master (name and geometry),
+// orientation, track offsets and which of its terms are routed.  NDR
+// instances are unique by themselves and are not cached.
+void FlexPA::initCacheKeys()
+{
+  uniqueCacheKeys_.assign(uniqueInstances_.size(), "");
+  uniqueCached_.assign(uniqueInstances_.size(), false);
+  for (auto& [master, orientMap] : masterOT2Insts) {
+    const size_t masterHash = getCacheMasterHash(master);
+    for (auto& [orient, offsetMap] : orientMap) {
+      for (auto& [offsets, insts] : offsetMap) {
+        frInst* uniqueInst = *(insts.begin());
+        string key = fmt::format(
+            "{}/{}/{:x}/", master->getName(), orient.getString(), masterHash);
+        for (frCoord offset : offsets) {
+          key += fmt::format("{},", offset);
+        }
+        key += '/';
+        for (auto& instTerm : uniqueInst->getInstTerms()) {
+          key += isSkipInstTerm(instTerm.get()) ? '0' : '1';
+        }
+        uniqueCacheKeys_[unique2Idx_[uniqueInst]] = std::move(key);
+      }
+    }
+  }
+}
+
+bool FlexPA::isCached(int uniqueInstIdx) const
+{
+  return !uniqueCached_.empty() && uniqueCached_[uniqueInstIdx];
+}
+
+void FlexPA::readCache()
+{
+  ProfileTask profile("PA:readCache");
+  initCacheKeys();
+  ifstream file(PA_CACHE_FILE);
+  if (!file.good()) {
+    logger_->info(DRT,
+                  618,
+                  "Pin access cache {} not found, it will be created.",
+                  PA_CACHE_FILE);
+    return;
+  }
+  try {
+    frIArchive ar(file);
+    ar.setDesign(design_);
+    registerTypes(ar);
+    size_t ruleHash = 0;
+    ar >> ruleHash;
+    if (ruleHash != getCacheRuleHash()) {
+      logger_->warn(DRT,
+                    619,
+                    "Pin access cache {} does not match the technology or "
+                    "the router settings and is ignored.",
+                    PA_CACHE_FILE);
+      return;
+    }
+    ar >> cache_;
+  } catch (const std::exception& e) {
+    cache_.clear();
+    logger_->warn(DRT,
+                  620,
+                  "Cannot read pin access cache {}: {}",
+                  PA_CACHE_FILE,
+                  e.what());
+    return;
+  }
+  for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
+    const string& key = uniqueCacheKeys_[i];
+    if (!key.empty() && cache_.find(key) != cache_.end()) {
+      uniqueCached_[i] = true;
+      cachedUniqueCnt_++;
+    }
+  }
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  622,
+                  "Reuse pin access of {} of {} unique instances from {}.",
+                  cachedUniqueCnt_,
+                  uniqueInstances_.size(),
+                  PA_CACHE_FILE);
+  }
+}
+
+// called after revertAccessPoints as the cached points are already relative
+// to the instance origin
+void FlexPA::applyCachedAccessPoints()
+{
+  for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
+    if (!isCached(i)) {
+      continue;
+    }
+    frInst* inst = uniqueInstances_[i];
+    const int paIdx = unique2paidx_[inst];
+    auto& entry = cache_.at(uniqueCacheKeys_[i]);
+    int pinIdx = 0;
+    for (auto& instTerm : inst->getInstTerms()) {
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        auto pinAccess = pin->getPinAccess(paIdx);
+        for (auto& ap : entry->pinAccess.at(pinIdx)->getAccessPoints()) {
+          pinAccess->addAccessPoint(make_unique<frAccessPoint>(*ap));
+        }
+        pinIdx++;
+      }
+    }
+  }
+}
+
+void FlexPA::applyCachedPatterns()
+{
+  for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
+    if (!isCached(i)) {
+      continue;
+    }
+    frInst* inst = uniqueInstances_[i];
+    const int paIdx = unique2paidx_[inst];
+    vector<frPinAccess*> pinAccess;
+    for (auto& instTerm : inst->getInstTerms()) {
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        pinAccess.push_back(pin->getPinAccess(paIdx));
+      }
+    }
+    auto getAccessPoint = [&pinAccess](const pair<int, int>& idx) {
+      return idx.first < 0
+                 ? nullptr
+                 : pinAccess.at(idx.first)->getAccessPoint(idx.second);
+    };
+    auto& entry = cache_.at(uniqueCacheKeys_[i]);
+    for (auto& aps : entry->patterns) {
+      auto pattern = make_unique<FlexPinAccessPattern>();
+      for (int j = 0; j < (int) aps.size() - 2; j++) {
+        pattern->addAccessPoint(getAccessPoint(aps[j]));
+      }
+      pattern->setBoundaryAP(true, getAccessPoint(aps[aps.size() - 2]));
+      pattern->setBoundaryAP(false, getAccessPoint(aps.back()));
+      pattern->updateCost();
+      uniqueInstPatterns_[i].push_back(std::move(pattern));
+    }
+  }
+}
+
+// Entries that were not used by this design are kept so one cache can serve
+// several designs sharing a library.
+void FlexPA::writeCache()
+{
+  ProfileTask profile("PA:writeCache");
+  for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
+    const string& key = uniqueCacheKeys_[i];
+    if (key.empty() || isCached(i)) {
+      continue;
+    }
+    frInst* inst = uniqueInstances_[i];
+    const int paIdx = unique2paidx_[inst];
+    auto entry = make_unique<FlexPinAccessCacheEntry>();
+    map<frPinAccess*, int> pinIdx;
+    for (auto& instTerm : inst->getInstTerms()) {
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        auto pinAccess = pin->getPinAccess(paIdx);
+        pinIdx[pinAccess] = entry->pinAccess.size();
+        entry->pinAccess.push_back(make_unique<frPinAccess>(*pinAccess));
+      }
+    }
+    auto getIdx = [&pinIdx](frAccessPoint* ap) -> pair<int, int> {
+      if (ap == nullptr) {
+        return {-1, -1};
+      }
+      return {pinIdx.at(ap->getPinAccess()), ap->getId()};
+    };
+    for (auto& pattern : uniqueInstPatterns_[i]) {
+      vector<pair<int, int>> aps;
+      for (auto ap : pattern->getPattern()) {
+        aps.push_back(getIdx(ap));
+      }
+      aps.push_back(getIdx(pattern->getBoundaryAP(true)));
+      aps.push_back(getIdx(pattern->getBoundaryAP(false)));
+      entry->patterns.push_back(std::move(aps));
+    }
+    cache_[key] = std::move(entry);
+  }
+
+  ofstream file(PA_CACHE_FILE);
+  if (!file.good()) {
+    logger_->warn(DRT, 621, "Cannot write pin access cache {}.", PA_CACHE_FILE);
+    return;
+  }
+  frOArchive ar(file);
+  registerTypes(ar);
+  const size_t ruleHash = getCacheRuleHash();
+  ar << ruleHash;
+  ar << cache_;
+  file.close();
+}
+
+template <class Archive>
+void FlexPinAccessCacheEntry::serialize(Archive& ar,
+                                        const unsigned int version)
+{
+  (ar) & pinAccess;
+  (ar) & patterns;
+}
+
+template void FlexPinAccessCacheEntry::serialize<frIArchive>(
+    frIArchive& ar,
+    const unsigned int file_version);
+
+template void FlexPinAccessCacheEntry::serialize<frOArchive>(
+    frOArchive& ar,
+    const unsigned int file_version);
@@ -252,15 +252,23 @@ void FlexPA::checkFigsOnGrid(const frMPin* pin)
 void FlexPA::initPinAccess()
 {
   for (auto& inst : uniqueInstances_) {
+    // pins keep the access read from the db in the target mode and a master
+    // may have a different number of pin accesses per pin; align them
+    // before appending the new one
+    int paIdx = 0;
     for (auto& instTerm : inst->getInstTerms()) {
       for (auto& pin : instTerm->getTerm()->getPins()) {
-        if (unique2paidx_.find(inst) == unique2paidx_.end()) {
-          unique2paidx_[inst] = pin->getNumPinAccess();
-        } else {
-          if (unique2paidx_[inst] != pin->getNumPinAccess()) {
-            logger_->error(DRT, 69, "initPinAccess error.");
-            exit(1);
-          }
+        paIdx = std::max(paIdx, pin->getNumPinAccess());
+      }
+    }
+    unique2paidx_[inst] = paIdx;
+    for (auto& instTerm : inst->getInstTerms()) {
+      for (auto& pin : instTerm->getTerm()->getPins()) {
+        if (pin->getNumPinAccess() != paIdx && target_insts_.empty()) {
+          logger_->error(DRT, 69, "initPinAccess error.");
+        }
+        while (pin->getNumPinAccess() < paIdx) {
+          pin->addPinAccess(make_unique<frPinAccess>());
         }
         checkFigsOnGrid(pin.get());
         auto pa = make_unique<frPinAccess>();
@@ -1442,6 +1442,9 @@ void FlexPA::prepPoint()
 #pragma omp parallel for schedule(dynamic)
   for (int i = 0; i < (int) uniqueInstances_.size(); i++) {
     try {
+      if (isCached(i)) {
+        continue;
+      }
       auto& inst = uniqueInstances_[i];
       // only do for core and block cells
       dbMasterType masterType = inst->getMaster()->getMasterType();
@@ -1653,6 +1656,9 @@ void FlexPA::prepPattern()
        currUniqueInstIdx < (int) uniqueInstances_.size();
        currUniqueInstIdx++) {
     try {
+      if (isCached(currUniqueInstIdx)) {
+        continue;
+      }
       auto& inst = uniqueInstances_[currUniqueInstIdx];
       // only do for core and block cells
       // TODO the above comment says "block cells" but that's not what the code
@@ -1702,6 +1708,7 @@ void FlexPA::prepPattern()
     }
   }
   exception.rethrow();
+  applyCachedPatterns();
   if (VERBOSE > 0) {
     logger_->info(DRT, 81, "  Complete {} unique inst patterns.", cnt);
   }
@@ -756,7 +756,6 @@ void serializeGlobals(Archive& ar)
   (ar) & OR_K;
   (ar) & MAX_THREADS;
   (ar) & BATCHSIZE;
-  (ar) & BATCHSIZETA;
   (ar) & MTSAFEDIST;
   (ar) & DRCSAFEDIST;
   (ar) & VERBOSE;
@@ -792,6 +791,7 @@ void serializeGlobals(Archive& ar)
   (ar) & TASHAPEBLOATWIDTH;
   (ar) & VIACOST;
   (ar) & GRIDCOST;
+  (ar) & MAZE_HEURISTIC_WEIGHT;
   (ar) & ROUTESHAPECOST;
   (ar) & MARKERCOST;
   (ar) & MARKERBLOATWIDTH;
@@ -120,7 +120,13 @@ int FlexTA::initTA_helper(int iter,
   auto& ygp = gCellPatterns.at(1);
   int sol = 0;
   numPanels = 0;
-  vector<vector<unique_ptr<FlexTAWorker>>> workers;
+  // A panel's extBox only reaches into its direct neighbors, so the panels
+  // are colored by index and the panels of one color are independent.  Each
+  // color runs with all the threads and sees the commits of the previous
+  // colors; the result does not depend on the thread count.
+  const int numColors = size > 1 ? 2 : 3;
+  vector<vector<unique_ptr<FlexTAWorker>>> workers(numColors);
+  int panelIdx = 0;
   if (isH) {
     for (int i = offset; i < (int) ygp.getCount(); i += size) {
       auto uworker
@@ -138,10 +144,10 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::HORIZONTAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.push_back(vector<unique_ptr<FlexTAWorker>>());
+      if (!targetNets_.empty()) {
+        worker.setTargetNets(&targetNets_);
       }
-      workers.back().push_back(std::move(uworker));
+      workers[panelIdx++ % numColors].push_back(std::move(uworker));
     }
   } else {
     for (int i = offset; i < (int) xgp.getCount(); i += size) {
@@ -160,18 +166,18 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::VERTICAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.push_back(vector<unique_ptr<FlexTAWorker>>());
+      if (!targetNets_.empty()) {
+        worker.setTargetNets(&targetNets_);
       }
-      workers.back().push_back(std::move(uworker));
+      workers[panelIdx++ % numColors].push_back(std::move(uworker));
     }
   }
 
-  omp_set_num_threads(min(8, MAX_THREADS));
+  omp_set_num_threads(MAX_THREADS);
   // parallel execution
   // multi thread
   for (auto& workerBatch : workers) {
-    ProfileTask profile("TA:batch");
+    ProfileTask profile("TA:color");
     ThreadException exception;
 #pragma omp parallel for schedule(dynamic)
     for (int i = 0; i < (int) workerBatch.size(); i++) {
@@ -50,12 +50,15 @@ class FlexTA
   // others
   int main();
   void setDebug(frDebugSettings* settings, odb::dbDatabase* db);
+  // only assign the guides of these nets (all nets if empty)
+  void setTargetNets(const std::set<frNet*>& nets) { targetNets_ = nets; }
 
  private:
   frTechObject* tech_;
   frDesign* design_;
   Logger* logger_;
   bool save_updates_;
+  std::set<frNet*> targetNets_;
   std::unique_ptr<FlexTAGraphics> graphics_;
   // others
   void main_helper(frLayerNum lNum, int maxOffsetIter, int panelWidth);
@@ -110,6 +113,7 @@ class FlexTAWorker
         save_updates_(save_updates),
         dir_(dbTechLayerDir::NONE),
         taIter_(0),
+        targetNets_(nullptr),
         rq_(this),
         numAssigned_(0),
         totCost_(0),
@@ -120,6 +124,7 @@ class FlexTAWorker
   void setExtBox(const Rect& boxIn) { extBox_ = boxIn; }
   void setDir(dbTechLayerDir in) { dir_ = in; }
   void setTAIter(int in) { taIter_ = in; }
+  void setTargetNets(const std::set<frNet*>* in) { targetNets_ = in; }
   void addIroute(std::unique_ptr<taPin> in, bool isExt = false)
   {
     in->setId(iroutes_.size() + extIroutes_.size());
@@ -188,6 +193,7 @@ class FlexTAWorker
   Rect extBox_;
   dbTechLayerDir dir_;
   int taIter_;
+  const std::set<frNet*>* targetNets_;
   FlexTAWorkerRegionQuery rq_;
 
   std::vector<std::unique_ptr<taPin>> iroutes_;  // unsorted iroutes
@@ -541,6 +541,9 @@ void FlexTAWorker::initIroutes()
     result.clear();
     regionQuery->queryGuide(getExtBox(), lNum, result);
     for (auto& [boostb, guide] : result) {
+      if (targetNets_ && targetNets_->count(guide->getNet()) == 0) {
+        continue;
+      }
       initIroute(guide);
     }
   }
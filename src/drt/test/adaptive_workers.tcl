@@ -0,0 +1,32 @@
+# detailed_route -adaptive_workers cuts the clips much busier than the
+# average in two halves along each axis, each at least two gcells wide.
+source "helpers.tcl"
+source "drt_helpers.tcl"
+run_with_threads adaptive_workers 4
+
+set subclips {}
+set stream [open [make_result_file adaptive_workers_threads_4.log] r]
+while { [gets $stream line] >= 0 } {
+  if { ![regexp {subclip (\d+) (\d+) (\d+) (\d+) of clip (.*)$} $line \
+          -> lo_x lo_y hi_x hi_y clip] } {
+    continue
+  }
+  lassign $clip x y max_x max_y
+  # an axis is either left whole or cut in halves of two gcells or more
+  if { ($hi_x - $lo_x < 1 && ($lo_x != $x || $hi_x != $max_x))
+       || ($hi_y - $lo_y < 1 && ($lo_y != $y || $hi_y != $max_y)) } {
+    error "subclip $lo_x $lo_y $hi_x $hi_y of clip $clip is too narrow"
+  }
+  dict incr subclips $clip
+}
+close $stream
+
+if { [dict size $subclips] == 0 } {
+  error "no clip was split"
+}
+dict for { clip count } $subclips {
+  if { $count > 4 } {
+    error "clip $clip was split into $count subclips"
+  }
+}
+puts "pass"
@@ -0,0 +1,54 @@
+# check_drc -boxes reports a violation crossing tile borders once even when
+# the tile holding its lower left corner is not checked.
+source "helpers.tcl"
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+
+# short two nets with the same long metal2 wire across the die
+set block [ord::get_db_block]
+set layer [[ord::get_db_tech] findLayer metal2]
+set shorted {}
+foreach net [$block getNets] {
+  if { [$net isSpecial] || [llength $shorted] == 2 } {
+    continue
+  }
+  set wire [odb::dbWire_create $net]
+  set encoder [odb::dbWireEncoder]
+  $encoder begin $wire
+  $encoder newPath $layer "ROUTED"
+  $encoder addPoint 20000 100800
+  $encoder addPoint 180000 100800
+  $encoder end
+  lappend shorted [$net getName]
+}
+lassign $shorted net1 net2
+
+proc count_shorts { file net1 net2 } {
+  set count 0
+  set stream [open $file r]
+  while { [gets $stream line] >= 0 } {
+    if { [string first "srcs:" $line] != -1
+         && [string first "net:$net1 " $line] != -1
+         && [string first "net:$net2 " $line] != -1 } {
+      incr count
+    }
+  }
+  close $stream
+  return $count
+}
+
+set full_file [make_result_file check_drc_boxes_full.rpt]
+check_drc -output_file $full_file
+if { [count_shorts $full_file $net1 $net2] != 1 } {
+  error "the short is not reported once by the full check"
+}
+
+# only the right end of the short, far from its lower left corner
+set boxes_file [make_result_file check_drc_boxes.rpt]
+check_drc -boxes {{178000 100000 180000 101600}} -output_file $boxes_file
+if { [count_shorts $boxes_file $net1 $net2] != 1 } {
+  error "the short is not reported once by the check of the box"
+}
+
+puts "pass"
@@ -0,0 +1,10 @@
+# The wires written back to the db by detailed routing are the same with
+# one thread and with several.
+source "helpers.tcl"
+source "drt_helpers.tcl"
+set def1 [run_with_threads detailed_route 1]
+set def4 [run_with_threads detailed_route 4]
+if { [diff_files $def1 $def4] } {
+  error "routing with 4 threads differs from routing with 1 thread"
+}
+puts "pass"
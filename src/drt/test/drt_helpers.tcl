@@ -0,0 +1,21 @@
+# Helpers for the drt tests that compare runs with different thread counts.
+
+# Runs step of threads_helper.tcl in a new openroad process with the given
+# thread count and returns the file it writes.
+proc run_with_threads { step threads } {
+  global argv0
+  set ::env(DRT_TEST_STEP) $step
+  set ::env(DRT_TEST_THREADS) $threads
+  set result [make_result_file "${step}_threads_$threads.result"]
+  set ::env(DRT_TEST_RESULT) $result
+  set log [make_result_file "${step}_threads_$threads.log"]
+  exec $argv0 -no_init -exit threads_helper.tcl >& $log
+  return $result
+}
+
+proc read_bytes { file } {
+  set stream [open $file rb]
+  set bytes [read $stream]
+  close $stream
+  return $bytes
+}
@@ -0,0 +1,37 @@
+# detailed_route -incremental does nothing without changes since the last
+# routing and reroutes the nets of a moved instance.
+source "helpers.tcl"
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+read_guides gcd_nangate45.route_guide
+detailed_route
+
+# the report is only written by a routing run
+set drc_file [make_result_file incremental_route.drc.rpt]
+file delete $drc_file
+detailed_route -incremental -output_drc $drc_file
+if { [file exists $drc_file] } {
+  error "incremental routing ran without design changes"
+}
+
+set block [ord::get_db_block]
+foreach inst [$block getInsts] {
+  if { [[$inst getMaster] getType] == "CORE" } {
+    break
+  }
+}
+lassign [$inst getLocation] x y
+$inst setLocation [expr $x + 380] $y
+detailed_route -incremental -output_drc $drc_file
+if { ![file exists $drc_file] } {
+  error "incremental routing ignored the moved instance"
+}
+foreach iterm [$inst getITerms] {
+  set net [$iterm getNet]
+  if { $net != "NULL" && ![$net isSpecial] && [$net getWire] == "NULL" } {
+    error "net [$net getName] of the moved instance is not routed"
+  }
+}
+
+puts "pass"
@@ -0,0 +1,29 @@
+# The pin access cache is reused as long as the technology does not change
+# and is dropped when a rule does.
+source "helpers.tcl"
+source "drt_helpers.tcl"
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+
+set cache_file [make_result_file pin_access_cache_rules.cache]
+file delete $cache_file
+
+pin_access -pin_access_cache $cache_file
+set cache [read_bytes $cache_file]
+
+pin_access -pin_access_cache $cache_file
+if { [read_bytes $cache_file] != $cache } {
+  error "the cache changed without a change of the technology"
+}
+
+set layer [[ord::get_db_tech] findLayer metal1]
+foreach rule [$layer getV54SpacingRules] {
+  $rule setSpacing [expr [$rule getSpacing] + 10]
+}
+pin_access -pin_access_cache $cache_file
+if { [read_bytes $cache_file] == $cache } {
+  error "the cache was reused after a rule changed"
+}
+
+puts "pass"
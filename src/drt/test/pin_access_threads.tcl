@@ -0,0 +1,10 @@
+# The design read by the router and its pin access are the same with one
+# thread and with several.
+source "helpers.tcl"
+source "drt_helpers.tcl"
+set result1 [run_with_threads pin_access 1]
+set result4 [run_with_threads pin_access 4]
+if { [read_bytes $result1] != [read_bytes $result4] } {
+  error "pin access with 4 threads differs from pin access with 1 thread"
+}
+puts "pass"
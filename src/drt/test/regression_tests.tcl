@@ -9,5 +9,11 @@ record_tests {
   top_level_term2
 }
 record_pass_fail_tests {
+  adaptive_workers
+  check_drc_boxes
+  detailed_route_threads
   gc_test
+  incremental_route
+  pin_access_cache_rules
+  pin_access_threads
 }
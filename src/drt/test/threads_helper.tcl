@@ -0,0 +1,35 @@
+# Runs one step of the flow on gcd in its own process with the thread
+# count chosen by the calling test, see run_with_threads in drt_helpers.tcl.
+source "helpers.tcl"
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+set_thread_count $::env(DRT_TEST_THREADS)
+set step $::env(DRT_TEST_STEP)
+set result $::env(DRT_TEST_RESULT)
+if { $step == "adaptive_workers" } {
+  # Empty space around the core makes the mean clip load small, so the
+  # clips holding the cells are much busier than the average.
+  set block [ord::get_db_block]
+  set die [odb::Rect]
+  $die init 0 0 600000 600000
+  $block setDieArea $die
+  foreach grid [$block getTrackGrids] {
+    odb::dbTrackGrid_destroy $grid
+  }
+  make_tracks
+}
+read_guides gcd_nangate45.route_guide
+if { $step == "pin_access" } {
+  pin_access
+  write_db $result
+} elseif { $step == "detailed_route" } {
+  detailed_route
+  write_def $result
+} elseif { $step == "adaptive_workers" } {
+  set_debug_level DRT adaptive_workers 1
+  detailed_route -adaptive_workers -droute_end_iter 2
+  write_def $result
+} else {
+  error "unknown step $step"
+}
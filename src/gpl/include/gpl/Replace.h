@@ -115,6 +115,10 @@ class Replace
   void setPadRight(int padding);
 
   void setForceCPU(bool force_cpu);
+  void setInitialPlaceParallelSolver(bool mode);
+  void setNumThreads(int threads);
+  void setIncrementalDensityMode(bool mode);
+  void setDensityResolveThreshold(float threshold);
   void setTimingDrivenMode(bool mode);
 
   void setSkipIoMode(bool mode);
@@ -132,8 +136,13 @@ class Replace
 
   void setRoutabilityRcCoefficients(float k1, float k2, float k3, float k4);
 
+  void setRoutabilityUseRudy(bool mode);
+  void setRoutabilityRudyCalibrationInterval(int interval);
+
   void addTimingNetWeightOverflow(int overflow);
   void setTimingNetWeightMax(float max);
+  void setTimingDrivenIncrementalMode(bool mode);
+  void setTimingDrivenMoveThreshold(int threshold);
 
   void setDebug(int pause_iterations,
                 int update_iterations,
@@ -165,6 +174,10 @@ class Replace
   int initialPlaceMaxFanout_;
   float initialPlaceNetWeightScale_;
   bool forceCPU_;
+  bool initialPlaceParallelSolver_;
+  int numThreads_;
+  bool incrementalDensityMode_;
+  float densityResolveThreshold_;
 
   int total_placeable_insts_;
 
@@ -191,7 +204,14 @@ class Replace
   int routabilityMaxBloatIter_;
   int routabilityMaxInflationIter_;
 
+  // RUDY congestion estimate between global router calls
+  bool routabilityUseRudy_;
+  int routabilityRudyCalibrationInterval_;
+
   float timingNetWeightMax_;
+  // only re-estimate nets that moved more than the threshold (DBU)
+  bool timingDrivenIncrementalMode_;
+  int timingDrivenMoveThreshold_;
 
   bool timingDrivenMode_;
   bool routabilityDrivenMode_;
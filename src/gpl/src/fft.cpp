@@ -33,7 +33,11 @@
 
 #include "fft.h"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <cfloat>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -42,25 +46,163 @@
 
 namespace gpl {
 
+////////////////////////////////////////////////
+// OouraDctBackend
+
+OouraDctBackend::OouraDctBackend(int binCntX, int binCntY)
+    : binCntX_(binCntX), binCntY_(binCntY)
+{
+  csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
+  workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
+  colBuffer_.resize(4 * binCntX_, 0);
+}
+
+void OouraDctBackend::ddct2d(int isgn, float** a)
+{
+  gpl::ddct2d(binCntX_,
+              binCntY_,
+              isgn,
+              a,
+              colBuffer_.data(),
+              workArea_.data(),
+              csTable_.data());
+}
+
+void OouraDctBackend::ddsct2d(int isgn, float** a)
+{
+  gpl::ddsct2d(binCntX_,
+               binCntY_,
+               isgn,
+               a,
+               colBuffer_.data(),
+               workArea_.data(),
+               csTable_.data());
+}
+
+void OouraDctBackend::ddcst2d(int isgn, float** a)
+{
+  gpl::ddcst2d(binCntX_,
+               binCntY_,
+               isgn,
+               a,
+               colBuffer_.data(),
+               workArea_.data(),
+               csTable_.data());
+}
+
+////////////////////////////////////////////////
+// ParallelDctBackend
+
+ParallelDctBackend::ParallelDctBackend(int binCntX,
+                                       int binCntY,
+                                       int numThreads)
+    : binCntX_(binCntX), binCntY_(binCntY), numThreads_(numThreads)
+{
+  const int n = std::max(binCntX_, binCntY_);
+  csTable_.resize(n * 3 / 2, 0);
+  workArea_.resize(round(sqrt(n)) + 2, 0);
+
+  // Same tables the Ooura 2D routines build on their first call.
+  // The 1D routines only read them afterwards, so they can be
+  // shared by all threads.
+  const int nw = n >> 2;
+  makewt(nw, workArea_.data(), csTable_.data());
+  if (n > workArea_[1]) {
+    makect(n, workArea_.data(), csTable_.data() + nw);
+  }
+
+  colBuffers_.resize(numThreads_);
+  for (auto& buffer : colBuffers_) {
+    buffer.resize(colBlock_ * binCntX_, 0);
+  }
+}
+
+void ParallelDctBackend::ddct2d(int isgn, float** a)
+{
+  transform2d(isgn, a, ddct, ddct);
+}
+
+void ParallelDctBackend::ddsct2d(int isgn, float** a)
+{
+  transform2d(isgn, a, ddct, ddst);
+}
+
+void ParallelDctBackend::ddcst2d(int isgn, float** a)
+{
+  transform2d(isgn, a, ddst, ddct);
+}
+
+void ParallelDctBackend::transform2d(int isgn,
+                                     float** a,
+                                     Dct1d yTransform,
+                                     Dct1d xTransform)
+{
+  int* ip = workArea_.data();
+  float* w = csTable_.data();
+
+#pragma omp parallel for num_threads(numThreads_)
+  for (int x = 0; x < binCntX_; x++) {
+    yTransform(binCntY_, isgn, a[x], ip, w);
+  }
+
+  // matches ddxt2d_sub, which leaves single-column grids alone
+  if (binCntY_ < 2) {
+    return;
+  }
+
+  // columns are copied out in blocks so the reads stay row-contiguous
+#pragma omp parallel for num_threads(numThreads_)
+  for (int y0 = 0; y0 < binCntY_; y0 += colBlock_) {
+    float* t = colBuffers_[omp_get_thread_num()].data();
+    const int cols = std::min(colBlock_, binCntY_ - y0);
+
+    for (int x = 0; x < binCntX_; x++) {
+      for (int c = 0; c < cols; c++) {
+        t[c * binCntX_ + x] = a[x][y0 + c];
+      }
+    }
+    for (int c = 0; c < cols; c++) {
+      xTransform(binCntX_, isgn, &t[c * binCntX_], ip, w);
+    }
+    for (int x = 0; x < binCntX_; x++) {
+      for (int c = 0; c < cols; c++) {
+        a[x][y0 + c] = t[c * binCntX_ + x];
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////
+// FFT
+
 FFT::FFT()
     : binDensity_(nullptr),
       electroPhi_(nullptr),
       electroForceX_(nullptr),
       electroForceY_(nullptr),
+      backendType_(DctBackendType::Ooura),
       binCntX_(0),
       binCntY_(0),
       binSizeX_(0),
-      binSizeY_(0)
+      binSizeY_(0),
+      numThreads_(1)
 {
 }
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
+FFT::FFT(int binCntX,
+         int binCntY,
+         int binSizeX,
+         int binSizeY,
+         int numThreads,
+         DctBackendType backendType)
     : binCntX_(binCntX),
       binCntY_(binCntY),
       binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+      binSizeY_(binSizeY),
+      numThreads_(std::max(numThreads, 1))
 {
   init();
+  initBackend(backendType);
 }
 
 FFT::~FFT()
@@ -77,13 +219,10 @@ FFT::~FFT()
   delete[] electroForceX_;
   delete[] electroForceY_;
 
-  csTable_.clear();
   wx_.clear();
   wxSquare_.clear();
   wy_.clear();
   wySquare_.clear();
-
-  workArea_.clear();
 }
 
 void FFT::init()
@@ -105,15 +244,11 @@ void FFT::init()
     }
   }
 
-  csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
-
   wx_.resize(binCntX_, 0);
   wxSquare_.resize(binCntX_, 0);
   wy_.resize(binCntY_, 0);
   wySquare_.resize(binCntY_, 0);
 
-  workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
-
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -128,6 +263,55 @@ void FFT::init()
   }
 }
 
+void FFT::initBackend(DctBackendType backendType)
+{
+  if (backendType == DctBackendType::Auto && numThreads_ == 1) {
+    backendType = DctBackendType::Ooura;
+  }
+
+  if (backendType == DctBackendType::Ooura) {
+    backend_ = std::make_unique<OouraDctBackend>(binCntX_, binCntY_);
+  } else if (backendType == DctBackendType::Parallel) {
+    backend_
+        = std::make_unique<ParallelDctBackend>(binCntX_, binCntY_, numThreads_);
+  } else {
+    // Planner: time a forward/inverse pair on each backend and keep
+    // the faster one.  Both give identical results, so the choice
+    // only affects runtime.
+    std::vector<std::unique_ptr<DctBackend>> candidates;
+    candidates.push_back(std::make_unique<OouraDctBackend>(binCntX_, binCntY_));
+    candidates.push_back(std::make_unique<ParallelDctBackend>(
+        binCntX_, binCntY_, numThreads_));
+
+    std::vector<float> scratch(binCntX_ * static_cast<size_t>(binCntY_), 0);
+    std::vector<float*> rows(binCntX_);
+    for (int i = 0; i < binCntX_; i++) {
+      rows[i] = &scratch[i * static_cast<size_t>(binCntY_)];
+    }
+
+    std::chrono::duration<double> bestTime
+        = std::chrono::duration<double>::max();
+    int bestIdx = 0;
+    for (size_t idx = 0; idx < candidates.size(); idx++) {
+      const auto start = std::chrono::steady_clock::now();
+      candidates[idx]->ddct2d(-1, rows.data());
+      candidates[idx]->ddct2d(1, rows.data());
+      const std::chrono::duration<double> elapsed
+          = std::chrono::steady_clock::now() - start;
+      if (elapsed < bestTime) {
+        bestTime = elapsed;
+        bestIdx = idx;
+      }
+    }
+
+    backendType = (bestIdx == 0) ? DctBackendType::Ooura
+                                 : DctBackendType::Parallel;
+    backend_ = std::move(candidates[bestIdx]);
+  }
+
+  backendType_ = backendType;
+}
+
 void FFT::updateDensity(int x, int y, float density)
 {
   binDensity_[x][y] = density;
@@ -147,13 +331,7 @@ using namespace std;
 
 void FFT::doFFT()
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         NULL,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  backend_->ddct2d(-1, binDensity_);
 
   for (int i = 0; i < binCntX_; i++) {
     binDensity_[i][0] *= 0.5;
@@ -163,12 +341,14 @@ void FFT::doFFT()
     binDensity_[0][i] *= 0.5;
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     for (int j = 0; j < binCntY_; j++) {
       binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
     }
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     float wx = wx_[i];
     float wx2 = wxSquare_[i];
@@ -205,27 +385,9 @@ void FFT::doFFT()
     }
   }
   // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         NULL,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          NULL,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          NULL,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  backend_->ddct2d(1, electroPhi_);
+  backend_->ddsct2d(1, electroForceX_);
+  backend_->ddcst2d(1, electroForceY_);
 }
 
 }  // namespace gpl
@@ -33,15 +33,102 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 namespace gpl {
 
+// 2D DCT/DST kernels on a binCntX x binCntY grid stored as a[x][y].
+// isgn follows the Ooura convention (-1: forward, 1: inverse).
+// Every backend uses the same 1D Ooura routines and twiddle tables,
+// so all of them give bit-identical results.
+class DctBackend
+{
+ public:
+  virtual ~DctBackend() = default;
+
+  // cos transform on both dimensions
+  virtual void ddct2d(int isgn, float** a) = 0;
+  // cos transform along y, sin transform along x
+  virtual void ddsct2d(int isgn, float** a) = 0;
+  // sin transform along y, cos transform along x
+  virtual void ddcst2d(int isgn, float** a) = 0;
+};
+
+// Reference backend: the single-threaded Ooura 2D routines.
+class OouraDctBackend : public DctBackend
+{
+ public:
+  OouraDctBackend(int binCntX, int binCntY);
+
+  void ddct2d(int isgn, float** a) override;
+  void ddsct2d(int isgn, float** a) override;
+  void ddcst2d(int isgn, float** a) override;
+
+ private:
+  int binCntX_;
+  int binCntY_;
+
+  // cos/sin table (prev: w_2d)
+  // length:  max(binCntX, binCntY) * 3 / 2
+  std::vector<float> csTable_;
+
+  // work area for bit reversal (prev: ip)
+  // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
+  std::vector<int> workArea_;
+
+  // column scratch buffer; cached instead of allocated on every call
+  std::vector<float> colBuffer_;
+};
+
+// Row/column decomposition with the rows and the column blocks
+// spread over OpenMP threads.
+class ParallelDctBackend : public DctBackend
+{
+ public:
+  ParallelDctBackend(int binCntX, int binCntY, int numThreads);
+
+  void ddct2d(int isgn, float** a) override;
+  void ddsct2d(int isgn, float** a) override;
+  void ddcst2d(int isgn, float** a) override;
+
+ private:
+  using Dct1d = void (*)(int n, int isgn, float* a, int* ip, float* w);
+
+  // yTransform runs on every a[x], xTransform on every column a[*][y]
+  void transform2d(int isgn, float** a, Dct1d yTransform, Dct1d xTransform);
+
+  int binCntX_;
+  int binCntY_;
+  int numThreads_;
+
+  // twiddle tables; built once in the constructor and read-only after
+  std::vector<float> csTable_;
+  std::vector<int> workArea_;
+
+  // per-thread column buffers, each holding colBlock_ columns
+  static constexpr int colBlock_ = 4;
+  std::vector<std::vector<float>> colBuffers_;
+};
+
+enum class DctBackendType
+{
+  Ooura,
+  Parallel,
+  // time both backends once and keep the faster one
+  Auto
+};
+
 class FFT
 {
  public:
   FFT();
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
+  FFT(int binCntX,
+      int binCntY,
+      int binSizeX,
+      int binSizeY,
+      int numThreads = 1,
+      DctBackendType backendType = DctBackendType::Auto);
   ~FFT();
 
   // input func
@@ -54,6 +141,8 @@ class FFT
   std::pair<float, float> getElectroForce(int x, int y) const;
   float getElectroPhi(int x, int y) const;
 
+  DctBackendType backendType() const { return backendType_; }
+
  private:
   // 2D array; width: binCntX_, height: binCntY_;
   // No hope to use Vector at this moment...
@@ -62,9 +151,8 @@ class FFT
   float** electroForceX_;
   float** electroForceY_;
 
-  // cos/sin table (prev: w_2d)
-  // length:  max(binCntX, binCntY) * 3 / 2
-  std::vector<float> csTable_;
+  std::unique_ptr<DctBackend> backend_;
+  DctBackendType backendType_;
 
   // wx. length:  binCntX_
   std::vector<float> wx_;
@@ -74,16 +162,14 @@ class FFT
   std::vector<float> wy_;
   std::vector<float> wySquare_;
 
-  // work area for bit reversal (prev: ip)
-  // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
-  std::vector<int> workArea_;
-
   int binCntX_;
   int binCntY_;
   int binSizeX_;
   int binSizeY_;
+  int numThreads_;
 
   void init();
+  void initBackend(DctBackendType backendType);
 };
 
 //
@@ -92,6 +178,8 @@ class FFT
 //
 //
 /// 1D FFT ////////////////////////////////////////////////////////////////
+void makewt(int nw, int* ip, float* w);
+void makect(int nc, int* ip, float* c);
 void cdft(int n, int isgn, float* a, int* ip, float* w);
 void ddct(int n, int isgn, float* a, int* ip, float* w);
 void ddst(int n, int isgn, float* a, int* ip, float* w);
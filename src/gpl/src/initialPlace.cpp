@@ -57,6 +57,8 @@ void InitialPlaceVars::reset()
   netWeightScale = 800.0;
   debug = false;
   forceCPU = false;
+  parallelSolver = false;
+  numThreads = 1;
 }
 
 InitialPlace::InitialPlace() : pbc_(nullptr), log_(nullptr)
@@ -80,6 +82,11 @@ void InitialPlace::reset()
 {
   pbc_ = nullptr;
   ipVars_.reset();
+
+  placeInstForceListX_.clear();
+  placeInstForceListY_.clear();
+  placeInstForceListX_.shrink_to_fit();
+  placeInstForceListY_.shrink_to_fit();
 }
 
 void InitialPlace::doBicgstabPlace()
@@ -123,15 +130,28 @@ void InitialPlace::doBicgstabPlace()
     if (run_cpu) {
       if (ipVars_.forceCPU)
         log_->warn(GPL, 251, "CPU solver is forced to be used.");
-      error = cpuSparseSolve(ipVars_.maxSolverIter,
-                             iter,
-                             placeInstForceMatrixX_,
-                             fixedInstForceVecX_,
-                             instLocVecX_,
-                             placeInstForceMatrixY_,
-                             fixedInstForceVecY_,
-                             instLocVecY_,
-                             log_);
+      if (ipVars_.parallelSolver) {
+        error = cpuParallelSparseSolve(ipVars_.maxSolverIter,
+                                       iter,
+                                       ipVars_.numThreads,
+                                       placeInstForceMatrixX_,
+                                       fixedInstForceVecX_,
+                                       instLocVecX_,
+                                       placeInstForceMatrixY_,
+                                       fixedInstForceVecY_,
+                                       instLocVecY_,
+                                       log_);
+      } else {
+        error = cpuSparseSolve(ipVars_.maxSolverIter,
+                               iter,
+                               placeInstForceMatrixX_,
+                               fixedInstForceVecX_,
+                               instLocVecX_,
+                               placeInstForceMatrixY_,
+                               fixedInstForceVecY_,
+                               instLocVecY_,
+                               log_);
+      }
     }
     float error_max = max(error.x, error.y);
     log_->report("[InitialPlace]  Iter: {} CG residual: {:0.8f} HPWL: {}",
@@ -271,8 +291,14 @@ void InitialPlace::createSparseMatrix()
   // The triplet vector is recommended usages
   // to fill in SparseMatrix from Eigen docs.
   //
+  // Both lists keep their capacity from the previous iteration,
+  // as the B2B structure changes little between iterations.
+  //
 
-  vector<T> listX, listY;
+  vector<T>& listX = placeInstForceListX_;
+  vector<T>& listY = placeInstForceListY_;
+  listX.clear();
+  listY.clear();
   listX.reserve(1000000);
   listY.reserve(1000000);
 
@@ -35,6 +35,7 @@
 
 #include <Eigen/SparseCore>
 #include <memory>
+#include <vector>
 
 #include "nesterovPlace.h"
 #include "odb/db.h"
@@ -59,6 +60,9 @@ class InitialPlaceVars
   float netWeightScale;
   bool debug;
   bool forceCPU;
+  // Jacobi-preconditioned CG with multithreaded SpMV on the CPU
+  bool parallelSolver;
+  int numThreads;
 
   InitialPlaceVars();
   void reset();
@@ -113,6 +117,11 @@ class InitialPlace
   Eigen::VectorXf instLocVecY_, fixedInstForceVecY_;
   SMatrix placeInstForceMatrixX_, placeInstForceMatrixY_;
 
+  // (idx1, idx2, val) lists that fill in the matrices above.
+  // Kept across iterations to reuse their storage.
+  std::vector<Eigen::Triplet<float>> placeInstForceListX_;
+  std::vector<Eigen::Triplet<float>> placeInstForceListY_;
+
   void placeInstsCenter();
   void setPlaceInstExtId();
   void updatePinInfo();
@@ -34,7 +34,9 @@
 #include "nesterovBase.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <utility>
 
@@ -74,8 +76,14 @@ static float getSecondNorm(const vector<FloatPoint>& a);
 //
 // Choose to use "float" only in the following functions
 static float getOverlapDensityArea(const Bin& bin, const GCell* cell);
+static float getOverlapDensityArea(const Bin& bin,
+                                   int lx,
+                                   int ly,
+                                   int ux,
+                                   int uy);
 
-static float fastExp(float exp);
+#pragma omp declare simd
+static inline float fastExp(float exp);
 
 ////////////////////////////////////////////////
 // GCell
@@ -610,6 +618,10 @@ BinGrid::BinGrid()
       targetDensity_(0),
       overflowArea_(0),
       overflowAreaUnscaled_(0),
+      numThreads_(1),
+      incrementalDensityMode_(false),
+      isDensityAreaValid_(false),
+      densityChangeSinceSolve_(0),
       isSetBinCnt_(0)
 {
 }
@@ -650,6 +662,12 @@ void BinGrid::setLogger(utl::Logger* log)
 void BinGrid::setTargetDensity(float density)
 {
   targetDensity_ = density;
+  invalidateDensityArea();
+}
+
+void BinGrid::setNumThreads(int numThreads)
+{
+  numThreads_ = numThreads;
 }
 
 void BinGrid::setBinCnt(int binCntX, int binCntY)
@@ -814,6 +832,8 @@ void BinGrid::initBins()
 
 void BinGrid::updateBinsNonPlaceArea()
 {
+  invalidateDensityArea();
+
   for (auto& bin : bins_) {
     bin.setNonPlaceArea(0);
     bin.setNonPlaceAreaUnscaled(0);
@@ -843,74 +863,175 @@ void BinGrid::updateBinsNonPlaceArea()
   }
 }
 
-// Core Part
-void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
+void BinGrid::setIncrementalDensityMode(bool mode)
 {
-  // clear the Bin-area info
-  for (Bin& bin : bins_) {
-    bin.setInstPlacedArea(0);
-    bin.setInstPlacedAreaUnscaled(0);
-    bin.setFillerArea(0);
-  }
+  incrementalDensityMode_ = mode;
+  invalidateDensityArea();
+}
 
-  for (auto& cell : cells) {
-    std::pair<int, int> pairX = getDensityMinMaxIdxX(cell);
-    std::pair<int, int> pairY = getDensityMinMaxIdxY(cell);
+void BinGrid::invalidateDensityArea()
+{
+  isDensityAreaValid_ = false;
+}
 
-    // The following function is critical runtime hotspot
-    // for global placer.
-    //
-    if (cell->isInstance()) {
-      // macro should have
-      // scale-down with target-density
-      if (cell->isMacroInstance()) {
-        for (int i = pairX.first; i < pairX.second; i++) {
-          for (int j = pairY.first; j < pairY.second; j++) {
-            Bin& bin = bins_[j * binCntX_ + i];
-
-            const float scaledAvea = getOverlapDensityArea(bin, cell)
-                                     * cell->densityScale()
-                                     * bin.targetDensity();
-            bin.addInstPlacedArea(scaledAvea);
-            bin.addInstPlacedAreaUnscaled(scaledAvea);
-          }
-        }
+BinGrid::DensityBox BinGrid::getDensityBox(const GCell* gcell)
+{
+  return {gcell->dLx(),
+          gcell->dLy(),
+          gcell->dUx(),
+          gcell->dUy(),
+          gcell->densityScale()};
+}
+
+void BinGrid::addGCellDensityArea(const GCell* cell,
+                                  const DensityBox& box,
+                                  int sign)
+{
+  std::pair<int, int> pairX
+      = getDensityMinMaxIdx(box.lx, box.ux, lx(), binSizeX_, binCntX_);
+  std::pair<int, int> pairY
+      = getDensityMinMaxIdx(box.ly, box.uy, ly(), binSizeY_, binCntY_);
+
+  if (incrementalDensityMode_) {
+    for (int i = pairX.first; i < pairX.second; i++) {
+      for (int j = pairY.first; j < pairY.second; j++) {
+#pragma omp atomic write
+        dirtyBins_[j * binCntX_ + i] = 1;
       }
-      // normal cells
-      else if (cell->isStdInstance()) {
-        for (int i = pairX.first; i < pairX.second; i++) {
-          for (int j = pairY.first; j < pairY.second; j++) {
-            Bin& bin = bins_[j * binCntX_ + i];
-            const float scaledArea
-                = getOverlapDensityArea(bin, cell) * cell->densityScale();
-            bin.addInstPlacedArea(scaledArea);
-            bin.addInstPlacedAreaUnscaled(scaledArea);
-          }
+    }
+  }
+
+  // The following function is critical runtime hotspot
+  // for global placer.
+  //
+  // Each contribution is truncated to an integer before it is added,
+  // so removing a box later subtracts exactly what was added.
+  if (cell->isInstance()) {
+    // macro should have
+    // scale-down with target-density
+    if (cell->isMacroInstance()) {
+      for (int i = pairX.first; i < pairX.second; i++) {
+        for (int j = pairY.first; j < pairY.second; j++) {
+          Bin& bin = bins_[j * binCntX_ + i];
+
+          const float scaledAvea
+              = getOverlapDensityArea(bin, box.lx, box.ly, box.ux, box.uy)
+                * box.scale * bin.targetDensity();
+          bin.addInstPlacedArea(sign * static_cast<int64_t>(scaledAvea));
+          bin.addInstPlacedAreaUnscaled(sign
+                                        * static_cast<int64_t>(scaledAvea));
         }
       }
-    } else if (cell->isFiller()) {
+    }
+    // normal cells
+    else if (cell->isStdInstance()) {
       for (int i = pairX.first; i < pairX.second; i++) {
         for (int j = pairY.first; j < pairY.second; j++) {
           Bin& bin = bins_[j * binCntX_ + i];
-          bin.addFillerArea(getOverlapDensityArea(bin, cell)
-                            * cell->densityScale());
+          const float scaledArea
+              = getOverlapDensityArea(bin, box.lx, box.ly, box.ux, box.uy)
+                * box.scale;
+          bin.addInstPlacedArea(sign * static_cast<int64_t>(scaledArea));
+          bin.addInstPlacedAreaUnscaled(sign
+                                        * static_cast<int64_t>(scaledArea));
         }
       }
     }
+  } else if (cell->isFiller()) {
+    for (int i = pairX.first; i < pairX.second; i++) {
+      for (int j = pairY.first; j < pairY.second; j++) {
+        Bin& bin = bins_[j * binCntX_ + i];
+        const float scaledArea
+            = getOverlapDensityArea(bin, box.lx, box.ly, box.ux, box.uy)
+              * box.scale;
+        bin.addFillerArea(sign * static_cast<int64_t>(scaledArea));
+      }
+    }
+  }
+}
+
+// Core Part
+void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
+{
+  const bool isIncremental
+      = incrementalDensityMode_ && isDensityAreaValid_
+        && std::equal(
+            cells.begin(), cells.end(), prevCells_.begin(), prevCells_.end());
+
+  if (isIncremental) {
+    // Move only the cells whose density box changed; the thread
+    // partitioning does not matter because bin areas are integers.
+#pragma omp parallel for num_threads(numThreads_) schedule(dynamic, 1024)
+    for (size_t c = 0; c < cells.size(); c++) {
+      const DensityBox box = getDensityBox(cells[c]);
+      if (box == prevBoxes_[c]) {
+        continue;
+      }
+      addGCellDensityArea(cells[c], prevBoxes_[c], -1);
+      addGCellDensityArea(cells[c], box, 1);
+      prevBoxes_[c] = box;
+    }
+  } else {
+    // clear the Bin-area info
+#pragma omp parallel for num_threads(numThreads_)
+    for (size_t b = 0; b < bins_.size(); b++) {
+      Bin& bin = bins_[b];
+      bin.setInstPlacedArea(0);
+      bin.setInstPlacedAreaUnscaled(0);
+      bin.setFillerArea(0);
+    }
+
+    if (incrementalDensityMode_) {
+      dirtyBins_.assign(bins_.size(), 1);
+      binDensityDelta_.assign(bins_.size(), 0);
+    }
+
+    // Cells are spread over the threads; overlapping bins are accumulated
+    // with integer atomics (see Bin::addInstPlacedArea) so the result does
+    // not depend on the thread count.
+#pragma omp parallel for num_threads(numThreads_) schedule(dynamic, 1024)
+    for (size_t c = 0; c < cells.size(); c++) {
+      addGCellDensityArea(cells[c], getDensityBox(cells[c]), 1);
+    }
+
+    if (incrementalDensityMode_) {
+      prevCells_.assign(cells.begin(), cells.end());
+      prevBoxes_.resize(cells.size());
+      for (size_t c = 0; c < cells.size(); c++) {
+        prevBoxes_[c] = getDensityBox(cells[c]);
+      }
+      isDensityAreaValid_ = true;
+    }
   }
 
+  // update density for nesterov use and FFT library
+#pragma omp parallel for num_threads(numThreads_)
+  for (size_t b = 0; b < bins_.size(); b++) {
+    if (isIncremental && !dirtyBins_[b]) {
+      continue;
+    }
+    Bin& bin = bins_[b];
+    int64_t binArea = bin.binArea();
+    const float scaledBinArea
+        = static_cast<float>(binArea * bin.targetDensity());
+    const float density = (static_cast<float>(bin.instPlacedArea())
+                           + static_cast<float>(bin.fillerArea())
+                           + static_cast<float>(bin.nonPlaceArea()))
+                          / scaledBinArea;
+    if (isIncremental) {
+      binDensityDelta_[b] = std::fabs(density - bin.density());
+    }
+    bin.setDensity(density);
+  }
+
+  // overflowArea is summed serially to keep the float rounding
+  // identical for any thread count.
   overflowArea_ = 0;
   overflowAreaUnscaled_ = 0;
-  // update density and overflowArea
-  // for nesterov use and FFT library
   for (Bin& bin : bins_) {
     int64_t binArea = bin.binArea();
     const float scaledBinArea
         = static_cast<float>(binArea * bin.targetDensity());
-    bin.setDensity((static_cast<float>(bin.instPlacedArea())
-                    + static_cast<float>(bin.fillerArea())
-                    + static_cast<float>(bin.nonPlaceArea()))
-                   / scaledBinArea);
 
     overflowArea_ += std::max(0.0f,
                               static_cast<float>(bin.instPlacedArea())
@@ -922,28 +1043,51 @@ void BinGrid::updateBinsGCellDensityArea(const std::vector<GCell*>& cells)
         static_cast<float>(bin.instPlacedAreaUnscaled())
             + static_cast<float>(bin.nonPlaceAreaUnscaled()) - scaledBinArea);
   }
+
+  if (!incrementalDensityMode_) {
+    return;
+  }
+
+  if (!isIncremental) {
+    // everything changed; make sure the next solve is not skipped
+    densityChangeSinceSolve_ = std::numeric_limits<float>::max();
+    std::fill(dirtyBins_.begin(), dirtyBins_.end(), 0);
+    return;
+  }
+
+  for (size_t b = 0; b < bins_.size(); b++) {
+    if (dirtyBins_[b]) {
+      densityChangeSinceSolve_ += binDensityDelta_[b];
+      dirtyBins_[b] = 0;
+    }
+  }
 }
 
-std::pair<int, int> BinGrid::getDensityMinMaxIdxX(const GCell* gcell) const
+std::pair<int, int> BinGrid::getDensityMinMaxIdx(int lo,
+                                                 int hi,
+                                                 int origin,
+                                                 int binSize,
+                                                 int binCnt) const
 {
-  int lowerIdx = (gcell->dLx() - lx()) / binSizeX_;
-  int upperIdx = (fastModulo((gcell->dUx() - lx()), binSizeX_) == 0)
-                     ? (gcell->dUx() - lx()) / binSizeX_
-                     : (gcell->dUx() - lx()) / binSizeX_ + 1;
+  int lowerIdx = (lo - origin) / binSize;
+  int upperIdx = (fastModulo((hi - origin), binSize) == 0)
+                     ? (hi - origin) / binSize
+                     : (hi - origin) / binSize + 1;
 
-  upperIdx = std::min(upperIdx, binCntX_);
+  upperIdx = std::min(upperIdx, binCnt);
   return std::make_pair(lowerIdx, upperIdx);
 }
 
-std::pair<int, int> BinGrid::getDensityMinMaxIdxY(const GCell* gcell) const
+std::pair<int, int> BinGrid::getDensityMinMaxIdxX(const GCell* gcell) const
 {
-  int lowerIdx = (gcell->dLy() - ly()) / binSizeY_;
-  int upperIdx = (fastModulo((gcell->dUy() - ly()), binSizeY_) == 0)
-                     ? (gcell->dUy() - ly()) / binSizeY_
-                     : (gcell->dUy() - ly()) / binSizeY_ + 1;
+  return getDensityMinMaxIdx(
+      gcell->dLx(), gcell->dUx(), lx(), binSizeX_, binCntX_);
+}
 
-  upperIdx = std::min(upperIdx, binCntY_);
-  return std::make_pair(lowerIdx, upperIdx);
+std::pair<int, int> BinGrid::getDensityMinMaxIdxY(const GCell* gcell) const
+{
+  return getDensityMinMaxIdx(
+      gcell->dLy(), gcell->dUy(), ly(), binSizeY_, binCntY_);
 }
 
 std::pair<int, int> BinGrid::getMinMaxIdxX(const Instance* inst) const
@@ -978,6 +1122,9 @@ void NesterovBaseVars::reset()
   targetDensity = 1.0;
   binCntX = binCntY = 0;
   minWireLengthForceBar = -300;
+  numThreads = 1;
+  densityResolveThreshold = 0;
+  incrementalDensity = false;
   isSetBinCnt = 0;
   useUniformTargetDensity = 0;
 }
@@ -1054,6 +1201,13 @@ void NesterovBaseCommon::reset()
   gPinMap_.clear();
   gNetMap_.clear();
 
+  netPinBegin_.clear();
+  waPins_.clear();
+  waExpMinX_.clear();
+  waExpMaxX_.clear();
+  waExpMinY_.clear();
+  waExpMaxY_.clear();
+
   gCellStor_.shrink_to_fit();
   gNetStor_.shrink_to_fit();
   gPinStor_.shrink_to_fit();
@@ -1138,6 +1292,27 @@ void NesterovBaseCommon::init()
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+  initWaStor();
+}
+
+void NesterovBaseCommon::initWaStor()
+{
+  netPinBegin_.clear();
+  waPins_.clear();
+
+  netPinBegin_.reserve(gNets_.size() + 1);
+  waPins_.reserve(gPins_.size());
+  for (auto& gNet : gNets_) {
+    netPinBegin_.push_back(waPins_.size());
+    waPins_.insert(waPins_.end(), gNet->gPins().begin(), gNet->gPins().end());
+  }
+  netPinBegin_.push_back(waPins_.size());
+
+  waExpMinX_.assign(waPins_.size(), 0);
+  waExpMaxX_.assign(waPins_.size(), 0);
+  waExpMinY_.assign(waPins_.size(), 0);
+  waExpMaxY_.assign(waPins_.size(), 0);
 }
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
@@ -1190,32 +1365,68 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
   // clear all WA variables.
-  for (auto& gNet : gNets_) {
-    gNet->clearWaVars();
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (size_t i = 0; i < gNets_.size(); i++) {
+    gNets_[i]->clearWaVars();
   }
-  for (auto& gPin : gPins_) {
-    gPin->clearWaVars();
+#pragma omp parallel for num_threads(nbVars_.numThreads)
+  for (size_t i = 0; i < gPins_.size(); i++) {
+    gPins_[i]->clearWaVars();
   }
 
-  for (auto& gNet : gNets_) {
+  // Every GPin belongs to exactly one GNet, so nets can be processed
+  // independently and each net's sums keep their serial pin order.
+  //
+  // Pass 1: net boxes and the exponent arguments of each pin.
+  //
+  // The WA terms are shift invariant:
+  //
+  //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
+  //   -----------------    = -----------------
+  //   Sum(exp(x_i))          Sum(exp(x_i - C))
+  //
+  // So we shift to keep the exponential from overflowing
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 256)
+  for (size_t i = 0; i < gNets_.size(); i++) {
+    GNet* gNet = gNets_[i];
     gNet->updateBox();
 
-    for (auto& gPin : gNet->gPins()) {
-      // The WA terms are shift invariant:
-      //
-      //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
-      //   -----------------    = -----------------
-      //   Sum(exp(x_i))          Sum(exp(x_i - C))
-      //
-      // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
+    for (int k = netPinBegin_[i]; k < netPinBegin_[i + 1]; k++) {
+      const GPin* gPin = waPins_[k];
+      waExpMinX_[k] = (gNet->lx() - gPin->cx()) * wlCoeffX;
+      waExpMaxX_[k] = (gPin->cx() - gNet->ux()) * wlCoeffX;
+      waExpMinY_[k] = (gNet->ly() - gPin->cy()) * wlCoeffY;
+      waExpMaxY_[k] = (gPin->cy() - gNet->uy()) * wlCoeffY;
+    }
+  }
+
+  // Pass 2: exp kernel over all pins.
+  // fastExp is never negative, so -1 marks pins outside the force bar.
+  const float forceBar = nbVars_.minWireLengthForceBar;
+  const int pinCnt = waPins_.size();
+  float* expMinX = waExpMinX_.data();
+  float* expMaxX = waExpMaxX_.data();
+  float* expMinY = waExpMinY_.data();
+  float* expMaxY = waExpMaxY_.data();
+#pragma omp parallel for simd num_threads(nbVars_.numThreads)
+  for (int k = 0; k < pinCnt; k++) {
+    expMinX[k] = (expMinX[k] > forceBar) ? fastExp(expMinX[k]) : -1.0f;
+    expMaxX[k] = (expMaxX[k] > forceBar) ? fastExp(expMaxX[k]) : -1.0f;
+    expMinY[k] = (expMinY[k] > forceBar) ? fastExp(expMinY[k]) : -1.0f;
+    expMaxY[k] = (expMaxY[k] > forceBar) ? fastExp(expMaxY[k]) : -1.0f;
+  }
+
+  // Pass 3: per-net sums in pin order.
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 256)
+  for (size_t i = 0; i < gNets_.size(); i++) {
+    GNet* gNet = gNets_[i];
+
+    for (int k = netPinBegin_[i]; k < netPinBegin_[i + 1]; k++) {
+      GPin* gPin = waPins_[k];
 
       // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
+      if (expMinX[k] >= 0) {
+        gPin->setMinExpSumX(expMinX[k]);
         gNet->addWaExpMinSumX(gPin->minExpSumX());
         gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
         if (gPin->gCell() && gPin->gCell()->isInstance()) {
@@ -1230,8 +1441,8 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       }
 
       // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
+      if (expMaxX[k] >= 0) {
+        gPin->setMaxExpSumX(expMaxX[k]);
         gNet->addWaExpMaxSumX(gPin->maxExpSumX());
         gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
         if (gPin->gCell() && gPin->gCell()->isInstance()) {
@@ -1246,8 +1457,8 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       }
 
       // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
+      if (expMinY[k] >= 0) {
+        gPin->setMinExpSumY(expMinY[k]);
         gNet->addWaExpMinSumY(gPin->minExpSumY());
         gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
         if (gPin->gCell() && gPin->gCell()->isInstance()) {
@@ -1262,8 +1473,8 @@ void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
       }
 
       // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
+      if (expMaxY[k] >= 0) {
+        gPin->setMaxExpSumY(expMaxY[k]);
         gNet->addWaExpMaxSumY(gPin->maxExpSumY());
         gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
         if (gPin->gCell() && gPin->gCell()->isInstance()) {
@@ -1440,6 +1651,8 @@ NesterovBase::NesterovBase()
       sumPhi_(0),
       targetDensity_(0),
       uniformTargetDensity_(0),
+      isDensitySolved_(false),
+      skippedDensitySolves_(0),
       stepLength_(0),
       densityPenalty_(0),
 
@@ -1504,6 +1717,9 @@ void NesterovBase::reset()
   targetDensity_ = 0;
   uniformTargetDensity_ = 0;
 
+  isDensitySolved_ = false;
+  skippedDensitySolves_ = 0;
+
   iter_ = 0;
   minSumOverflow = 1e30;
   hpwlWithMinSumOverflow = 1e30;
@@ -1578,13 +1794,18 @@ void NesterovBase::init()
   bg_.setLogger(log_);
   bg_.setCorePoints(&(pb_->die()));
   bg_.setTargetDensity(targetDensity_);
+  bg_.setNumThreads(nbVars_.numThreads);
+  bg_.setIncrementalDensityMode(nbVars_.incrementalDensity);
 
   // update binGrid info
   bg_.initBins();
 
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   nbVars_.numThreads));
 
   fft_ = std::move(fft);
 
@@ -2024,24 +2245,45 @@ FloatPoint NesterovBase::getDensityGradient(const GCell* gCell) const
 // Density force cals
 void NesterovBase::updateDensityForceBin()
 {
-  // copy density to utilize FFT
-  for (Bin& bin : bg_.bins()) {
-    fft_->updateDensity(bin.x(), bin.y(), bin.density());
-  }
+  // Late in placement few cells change bins; while the accumulated
+  // density change is small keep the previous potential and forces.
+  const bool skipSolve
+      = nbVars_.incrementalDensity && isDensitySolved_
+        && nbVars_.densityResolveThreshold > 0
+        && bg_.densityChangeSinceSolve() / bg_.binsConst().size()
+               < nbVars_.densityResolveThreshold;
 
-  // do FFT
-  fft_->doFFT();
+  if (skipSolve) {
+    skippedDensitySolves_++;
+    debugPrint(log_,
+               GPL,
+               "updateDensityForceBin",
+               1,
+               "Skip FFT solve: density change {:g}",
+               bg_.densityChangeSinceSolve());
+  } else {
+    // copy density to utilize FFT
+    for (Bin& bin : bg_.bins()) {
+      fft_->updateDensity(bin.x(), bin.y(), bin.density());
+    }
+
+    // do FFT
+    fft_->doFFT();
+    isDensitySolved_ = true;
+    bg_.resetDensityChange();
+  }
 
   // update electroPhi and electroForce
   // update sumPhi_ for nesterov loop
   sumPhi_ = 0;
   for (Bin& bin : bg_.bins()) {
-    auto eForcePair = fft_->getElectroForce(bin.x(), bin.y());
-    bin.setElectroForce(eForcePair.first, eForcePair.second);
-
-    float electroPhi = fft_->getElectroPhi(bin.x(), bin.y());
-    bin.setElectroPhi(electroPhi);
+    if (!skipSolve) {
+      auto eForcePair = fft_->getElectroForce(bin.x(), bin.y());
+      bin.setElectroForce(eForcePair.first, eForcePair.second);
+      bin.setElectroPhi(fft_->getElectroPhi(bin.x(), bin.y()));
+    }
 
+    const float electroPhi = bin.electroPhi();
     sumPhi_ += electroPhi
                * static_cast<float>(bin.nonPlaceArea() + bin.instPlacedArea()
                                     + bin.fillerArea());
@@ -2176,24 +2418,15 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
   debugPrint(
       log_, GPL, "updateGrad", 1, "DensityPenalty: {:g}", densityPenalty_);
 
+  // Per-cell gradients are independent; the sums are reduced below
+  // in cell order so they match the serial run bit-for-bit.
+#pragma omp parallel for num_threads(nbVars_.numThreads) schedule(dynamic, 1024)
   for (size_t i = 0; i < gCells_.size(); i++) {
-    GCell* gCell = gCells_.at(i);
+    GCell* gCell = gCells_[i];
     wireLengthGrads[i]
         = nbc_->getWireLengthGradientWA(gCell, wlCoeffX, wlCoeffY);
     densityGrads[i] = getDensityGradient(gCell);
 
-    // Different compiler has different results on the following formula.
-    // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
-    //
-    // To prevent instability problem,
-    // I partitioned the fabs(~~.x) + fabs(~~.y) as two terms.
-    //
-    wireLengthGradSum_ += fabs(wireLengthGrads[i].x);
-    wireLengthGradSum_ += fabs(wireLengthGrads[i].y);
-
-    densityGradSum_ += fabs(densityGrads[i].x);
-    densityGradSum_ += fabs(densityGrads[i].y);
-
     sumGrads[i].x = wireLengthGrads[i].x + densityPenalty_ * densityGrads[i].x;
     sumGrads[i].y = wireLengthGrads[i].y + densityPenalty_ * densityGrads[i].y;
 
@@ -2214,6 +2447,20 @@ void NesterovBase::updateGradients(std::vector<FloatPoint>& sumGrads,
 
     sumGrads[i].x /= sumPrecondi.x;
     sumGrads[i].y /= sumPrecondi.y;
+  }
+
+  for (size_t i = 0; i < gCells_.size(); i++) {
+    // Different compiler has different results on the following formula.
+    // e.g. wireLengthGradSum_ += fabs(~~.x) + fabs(~~.y);
+    //
+    // To prevent instability problem,
+    // I partitioned the fabs(~~.x) + fabs(~~.y) as two terms.
+    //
+    wireLengthGradSum_ += fabs(wireLengthGrads[i].x);
+    wireLengthGradSum_ += fabs(wireLengthGrads[i].y);
+
+    densityGradSum_ += fabs(densityGrads[i].x);
+    densityGradSum_ += fabs(densityGrads[i].y);
 
     gradSum += fabs(sumGrads[i].x) + fabs(sumGrads[i].y);
   }
@@ -2582,8 +2829,18 @@ static int fastModulo(const int input, const int ceil)
 
 static float getOverlapDensityArea(const Bin& bin, const GCell* cell)
 {
-  int rectLx = max(bin.lx(), cell->dLx()), rectLy = max(bin.ly(), cell->dLy()),
-      rectUx = min(bin.ux(), cell->dUx()), rectUy = min(bin.uy(), cell->dUy());
+  return getOverlapDensityArea(
+      bin, cell->dLx(), cell->dLy(), cell->dUx(), cell->dUy());
+}
+
+static float getOverlapDensityArea(const Bin& bin,
+                                   int lx,
+                                   int ly,
+                                   int ux,
+                                   int uy)
+{
+  int rectLx = max(bin.lx(), lx), rectLy = max(bin.ly(), ly),
+      rectUx = min(bin.ux(), ux), rectUy = min(bin.uy(), uy);
 
   if (rectLx >= rectUx || rectLy >= rectUy) {
     return 0;
@@ -2682,7 +2939,8 @@ static float calculateBiVariateNormalCDF(biNormalParameters i)
 }
 //
 // https://codingforspeed.com/using-faster-exponential-approximation/
-static float fastExp(float a)
+#pragma omp declare simd
+static inline float fastExp(float a)
 {
   a = 1.0f + a / 1024.0f;
   a *= a;
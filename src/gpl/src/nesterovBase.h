@@ -645,8 +645,12 @@ inline void Bin::addNonPlaceArea(int64_t area)
   nonPlaceArea_ += area;
 }
 
+// The following three are called from the parallel density update.
+// Areas are accumulated as integers so the atomic sums are
+// order-independent and match the serial result.
 inline void Bin::addInstPlacedArea(int64_t area)
 {
+#pragma omp atomic
   instPlacedArea_ += area;
 }
 
@@ -657,11 +661,13 @@ inline void Bin::addNonPlaceAreaUnscaled(int64_t area)
 
 inline void Bin::addInstPlacedAreaUnscaled(int64_t area)
 {
+#pragma omp atomic
   instPlacedAreaUnscaled_ += area;
 }
 
 inline void Bin::addFillerArea(int64_t area)
 {
+#pragma omp atomic
   fillerArea_ += area;
 }
 
@@ -681,8 +687,21 @@ class BinGrid
   void setCorePoints(const Die* die);
   void setBinCnt(int binCntX, int binCntY);
   void setTargetDensity(float density);
+  void setNumThreads(int numThreads);
   void updateBinsGCellDensityArea(const std::vector<GCell*>& cells);
 
+  // Incremental density mode: only GCells whose density box or scale
+  // changed since the previous update are re-accumulated, and only the
+  // bins they touch (dirty bins) get their density refreshed.
+  // The result is identical to a full update.
+  void setIncrementalDensityMode(bool mode);
+  // force a full update on the next updateBinsGCellDensityArea
+  void invalidateDensityArea();
+
+  // sum of |density change| over all bins since resetDensityChange()
+  float densityChangeSinceSolve() const { return densityChangeSinceSolve_; }
+  void resetDensityChange() { densityChangeSinceSolve_ = 0; }
+
   void initBins();
 
   // lx, ly, ux, uy will hold coreArea
@@ -716,6 +735,31 @@ class BinGrid
   void updateBinsNonPlaceArea();
 
  private:
+  // GCell density box and scale seen by the last density update
+  struct DensityBox
+  {
+    int lx;
+    int ly;
+    int ux;
+    int uy;
+    float scale;
+
+    bool operator==(const DensityBox& other) const
+    {
+      return lx == other.lx && ly == other.ly && ux == other.ux
+             && uy == other.uy && scale == other.scale;
+    }
+  };
+
+  static DensityBox getDensityBox(const GCell* gcell);
+  std::pair<int, int> getDensityMinMaxIdx(int lo,
+                                          int hi,
+                                          int origin,
+                                          int binSize,
+                                          int binCnt) const;
+  // add (sign = 1) or remove (sign = -1) the area of gcell placed at box
+  void addGCellDensityArea(const GCell* gcell, const DensityBox& box, int sign);
+
   std::vector<Bin> bins_;
   std::shared_ptr<PlacerBase> pb_;
   utl::Logger* log_;
@@ -730,6 +774,15 @@ class BinGrid
   float targetDensity_;
   int64_t overflowArea_;
   int64_t overflowAreaUnscaled_;
+  int numThreads_;
+
+  bool incrementalDensityMode_;
+  bool isDensityAreaValid_;
+  float densityChangeSinceSolve_;
+  std::vector<const GCell*> prevCells_;
+  std::vector<DensityBox> prevBoxes_;
+  std::vector<unsigned char> dirtyBins_;
+  std::vector<float> binDensityDelta_;
 
   unsigned char isSetBinCnt_ : 1;
 };
@@ -746,6 +799,11 @@ class NesterovBaseVars
   int binCntX;
   int binCntY;
   float minWireLengthForceBar;
+  int numThreads;
+  // skip the FFT re-solve while the mean per-bin density change since
+  // the last solve stays below this value (0 always re-solves)
+  float densityResolveThreshold;
+  bool incrementalDensity;
   // temp variables
   unsigned char isSetBinCnt : 1;
   unsigned char useUniformTargetDensity : 1;
@@ -857,7 +915,22 @@ class NesterovBaseCommon
   std::unordered_map<Pin*, GPin*> gPinMap_;
   std::unordered_map<Net*, GNet*> gNetMap_;
 
+  // Structure-of-arrays WA storage in net-major pin order.
+  // The pins of gNets_[i] are waPins_[netPinBegin_[i] .. netPinBegin_[i+1]),
+  // so the exponent kernel of updateWireLengthForceWA is a flat loop
+  // the compiler can vectorize.
+  //
+  // waExp*_ first hold the exponent arguments and then exp() of them,
+  // or -1 when the pin is below minWireLengthForceBar.
+  std::vector<int> netPinBegin_;
+  std::vector<GPin*> waPins_;
+  std::vector<float> waExpMinX_;
+  std::vector<float> waExpMaxX_;
+  std::vector<float> waExpMinY_;
+  std::vector<float> waExpMaxY_;
+
   void init();
+  void initWaStor();
   void reset();
 };
 
@@ -1019,6 +1092,8 @@ class NesterovBase
 
   bool isDiverged() const { return isDiverged_; }
 
+  int skippedDensitySolves() const { return skippedDensitySolves_; }
+
  private:
   NesterovBaseVars nbVars_;
   std::shared_ptr<PlacerBase> pb_;
@@ -1046,6 +1121,9 @@ class NesterovBase
   float targetDensity_;
   float uniformTargetDensity_;
 
+  bool isDensitySolved_;
+  int skippedDensitySolves_;
+
   // Nesterov loop data for each region
   // SLP is Step Length Prediction.
   //
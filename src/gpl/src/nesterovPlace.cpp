@@ -560,6 +560,17 @@ int NesterovPlace::doNesterovPlace(int start_iter)
   // db should be updated.
   updateDb();
 
+  int skippedDensitySolves = 0;
+  for (auto& nb : nbVec_) {
+    skippedDensitySolves += nb->skippedDensitySolves();
+  }
+  if (skippedDensitySolves > 0) {
+    log_->info(GPL,
+               104,
+               "Skipped {} density re-solves below the change threshold.",
+               skippedDensitySolves);
+  }
+
   if (isDiverged_) {
     log_->error(GPL, divergeCode_, divergeMsg_);
   }
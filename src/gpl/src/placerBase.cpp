@@ -34,6 +34,7 @@
 #include "placerBase.h"
 
 #include <odb/db.h>
+#include <odb/dbConnectivityIndex.h>
 
 #include <iostream>
 #include <utility>
@@ -890,6 +891,9 @@ void PlacerBaseCommon::init()
     }
   }
 
+  // the pins are walked three times below; the index keeps them contiguous
+  dbConnectivityIndex connectivity(block);
+
   // nets fill
   dbSet<dbNet> nets = block->getNets();
   netStor_.reserve(nets.size());
@@ -905,7 +909,7 @@ void PlacerBaseCommon::init()
       Net* myNetPtr = &netStor_[netStor_.size() - 1];
       netMap_[net] = myNetPtr;
 
-      for (dbITerm* iTerm : net->getITerms()) {
+      for (dbITerm* iTerm : connectivity.getITerms(net)) {
         Pin myPin(iTerm);
         myPin.setNet(myNetPtr);
         myPin.setInstance(dbToPb(iTerm->getInst()));
@@ -938,7 +942,7 @@ void PlacerBaseCommon::init()
     if (!inst.isInstance()) {
       continue;
     }
-    for (dbITerm* iTerm : inst.dbInst()->getITerms()) {
+    for (dbITerm* iTerm : connectivity.getITerms(inst.dbInst())) {
       // note that, DB's ITerm can have
       // VDD/VSS pins.
       //
@@ -953,7 +957,7 @@ void PlacerBaseCommon::init()
   // nets' pin update
   nets_.reserve(netStor_.size());
   for (auto& net : netStor_) {
-    for (dbITerm* iTerm : net.dbNet()->getITerms()) {
+    for (dbITerm* iTerm : connectivity.getITerms(net.dbNet())) {
       net.addPin(dbToPb(iTerm));
     }
     if (pbVars_.skipIoMode == false) {
@@ -67,6 +67,10 @@ Replace::Replace()
       initialPlaceMaxFanout_(200),
       initialPlaceNetWeightScale_(800),
       forceCPU_(false),
+      initialPlaceParallelSolver_(false),
+      numThreads_(1),
+      incrementalDensityMode_(false),
+      densityResolveThreshold_(0),
       nesterovPlaceMaxIter_(5000),
       binGridCntX_(0),
       binGridCntY_(0),
@@ -88,7 +92,11 @@ Replace::Replace()
       routabilityRcK4_(0.0),
       routabilityMaxBloatIter_(1),
       routabilityMaxInflationIter_(4),
+      routabilityUseRudy_(false),
+      routabilityRudyCalibrationInterval_(5),
       timingNetWeightMax_(1.9),
+      timingDrivenIncrementalMode_(false),
+      timingDrivenMoveThreshold_(0),
       timingDrivenMode_(true),
       routabilityDrivenMode_(true),
       uniformTargetDensityMode_(false),
@@ -139,6 +147,10 @@ void Replace::reset()
   initialPlaceMaxFanout_ = 200;
   initialPlaceNetWeightScale_ = 800;
   forceCPU_ = false;
+  initialPlaceParallelSolver_ = false;
+  numThreads_ = 1;
+  incrementalDensityMode_ = false;
+  densityResolveThreshold_ = 0;
 
   nesterovPlaceMaxIter_ = 5000;
   binGridCntX_ = binGridCntY_ = 0;
@@ -159,6 +171,8 @@ void Replace::reset()
   routabilityRcK3_ = routabilityRcK4_ = 0.0;
   routabilityMaxBloatIter_ = 1;
   routabilityMaxInflationIter_ = 4;
+  routabilityUseRudy_ = false;
+  routabilityRudyCalibrationInterval_ = 5;
 
   timingDrivenMode_ = true;
   routabilityDrivenMode_ = true;
@@ -170,6 +184,8 @@ void Replace::reset()
   timingNetWeightOverflows_.clear();
   timingNetWeightOverflows_.shrink_to_fit();
   timingNetWeightMax_ = 1.9;
+  timingDrivenIncrementalMode_ = false;
+  timingDrivenMoveThreshold_ = 0;
 
   gui_debug_ = false;
   gui_debug_pause_iterations_ = 10;
@@ -289,6 +305,8 @@ void Replace::doInitialPlace()
   ipVars.netWeightScale = initialPlaceNetWeightScale_;
   ipVars.debug = gui_debug_initial_;
   ipVars.forceCPU = forceCPU_;
+  ipVars.parallelSolver = initialPlaceParallelSolver_;
+  ipVars.numThreads = numThreads_;
 
   std::unique_ptr<InitialPlace> ip(
       new InitialPlace(ipVars, pbc_, pbVec_, log_));
@@ -337,6 +355,9 @@ bool Replace::initNesterovPlace()
     }
 
     nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
+    nbVars.numThreads = numThreads_;
+    nbVars.incrementalDensity = incrementalDensityMode_;
+    nbVars.densityResolveThreshold = densityResolveThreshold_;
 
     nbc_ = std::make_shared<NesterovBaseCommon>(nbVars, pbc_, log_);
 
@@ -357,6 +378,8 @@ bool Replace::initNesterovPlace()
     rbVars.rcK2 = routabilityRcK2_;
     rbVars.rcK3 = routabilityRcK3_;
     rbVars.rcK4 = routabilityRcK4_;
+    rbVars.useRudy = routabilityUseRudy_;
+    rbVars.rudyCalibrationInterval = routabilityRudyCalibrationInterval_;
 
     rb_ = std::make_shared<RouteBase>(rbVars, db_, fr_, nbc_, nbVec_, log_);
   }
@@ -365,6 +388,8 @@ bool Replace::initNesterovPlace()
     tb_ = std::make_shared<TimingBase>(nbc_, rs_, log_);
     tb_->setTimingNetWeightOverflows(timingNetWeightOverflows_);
     tb_->setTimingNetWeightMax(timingNetWeightMax_);
+    tb_->setIncrementalMode(timingDrivenIncrementalMode_);
+    tb_->setIncrementalMoveThreshold(timingDrivenMoveThreshold_);
   }
 
   if (!np_) {
@@ -521,6 +546,26 @@ void Replace::setForceCPU(bool force_cpu)
   forceCPU_ = force_cpu;
 }
 
+void Replace::setInitialPlaceParallelSolver(bool mode)
+{
+  initialPlaceParallelSolver_ = mode;
+}
+
+void Replace::setNumThreads(int threads)
+{
+  numThreads_ = threads;
+}
+
+void Replace::setIncrementalDensityMode(bool mode)
+{
+  incrementalDensityMode_ = mode;
+}
+
+void Replace::setDensityResolveThreshold(float threshold)
+{
+  densityResolveThreshold_ = threshold;
+}
+
 void Replace::setTimingDrivenMode(bool mode)
 {
   timingDrivenMode_ = mode;
@@ -577,6 +622,16 @@ void Replace::setRoutabilityRcCoefficients(float k1,
   routabilityRcK4_ = k4;
 }
 
+void Replace::setRoutabilityUseRudy(bool mode)
+{
+  routabilityUseRudy_ = mode;
+}
+
+void Replace::setRoutabilityRudyCalibrationInterval(int interval)
+{
+  routabilityRudyCalibrationInterval_ = interval;
+}
+
 void Replace::setPadLeft(int pad)
 {
   padLeft_ = pad;
@@ -597,4 +652,14 @@ void Replace::setTimingNetWeightMax(float max)
   timingNetWeightMax_ = max;
 }
 
+void Replace::setTimingDrivenIncrementalMode(bool mode)
+{
+  timingDrivenIncrementalMode_ = mode;
+}
+
+void Replace::setTimingDrivenMoveThreshold(int threshold)
+{
+  timingDrivenMoveThreshold_ = threshold;
+}
+
 }  // namespace gpl
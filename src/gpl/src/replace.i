@@ -142,6 +142,34 @@ set_force_cpu(bool force_cpu)
   replace->setForceCPU(force_cpu);
 }
 
+void
+set_initial_place_parallel_solver_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setInitialPlaceParallelSolver(mode);
+}
+
+void
+set_num_threads_cmd(int threads)
+{
+  Replace* replace = getReplace();
+  replace->setNumThreads(threads);
+}
+
+void
+set_incremental_density_mode_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setIncrementalDensityMode(mode);
+}
+
+void
+set_density_resolve_threshold_cmd(float threshold)
+{
+  Replace* replace = getReplace();
+  replace->setDensityResolveThreshold(threshold);
+}
+
 void set_timing_driven_mode(bool timing_driven)
 {
   Replace* replace = getReplace();
@@ -215,6 +243,20 @@ set_routability_rc_coefficients_cmd(float k1,
   replace->setRoutabilityRcCoefficients(k1, k2, k3, k4);
 }
 
+void
+set_routability_use_rudy_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setRoutabilityUseRudy(mode);
+}
+
+void
+set_routability_rudy_calibration_interval_cmd(int interval)
+{
+  Replace* replace = getReplace();
+  replace->setRoutabilityRudyCalibrationInterval(interval);
+}
+
 
 void
 set_pad_left_cmd(int pad) 
@@ -258,6 +300,20 @@ set_timing_driven_net_weight_max_cmd(float max)
   return replace->setTimingNetWeightMax(max);
 }
 
+void
+set_timing_driven_incremental_mode_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setTimingDrivenIncrementalMode(mode);
+}
+
+void
+set_timing_driven_move_threshold_cmd(int threshold)
+{
+  Replace* replace = getReplace();
+  replace->setTimingDrivenMoveThreshold(threshold);
+}
+
 void
 set_debug_cmd(int pause_iterations,
               int update_iterations,
@@ -40,6 +40,7 @@ sta::define_cmd_args "global_placement" {\
     [-disable_routability_driven]\
     [-incremental]\
     [-force_cpu]\
+    [-initial_place_parallel_solver]\
     [-skip_io]\
     [-bin_grid_count grid_count]\
     [-density target_density]\
@@ -59,11 +60,18 @@ sta::define_cmd_args "global_placement" {\
     [-routability_inflation_ratio_coef routability_inflation_ratio_coef]\
     [-routability_max_inflation_ratio routability_max_inflation_ratio]\
     [-routability_rc_coefficients routability_rc_coefficients]\
+    [-routability_use_rudy]\
+    [-routability_rudy_calibration_interval routability_rudy_calibration_interval]\
     [-timing_driven_net_reweight_overflow timing_driven_net_reweight_overflow]\
     [-timing_driven_net_weight_max timing_driven_net_weight_max]\
     [-timing_driven_nets_percentage timing_driven_nets_percentage]\
+    [-timing_driven_incremental]\
+    [-timing_driven_move_threshold timing_driven_move_threshold]\
     [-pad_left pad_left]\
     [-pad_right pad_right]\
+    [-threads threads]\
+    [-incremental_density]\
+    [-density_resolve_threshold density_resolve_threshold]\
 }
 
 proc global_placement { args } {
@@ -79,19 +87,26 @@ proc global_placement { args } {
       -routability_inflation_ratio_coef \
       -routability_max_inflation_ratio \
       -routability_rc_coefficients \
+      -routability_rudy_calibration_interval \
       -timing_driven_net_reweight_overflow \
       -timing_driven_net_weight_max \
       -timing_driven_nets_percentage \
-      -pad_left -pad_right} \
+      -timing_driven_move_threshold \
+      -pad_left -pad_right -threads \
+      -density_resolve_threshold} \
     flags {-skip_initial_place \
       -skip_nesterov_place \
       -timing_driven \
+      -timing_driven_incremental \
       -routability_driven \
       -disable_timing_driven \
       -disable_routability_driven \
       -skip_io \
       -incremental\
-      -force_cpu}
+      -incremental_density\
+      -routability_use_rudy\
+      -force_cpu \
+      -initial_place_parallel_solver}
 
   # flow control for initial_place
   if { [info exists flags(-skip_initial_place)] } {
@@ -105,6 +120,29 @@ proc global_placement { args } {
   set force_cpu [info exists flags(-force_cpu)]
   gpl::set_force_cpu $force_cpu
 
+  gpl::set_initial_place_parallel_solver_cmd \
+    [info exists flags(-initial_place_parallel_solver)]
+
+  if { [info exists keys(-threads)] } {
+    set threads $keys(-threads)
+    sta::check_positive_integer "-threads" $threads
+    gpl::set_num_threads_cmd $threads
+  } else {
+    gpl::set_num_threads_cmd [ord::thread_count]
+  }
+
+  set incremental_density [info exists flags(-incremental_density)]
+  if { [info exists keys(-density_resolve_threshold)] } {
+    set threshold $keys(-density_resolve_threshold)
+    sta::check_positive_float "-density_resolve_threshold" $threshold
+    if { $threshold > 1.0 } {
+      utl::error GPL 137 "Density resolve threshold must be in \[0, 1\]."
+    }
+    gpl::set_density_resolve_threshold_cmd $threshold
+    set incremental_density 1
+  }
+  gpl::set_incremental_density_mode_cmd $incremental_density
+
   set skip_io [info exists flags(-skip_io)]
   gpl::set_skip_io_mode_cmd $skip_io
   if { $skip_io } {
@@ -140,6 +178,16 @@ proc global_placement { args } {
     if { [info exists keys(-timing_driven_nets_percentage)] } {
       rsz::set_worst_slack_nets_percent $keys(-timing_driven_nets_percentage)
     }
+
+    if { [info exists keys(-timing_driven_move_threshold)] } {
+      set move_threshold $keys(-timing_driven_move_threshold)
+      sta::check_positive_float "-timing_driven_move_threshold" $move_threshold
+      gpl::set_timing_driven_incremental_mode_cmd 1
+      gpl::set_timing_driven_move_threshold_cmd \
+        [ord::microns_to_dbu $move_threshold]
+    } elseif { [info exists flags(-timing_driven_incremental)] } {
+      gpl::set_timing_driven_incremental_mode_cmd 1
+    }
   }
 
   if { [info exists flags(-disable_timing_driven)] } { 
@@ -290,6 +338,18 @@ proc global_placement { args } {
     gpl::set_routability_rc_coefficients_cmd $k1 $k2 $k3 $k4
   }
 
+  # routability RUDY estimate between global router calls
+  if { [info exists flags(-routability_use_rudy)] } {
+    gpl::set_routability_use_rudy_cmd 1
+  }
+
+  if { [info exists keys(-routability_rudy_calibration_interval)] } {
+    set interval $keys(-routability_rudy_calibration_interval)
+    sta::check_positive_integer "-routability_rudy_calibration_interval" $interval
+    gpl::set_routability_use_rudy_cmd 1
+    gpl::set_routability_rudy_calibration_interval_cmd $interval
+  }
+
   # temp code. 
   if { [info exists keys(-pad_left)] } {
     set pad_left $keys(-pad_left)
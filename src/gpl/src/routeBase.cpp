@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <utility>
 
@@ -288,6 +289,8 @@ void RouteBaseVars::reset()
   rcK3 = rcK4 = 0.0;
   maxBloatIter = 1;
   maxInflationIter = 4;
+  useRudy = false;
+  rudyCalibrationInterval = 5;
 }
 
 /////////////////////////////////////////////
@@ -305,7 +308,16 @@ RouteBase::RouteBase()
       numCall_(0),
       minRc_(1e30),
       minRcTargetDensity_(0),
-      minRcViolatedCnt_(0)
+      minRcViolatedCnt_(0),
+      isRudyCalibrated_(false),
+      rudyTileLx_(0),
+      rudyTileLy_(0),
+      rudyTileSizeX_(0),
+      rudyTileSizeY_(0),
+      rudyTileCntX_(0),
+      rudyTileCntY_(0),
+      rudyCalibH_(1.0),
+      rudyCalibV_(1.0)
 {
 }
 
@@ -347,6 +359,18 @@ void RouteBase::reset()
   minRcCellSize_.clear();
   minRcCellSize_.shrink_to_fit();
 
+  isRudyCalibrated_ = false;
+  rudyTileLx_ = rudyTileLy_ = 0;
+  rudyTileSizeX_ = rudyTileSizeY_ = 0;
+  rudyTileCntX_ = rudyTileCntY_ = 0;
+  rudyCalibH_ = rudyCalibV_ = 1.0;
+  rudyCapH_.clear();
+  rudyCapV_.clear();
+  rudyBlockH_.clear();
+  rudyBlockV_.clear();
+  rudyRatioH_.clear();
+  rudyRatioV_.clear();
+
   resetRoutabilityResources();
 }
 
@@ -565,10 +589,22 @@ std::pair<bool, bool> RouteBase::routability()
   tg_ = std::move(tg);
   tg_->setLogger(log_);
 
-  getGlobalRouterResult();
+  // With RUDY enabled, the global router only runs on calibration calls;
+  // the calls in between estimate congestion from the net bounding boxes.
+  float curRc = 0;
+  if (!rbVars_.useRudy || !isRudyCalibrated_
+      || (numCall_ - 1) % std::max(rbVars_.rudyCalibrationInterval, 1) == 0) {
+    getGlobalRouterResult();
+    if (rbVars_.useRudy) {
+      calibrateRudy();
+    }
+    curRc = getRC();
+  } else {
+    updateRudyRoute();
+    curRc = getRudyRC();
+  }
 
   // no need routing if RC is lower than targetRC val
-  float curRc = getRC();
 
   if (curRc < rbVars_.targetRC) {
     resetRoutabilityResources();
@@ -754,10 +790,6 @@ void RouteBase::revertGCellSizeToMinRc()
 // extract RC values
 float RouteBase::getRC() const
 {
-  double totalRouteOverflowH2 = 0;
-  double totalRouteOverflowV2 = 0;
-  int overflowTileCnt2 = 0;
-
   std::vector<double> horEdgeCongArray;
   std::vector<double> verEdgeCongArray;
 
@@ -775,20 +807,39 @@ float RouteBase::getRC() const
       // escape the case when blockageRatio is too huge
       if (ratio >= 0.0f) {
         if (isHorizontalLayer) {
-          totalRouteOverflowH2 += fmax(0.0, -1 + ratio);
           horEdgeCongArray.push_back(ratio);
         } else {
-          totalRouteOverflowV2 += fmax(0.0, -1 + ratio);
           verEdgeCongArray.push_back(ratio);
         }
-
-        if (ratio > 1.0) {
-          overflowTileCnt2++;
-        }
       }
     }
   }
 
+  return getRC(horEdgeCongArray, verEdgeCongArray);
+}
+
+// RC metric from the (unsorted) horizontal and vertical
+// usage/capacity ratios. The arrays are sorted in place.
+float RouteBase::getRC(std::vector<double>& horEdgeCongArray,
+                       std::vector<double>& verEdgeCongArray) const
+{
+  double totalRouteOverflowH2 = 0;
+  double totalRouteOverflowV2 = 0;
+  int overflowTileCnt2 = 0;
+
+  for (double ratio : horEdgeCongArray) {
+    totalRouteOverflowH2 += fmax(0.0, -1 + ratio);
+    if (ratio > 1.0) {
+      overflowTileCnt2++;
+    }
+  }
+  for (double ratio : verEdgeCongArray) {
+    totalRouteOverflowV2 += fmax(0.0, -1 + ratio);
+    if (ratio > 1.0) {
+      overflowTileCnt2++;
+    }
+  }
+
   log_->info(GPL, 63, "TotalRouteOverflowH2: {}", totalRouteOverflowH2);
   log_->info(GPL, 64, "TotalRouteOverflowV2: {}", totalRouteOverflowV2);
   log_->info(GPL, 65, "OverflowTileCnt2: {}", overflowTileCnt2);
@@ -866,6 +917,203 @@ float RouteBase::getRC() const
   return finalRC;
 }
 
+/////////////////////////////////////////////
+// RUDY
+//
+// Rectangular Uniform wire DensitY: every net spreads
+// its HPWL uniformly over its bounding box. The estimate
+// is scaled per direction so its total demand matches
+// the router's wire usage at the last calibration.
+
+void RouteBase::initRudyTileGrid()
+{
+  tg_->setNumRoutingLayers(db_->getTech()->getRoutingLayerCount());
+  tg_->setLx(rudyTileLx_);
+  tg_->setLy(rudyTileLy_);
+  tg_->setTileSize(rudyTileSizeX_, rudyTileSizeY_);
+  tg_->setTileCnt(rudyTileCntX_, rudyTileCntY_);
+  tg_->initTiles();
+}
+
+// demand is in number of tracks per tile
+void RouteBase::computeRudyDemand(std::vector<float>& demandH,
+                                  std::vector<float>& demandV) const
+{
+  const int tileCnt = rudyTileCntX_ * rudyTileCntY_;
+  demandH.assign(tileCnt, 0);
+  demandV.assign(tileCnt, 0);
+
+  const int gridUx = rudyTileLx_ + rudyTileCntX_ * rudyTileSizeX_;
+  const int gridUy = rudyTileLy_ + rudyTileCntY_ * rudyTileSizeY_;
+
+  for (auto& gNet : nbc_->gNets()) {
+    if (gNet->gPins().size() < 2) {
+      continue;
+    }
+
+    const int lx = std::max(gNet->lx(), rudyTileLx_);
+    const int ly = std::max(gNet->ly(), rudyTileLy_);
+    const int ux = std::min(gNet->ux(), gridUx);
+    const int uy = std::min(gNet->uy(), gridUy);
+    if (lx > ux || ly > uy) {
+      continue;
+    }
+
+    const float w = gNet->ux() - gNet->lx();
+    const float h = gNet->uy() - gNet->ly();
+
+    const int minX = std::min((lx - rudyTileLx_) / rudyTileSizeX_,
+                              rudyTileCntX_ - 1);
+    const int maxX = std::min((ux - rudyTileLx_) / rudyTileSizeX_,
+                              rudyTileCntX_ - 1);
+    const int minY = std::min((ly - rudyTileLy_) / rudyTileSizeY_,
+                              rudyTileCntY_ - 1);
+    const int maxY = std::min((uy - rudyTileLy_) / rudyTileSizeY_,
+                              rudyTileCntY_ - 1);
+
+    for (int y = minY; y <= maxY; y++) {
+      const int tileLy = rudyTileLy_ + y * rudyTileSizeY_;
+      const float overlapY = std::min(uy, tileLy + rudyTileSizeY_)
+                             - std::max(ly, tileLy);
+      for (int x = minX; x <= maxX; x++) {
+        const int tileLx = rudyTileLx_ + x * rudyTileSizeX_;
+        const float overlapX = std::min(ux, tileLx + rudyTileSizeX_)
+                               - std::max(lx, tileLx);
+
+        // degenerated boxes (straight nets) take the full tile
+        // on the collapsed side.
+        const float fracY = (h == 0) ? 1.0f : overlapY / h;
+        const float fracX = (w == 0) ? 1.0f : overlapX / w;
+
+        const int idx = y * rudyTileCntX_ + x;
+        demandH[idx] += overlapX * fracY / rudyTileSizeX_;
+        demandV[idx] += overlapY * fracX / rudyTileSizeY_;
+      }
+    }
+  }
+}
+
+// Must be called right after getGlobalRouterResult(),
+// before the router resources are cleared.
+void RouteBase::calibrateRudy()
+{
+  odb::dbGCellGrid* gGrid = db_->getChip()->getBlock()->getGCellGrid();
+
+  rudyTileLx_ = tg_->lx();
+  rudyTileLy_ = tg_->ly();
+  rudyTileSizeX_ = tg_->tileSizeX();
+  rudyTileSizeY_ = tg_->tileSizeY();
+  rudyTileCntX_ = tg_->tileCntX();
+  rudyTileCntY_ = tg_->tileCntY();
+
+  const int tileCnt = rudyTileCntX_ * rudyTileCntY_;
+  rudyCapH_.assign(tileCnt, 0);
+  rudyCapV_.assign(tileCnt, 0);
+  rudyBlockH_.assign(tileCnt, 0);
+  rudyBlockV_.assign(tileCnt, 0);
+
+  double sumWireH = 0, sumWireV = 0;
+  for (int i = 1; i <= tg_->numRoutingLayers(); i++) {
+    odb::dbTechLayer* layer = db_->getTech()->findRoutingLayer(i);
+    bool isHorizontalLayer
+        = (layer->getDirection() == odb::dbTechLayerDir::HORIZONTAL);
+
+    std::vector<float>& cap = (isHorizontalLayer) ? rudyCapH_ : rudyCapV_;
+    std::vector<float>& block = (isHorizontalLayer) ? rudyBlockH_ : rudyBlockV_;
+    double& sumWire = (isHorizontalLayer) ? sumWireH : sumWireV;
+
+    for (auto& tile : tg_->tiles()) {
+      unsigned int capH = 0, capV = 0, capU = 0;
+      unsigned int useH = 0, useV = 0, useU = 0;
+      unsigned int blockH = 0, blockV = 0, blockU = 0;
+      gGrid->getCapacity(layer, tile->x(), tile->y(), capH, capV, capU);
+      gGrid->getUsage(layer, tile->x(), tile->y(), useH, useV, useU);
+      gGrid->getBlockage(layer, tile->x(), tile->y(), blockH, blockV, blockU);
+
+      unsigned int curCap = (isHorizontalLayer) ? capH : capV;
+      unsigned int curUse = (isHorizontalLayer) ? useH : useV;
+      unsigned int blockage = (isHorizontalLayer) ? blockH : blockV;
+
+      const int idx = tile->y() * rudyTileCntX_ + tile->x();
+      cap[idx] += curCap;
+      block[idx] += blockage;
+      // usage contains the blockage
+      sumWire += static_cast<double>(curUse) - blockage;
+    }
+  }
+
+  std::vector<float> demandH, demandV;
+  computeRudyDemand(demandH, demandV);
+
+  double sumDemandH = 0, sumDemandV = 0;
+  for (int i = 0; i < tileCnt; i++) {
+    sumDemandH += demandH[i];
+    sumDemandV += demandV[i];
+  }
+
+  rudyCalibH_ = (sumDemandH > 0) ? fmax(sumWireH, 0.0) / sumDemandH : 1.0;
+  rudyCalibV_ = (sumDemandV > 0) ? fmax(sumWireV, 0.0) / sumDemandV : 1.0;
+  isRudyCalibrated_ = true;
+
+  log_->info(GPL,
+             76,
+             "RUDY calibration factors H: {:.4f} V: {:.4f}",
+             rudyCalibH_,
+             rudyCalibV_);
+}
+
+// fill tg_ with the RUDY estimate, in the same way as updateRoute()
+void RouteBase::updateRudyRoute()
+{
+  initRudyTileGrid();
+
+  std::vector<float> demandH, demandV;
+  computeRudyDemand(demandH, demandV);
+
+  auto getRatio = [this](float cap, float block, float demand) {
+    if (cap == 0 || block / cap >= rbVars_.ignoreEdgeRatio) {
+      return std::numeric_limits<float>::lowest();
+    }
+    return (block + demand) / cap;
+  };
+
+  const int tileCnt = rudyTileCntX_ * rudyTileCntY_;
+  rudyRatioH_.resize(tileCnt);
+  rudyRatioV_.resize(tileCnt);
+  for (auto& tile : tg_->tiles()) {
+    const int idx = tile->y() * rudyTileCntX_ + tile->x();
+    rudyRatioH_[idx] = getRatio(
+        rudyCapH_[idx], rudyBlockH_[idx], rudyCalibH_ * demandH[idx]);
+    rudyRatioV_[idx] = getRatio(
+        rudyCapV_[idx], rudyBlockV_[idx], rudyCalibV_ * demandV[idx]);
+
+    float ratio = fmax(fmax(rudyRatioH_[idx], rudyRatioV_[idx]), 0.0f);
+
+    // update inflation Ratio
+    if (ratio >= rbVars_.minInflationRatio) {
+      float inflationRatio = pow(ratio, rbVars_.inflationRatioCoef);
+      inflationRatio = fmin(inflationRatio, rbVars_.maxInflationRatio);
+      tile->setInflationRatio(inflationRatio);
+    }
+  }
+}
+
+float RouteBase::getRudyRC() const
+{
+  std::vector<double> horEdgeCongArray;
+  std::vector<double> verEdgeCongArray;
+  for (size_t i = 0; i < rudyRatioH_.size(); i++) {
+    if (rudyRatioH_[i] >= 0.0f) {
+      horEdgeCongArray.push_back(rudyRatioH_[i]);
+    }
+    if (rudyRatioV_[i] >= 0.0f) {
+      verEdgeCongArray.push_back(rudyRatioV_[i]);
+    }
+  }
+
+  return getRC(horEdgeCongArray, verEdgeCongArray);
+}
+
 void RouteBase::increaseCounter()
 {
   numCall_++;
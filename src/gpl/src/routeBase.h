@@ -212,6 +212,12 @@ class RouteBaseVars
   int maxBloatIter;
   int maxInflationIter;
 
+  // Estimate congestion with RUDY between global router calls.
+  // The router only runs on every rudyCalibrationInterval-th routability
+  // call, where it also recalibrates the RUDY model.
+  bool useRudy;
+  int rudyCalibrationInterval;
+
   RouteBaseVars();
   void reset();
 };
@@ -245,6 +251,10 @@ class RouteBase
 
   float getRC() const;
 
+  // RUDY (Rectangular Uniform wire DensitY) congestion estimate
+  void updateRudyRoute();
+  float getRudyRC() const;
+
   void revertGCellSizeToMinRc();
 
  private:
@@ -273,6 +283,27 @@ class RouteBase
   int minRcViolatedCnt_;
   std::vector<std::pair<int, int>> minRcCellSize_;
 
+  // RUDY model state, refreshed at every global router calibration.
+  // Tile grid geometry is copied from the dbGCellGrid; capacities and
+  // blockages are summed over layers per routing direction.
+  bool isRudyCalibrated_;
+  int rudyTileLx_;
+  int rudyTileLy_;
+  int rudyTileSizeX_;
+  int rudyTileSizeY_;
+  int rudyTileCntX_;
+  int rudyTileCntY_;
+  std::vector<float> rudyCapH_;
+  std::vector<float> rudyCapV_;
+  std::vector<float> rudyBlockH_;
+  std::vector<float> rudyBlockV_;
+  // router usage / RUDY demand from the last calibration
+  float rudyCalibH_;
+  float rudyCalibV_;
+  // usage / capacity ratios per tile from the last updateRudyRoute()
+  std::vector<float> rudyRatioH_;
+  std::vector<float> rudyRatioV_;
+
   void init();
   void reset();
   void resetRoutabilityResources();
@@ -282,5 +313,15 @@ class RouteBase
 
   // routability funcs
   void initGCells();
+
+  // RUDY funcs
+  void calibrateRudy();
+  void initRudyTileGrid();
+  void computeRudyDemand(std::vector<float>& demandH,
+                         std::vector<float>& demandV) const;
+
+  // RC metric from per-edge usage/capacity ratios
+  float getRC(std::vector<double>& horEdgeCongArray,
+              std::vector<double>& verEdgeCongArray) const;
 };
 }  // namespace gpl
@@ -80,4 +80,37 @@ ResidualError cpuSparseSolve(int maxSolverIter,
   error.y = solver.error();
   return error;
 }
-}  // namespace gpl
\ No newline at end of file
+
+ResidualError cpuParallelSparseSolve(int maxSolverIter,
+                                     int iter,
+                                     int numThreads,
+                                     SMatrix& placeInstForceMatrixX,
+                                     Eigen::VectorXf& fixedInstForceVecX,
+                                     Eigen::VectorXf& instLocVecX,
+                                     SMatrix& placeInstForceMatrixY,
+                                     Eigen::VectorXf& fixedInstForceVecY,
+                                     Eigen::VectorXf& instLocVecY,
+                                     utl::Logger* logger)
+{
+  // Eigen's thread count is global; restore it for other users.
+  const int prevNumThreads = Eigen::nbThreads();
+  Eigen::setNbThreads(numThreads);
+
+  ResidualError error;
+  ConjugateGradient<SMatrix,
+                    Eigen::Lower | Eigen::Upper,
+                    DiagonalPreconditioner<float>>
+      solver;
+  solver.setMaxIterations(maxSolverIter);
+  solver.compute(placeInstForceMatrixX);
+  instLocVecX = solver.solveWithGuess(fixedInstForceVecX, instLocVecX);
+  error.x = solver.error();
+
+  solver.compute(placeInstForceMatrixY);
+  instLocVecY = solver.solveWithGuess(fixedInstForceVecY, instLocVecY);
+  error.y = solver.error();
+
+  Eigen::setNbThreads(prevNumThreads);
+  return error;
+}
+}  // namespace gpl
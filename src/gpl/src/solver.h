@@ -35,6 +35,7 @@
 
 #pragma once
 
+#include <Eigen/Core>
 #include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseCore>
 #include <memory>
@@ -60,6 +61,8 @@ struct ResidualError
 };
 
 using Eigen::BiCGSTAB;
+using Eigen::ConjugateGradient;
+using Eigen::DiagonalPreconditioner;
 using Eigen::IdentityPreconditioner;
 using utl::GPL;
 
@@ -85,4 +88,19 @@ ResidualError cpuSparseSolve(int maxSolverIter,
                              Eigen::VectorXf& fixedInstForceVecY,
                              Eigen::VectorXf& instLocVecY,
                              utl::Logger* logger);
+
+// Jacobi-preconditioned conjugate gradient.
+// The B2B matrices are symmetric, so CG applies and Eigen runs its
+// row-major SpMV on numThreads threads. Each row is computed by a
+// single thread, so the results do not depend on numThreads.
+ResidualError cpuParallelSparseSolve(int maxSolverIter,
+                                     int iter,
+                                     int numThreads,
+                                     SMatrix& placeInstForceMatrixX,
+                                     Eigen::VectorXf& fixedInstForceVecX,
+                                     Eigen::VectorXf& instLocVecX,
+                                     SMatrix& placeInstForceMatrixY,
+                                     Eigen::VectorXf& fixedInstForceVecY,
+                                     Eigen::VectorXf& instLocVecY,
+                                     utl::Logger* logger);
 }  // namespace gpl
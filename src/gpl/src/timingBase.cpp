@@ -49,7 +49,12 @@ using utl::GPL;
 
 // TimingBase
 TimingBase::TimingBase()
-    : rs_(nullptr), log_(nullptr), nbc_(nullptr), net_weight_max_(1.9)
+    : rs_(nullptr),
+      log_(nullptr),
+      nbc_(nullptr),
+      net_weight_max_(1.9),
+      incrementalMode_(false),
+      moveThreshold_(0)
 {
 }
 
@@ -145,9 +150,87 @@ void TimingBase::setTimingNetWeightMax(float max)
   net_weight_max_ = max;
 }
 
+void TimingBase::setIncrementalMode(bool mode)
+{
+  incrementalMode_ = mode;
+}
+
+void TimingBase::setIncrementalMoveThreshold(int threshold)
+{
+  moveThreshold_ = threshold;
+}
+
+void TimingBase::saveEstimatedPinLoc()
+{
+  estimatedPinLoc_.clear();
+  for (auto& gNet : nbc_->gNets()) {
+    for (auto& gPin : gNet->gPins()) {
+      estimatedPinLoc_.emplace_back(gPin->cx(), gPin->cy());
+    }
+  }
+}
+
+// nets with at least one pin displaced beyond moveThreshold_.
+// Their saved pin locations are refreshed, so slow drifts still
+// add up until they trigger a re-estimate.
+void TimingBase::findMovedNets(std::vector<GNet*>& movedNets)
+{
+  size_t pinIdx = 0;
+  for (auto& gNet : nbc_->gNets()) {
+    const size_t netPinBegin = pinIdx;
+    bool isMoved = false;
+    for (auto& gPin : gNet->gPins()) {
+      const std::pair<int, int>& loc = estimatedPinLoc_[pinIdx++];
+      const int64_t dist
+          = std::abs(static_cast<int64_t>(gPin->cx()) - loc.first)
+            + std::abs(static_cast<int64_t>(gPin->cy()) - loc.second);
+      if (dist > moveThreshold_) {
+        isMoved = true;
+      }
+    }
+
+    if (!isMoved || gNet->gPins().size() < 2) {
+      continue;
+    }
+
+    movedNets.push_back(gNet);
+    pinIdx = netPinBegin;
+    for (auto& gPin : gNet->gPins()) {
+      estimatedPinLoc_[pinIdx++] = std::make_pair(gPin->cx(), gPin->cy());
+    }
+  }
+}
+
 bool TimingBase::updateGNetWeights(float overflow)
 {
-  rs_->findResizeSlacks();
+  if (incrementalMode_ && !estimatedPinLoc_.empty()) {
+    std::vector<GNet*> movedNets;
+    findMovedNets(movedNets);
+
+    // previous weights are still valid.
+    if (movedNets.empty()) {
+      log_->info(GPL, 106, "No nets moved. Keeping the previous net weights.");
+      return true;
+    }
+
+    log_->info(GPL,
+               105,
+               "Re-estimating parasitics of {} / {} nets.",
+               movedNets.size(),
+               nbc_->gNets().size());
+
+    std::vector<odb::dbNet*> movedDbNets;
+    movedDbNets.reserve(movedNets.size());
+    for (auto& gNet : movedNets) {
+      movedDbNets.push_back(gNet->net()->dbNet());
+    }
+    rs_->findResizeSlacks(movedDbNets);
+  } else {
+    rs_->findResizeSlacks();
+    if (incrementalMode_) {
+      saveEstimatedPinLoc();
+    }
+  }
 
   // get worst resize nets
   sta::NetSeq& worst_slack_nets = rs_->resizeWorstSlackNets();
@@ -34,6 +34,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace rsz {
@@ -67,6 +68,12 @@ class TimingBase
 
   void setTimingNetWeightMax(float overflow);
 
+  // Incremental reweighting: after the first full update, only the nets
+  // with a pin that moved more than moveThreshold (DBU, manhattan) since
+  // its last estimate get their parasitics re-estimated.
+  void setIncrementalMode(bool mode);
+  void setIncrementalMoveThreshold(int threshold);
+
   // updateNetWeight.
   // True: successfully reweighted gnets
   // False: no slacks found
@@ -80,7 +87,16 @@ class TimingBase
   std::vector<int> timingNetWeightOverflow_;
   std::vector<int> timingOverflowChk_;
   float net_weight_max_;
+
+  bool incrementalMode_;
+  int moveThreshold_;
+  // pin locations at their nets' last parasitics estimate,
+  // flattened in gNets() / gPins() order.
+  std::vector<std::pair<int, int>> estimatedPinLoc_;
+
   void initTimingOverflowChk();
+  void findMovedNets(std::vector<GNet*>& movedNets);
+  void saveEstimatedPinLoc();
 };
 
 }  // namespace gpl
@@ -98,6 +98,7 @@ class AbstractFastRouteRenderer;
 class GlobalRouter;
 class AbstractRoutingCongestionDataSource;
 class GRouteDbCbk;
+struct DirtyRegionIndex;
 
 struct RegionAdjustment
 {
@@ -169,6 +170,8 @@ class GlobalRouter
                            float reduction_percentage);
   void setVerbose(const bool v);
   void setOverflowIterations(int iterations);
+  void setMazeThreads(int threads);
+  void setMazeRadixHeap(bool radix_heap);
   void setCongestionReportFile(const char* file_name);
   void setGridOrigin(int x, int y);
   void setAllowCongestion(bool allow_congestion);
@@ -206,6 +209,9 @@ class GlobalRouter
   // Incremental global routing functions.
   // See class IncrementalGRoute.
   void addDirtyNet(odb::dbNet* net);
+  // Marks an area whose gcell capacities must be computed again
+  // before the next incremental update.
+  void addDirtyRegion(const odb::Rect& region);
   std::set<odb::dbNet*> getDirtyNets() { return dirty_nets_; }
   // check_antennas
   void makeNetWires();
@@ -285,6 +291,11 @@ class GlobalRouter
   void computeUserGlobalAdjustments(int min_routing_layer,
                                     int max_routing_layer);
   void computeUserLayerAdjustments(int max_routing_layer);
+  void applyLayerAdjustment(int x,
+                            int y,
+                            int layer,
+                            float adjustment,
+                            bool horizontal);
   void computeRegionAdjustments(const odb::Rect& region,
                                 int layer,
                                 float reduction_percentage);
@@ -348,6 +359,13 @@ class GlobalRouter
 
   // incremental funcions
   void updateDirtyRoutes();
+  void updateDirtyCapacities();
+  odb::Rect rectToTiles(const odb::Rect& rect, int margin);
+  void mergeTileWindows(std::vector<odb::Rect>& tile_windows);
+  odb::Rect tileWindowToDbu(const odb::Rect& window, int margin);
+  void buildDirtyRegionIndex();
+  void clearDirtyRegionIndex();
+  void updateInstIndex(odb::dbInst* inst, bool insert);
   void mergeResults(NetRouteMap& routes);
   void updateDirtyNets(std::vector<Net*>& dirty_nets);
   void updateDbCongestion();
@@ -371,6 +389,10 @@ class GlobalRouter
       int top_layer);
   int findInstancesObstructions(odb::Rect& die_area,
                                 const std::vector<int>& layer_extensions);
+  int findInstanceObstructions(odb::dbInst* inst,
+                               odb::Rect& die_area,
+                               const std::vector<int>& layer_extensions,
+                               int& pin_out_of_die_count);
   void findNetsObstructions(odb::Rect& die_area);
   int computeMaxRoutingLayer();
   std::map<int, odb::dbTechVia*> getDefaultVias(int max_routing_layer);
@@ -405,6 +427,8 @@ class GlobalRouter
   int layer_for_guide_dimension_;
   int gcells_offset_;
   int overflow_iterations_;
+  int maze_threads_;
+  bool maze_radix_heap_;
   bool allow_congestion_;
   std::vector<int> vertical_capacities_;
   std::vector<int> horizontal_capacities_;
@@ -435,6 +459,13 @@ class GlobalRouter
   odb::dbBlock* block_;
 
   std::set<odb::dbNet*> dirty_nets_;
+  // areas of moved, resized, added or removed instances
+  std::vector<odb::Rect> dirty_regions_;
+  // blockages and net wires, kept to rebuild the capacities of dirty regions
+  std::vector<std::pair<odb::Rect, odb::dbTechLayer*>> fixed_obstructions_;
+  // instances and fixed obstructions by location, kept while the db
+  // callbacks of the incremental router are registered
+  std::unique_ptr<DirtyRegionIndex> dirty_region_index_;
 
   RepairAntennas* repair_antennas_;
   std::unique_ptr<AbstractRoutingCongestionDataSource> heatmap_;
@@ -457,7 +488,13 @@ class GRouteDbCbk : public odb::dbBlockCallBackObj
 {
  public:
   GRouteDbCbk(GlobalRouter* grouter);
+  virtual void inDbInstCreate(odb::dbInst* inst);
+  virtual void inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region);
+  virtual void inDbInstDestroy(odb::dbInst* inst);
+  virtual void inDbPreMoveInst(odb::dbInst* inst);
   virtual void inDbPostMoveInst(odb::dbInst* inst);
+  virtual void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                        odb::dbMaster* master);
   virtual void inDbInstSwapMasterAfter(odb::dbInst* inst);
 
   virtual void inDbNetDestroy(odb::dbNet* net);
@@ -471,6 +508,7 @@ class GRouteDbCbk : public odb::dbBlockCallBackObj
 
  private:
   void instItermsDirty(odb::dbInst* inst);
+  void instRegionDirty(odb::dbInst* inst);
 
   GlobalRouter* grouter_;
 };
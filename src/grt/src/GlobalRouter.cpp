@@ -36,12 +36,15 @@
 #include "grt/GlobalRouter.h"
 
 #include <algorithm>
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/icl/interval.hpp>
 #include <cmath>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <istream>
+#include <limits>
 #include <random>
 #include <set>
 #include <sstream>
@@ -77,6 +80,25 @@ namespace grt {
 using boost::icl::interval;
 using utl::GRT;
 
+struct DirtyRegionIndex
+{
+  typedef bg::model::point<int, 2, bg::cs::cartesian> point;
+  typedef bg::model::box<point> box;
+  typedef bgi::rtree<std::pair<box, odb::dbInst*>, bgi::quadratic<16>>
+      inst_tree;
+  // the values are positions in fixed_obstructions_
+  typedef bgi::rtree<std::pair<box, int>, bgi::quadratic<16>> obs_tree;
+
+  static box toBox(const odb::Rect& rect)
+  {
+    return box(point(rect.xMin(), rect.yMin()),
+               point(rect.xMax(), rect.yMax()));
+  }
+
+  inst_tree insts;
+  obs_tree obstructions;
+};
+
 GlobalRouter::GlobalRouter()
     : logger_(nullptr),
       stt_builder_(nullptr),
@@ -93,6 +115,8 @@ GlobalRouter::GlobalRouter()
       layer_for_guide_dimension_(3),
       gcells_offset_(2),
       overflow_iterations_(50),
+      maze_threads_(1),
+      maze_radix_heap_(false),
       allow_congestion_(false),
       macro_extension_(0),
       verbose_(false),
@@ -149,6 +173,9 @@ void GlobalRouter::clear()
   fastroute_->clear();
   vertical_capacities_.clear();
   horizontal_capacities_.clear();
+  dirty_regions_.clear();
+  fixed_obstructions_.clear();
+  clearDirtyRegionIndex();
 }
 
 GlobalRouter::~GlobalRouter()
@@ -172,6 +199,8 @@ std::vector<Net*> GlobalRouter::initFastRoute(int min_routing_layer,
 
   fastroute_->setVerbose(verbose_);
   fastroute_->setOverflowIterations(overflow_iterations_);
+  fastroute_->setMazeThreads(maze_threads_);
+  fastroute_->setMazeRadixHeap(maze_radix_heap_);
 
   initRoutingLayers();
   reportLayerSettings(min_routing_layer, max_routing_layer);
@@ -193,6 +222,7 @@ void GlobalRouter::applyAdjustments(int min_routing_layer,
   fastroute_->initEdges();
   computeGridAdjustments(min_routing_layer, max_routing_layer);
   computeTrackAdjustments(min_routing_layer, max_routing_layer);
+  fastroute_->saveBaseCapacities();
   computeObstructionsAdjustments();
   std::vector<int> track_space = grid_->getMinWidths();
   fastroute_->initBlockedIntervals(track_space);
@@ -1190,15 +1220,7 @@ void GlobalRouter::computeUserLayerAdjustments(int max_routing_layer)
 
         for (int y = 1; y < y_grids; y++) {
           for (int x = 1; x < x_grids; x++) {
-            int edge_cap
-                = fastroute_->getEdgeCapacity(x - 1, y - 1, x, y - 1, layer);
-            int new_h_capacity
-                = std::floor((float) edge_cap * (1 - adjustment));
-            new_h_capacity = edge_cap > 0 && adjustment != 1
-                                 ? std::max(new_h_capacity, 1)
-                                 : new_h_capacity;
-            fastroute_->addAdjustment(
-                x - 1, y - 1, x, y - 1, layer, new_h_capacity, true);
+            applyLayerAdjustment(x - 1, y - 1, layer, adjustment, true);
           }
         }
       }
@@ -1210,15 +1232,7 @@ void GlobalRouter::computeUserLayerAdjustments(int max_routing_layer)
 
         for (int x = 1; x < x_grids; x++) {
           for (int y = 1; y < y_grids; y++) {
-            int edge_cap
-                = fastroute_->getEdgeCapacity(x - 1, y - 1, x - 1, y, layer);
-            int new_v_capacity
-                = std::floor((float) edge_cap * (1 - adjustment));
-            new_v_capacity = edge_cap > 0 && adjustment != 1
-                                 ? std::max(new_v_capacity, 1)
-                                 : new_v_capacity;
-            fastroute_->addAdjustment(
-                x - 1, y - 1, x - 1, y, layer, new_v_capacity, true);
+            applyLayerAdjustment(x - 1, y - 1, layer, adjustment, false);
           }
         }
       }
@@ -1226,6 +1240,21 @@ void GlobalRouter::computeUserLayerAdjustments(int max_routing_layer)
   }
 }
 
+void GlobalRouter::applyLayerAdjustment(const int x,
+                                        const int y,
+                                        const int layer,
+                                        const float adjustment,
+                                        const bool horizontal)
+{
+  const int x2 = horizontal ? x + 1 : x;
+  const int y2 = horizontal ? y : y + 1;
+  int edge_cap = fastroute_->getEdgeCapacity(x, y, x2, y2, layer);
+  int new_capacity = std::floor((float) edge_cap * (1 - adjustment));
+  new_capacity = edge_cap > 0 && adjustment != 1 ? std::max(new_capacity, 1)
+                                                 : new_capacity;
+  fastroute_->addAdjustment(x, y, x2, y2, layer, new_capacity, true);
+}
+
 void GlobalRouter::computeRegionAdjustments(const odb::Rect& region,
                                             int layer,
                                             float reduction_percentage)
@@ -1397,6 +1426,16 @@ void GlobalRouter::setOverflowIterations(int iterations)
   overflow_iterations_ = iterations;
 }
 
+void GlobalRouter::setMazeThreads(int threads)
+{
+  maze_threads_ = threads;
+}
+
+void GlobalRouter::setMazeRadixHeap(bool radix_heap)
+{
+  maze_radix_heap_ = radix_heap;
+}
+
 void GlobalRouter::setCongestionReportFile(const char* file_name)
 {
   congestion_file_name_ = file_name;
@@ -3035,6 +3074,8 @@ void GlobalRouter::computeObstructionsAdjustments()
       grid_->getXMin(), grid_->getYMin(), grid_->getXMax(), grid_->getYMax());
   std::vector<int> layer_extensions;
 
+  fixed_obstructions_.clear();
+  clearDirtyRegionIndex();
   findLayerExtensions(layer_extensions);
   int obstructions_cnt = findObstructions(die_area);
   obstructions_cnt += findInstancesObstructions(die_area, layer_extensions);
@@ -3114,6 +3155,8 @@ int GlobalRouter::findObstructions(odb::Rect& die_area)
       }
       applyObstructionAdjustment(obstruction_rect,
                                  obstruction_box->getTechLayer());
+      fixed_obstructions_.emplace_back(obstruction_rect,
+                                       obstruction_box->getTechLayer());
       obstructions_cnt++;
     }
   }
@@ -3211,126 +3254,135 @@ int GlobalRouter::findInstancesObstructions(
   int macros_cnt = 0;
   int obstructions_cnt = 0;
   int pin_out_of_die_count = 0;
-  odb::dbTech* tech = db_->getTech();
   for (odb::dbInst* inst : block_->getInsts()) {
-    int pX, pY;
+    if (inst->getMaster()->isBlock()) {
+      macros_cnt++;
+    }
+    obstructions_cnt += findInstanceObstructions(
+        inst, die_area, layer_extensions, pin_out_of_die_count);
+  }
+
+  if (pin_out_of_die_count > 0) {
+    if (verbose_)
+      logger_->warn(
+          GRT, 28, "Found {} pins outside die area.", pin_out_of_die_count);
+  }
 
-    odb::dbMaster* master = inst->getMaster();
+  if (verbose_)
+    logger_->info(GRT, 3, "Macros: {}", macros_cnt);
+  return obstructions_cnt;
+}
 
-    inst->getOrigin(pX, pY);
-    odb::Point origin = odb::Point(pX, pY);
+int GlobalRouter::findInstanceObstructions(
+    odb::dbInst* inst,
+    odb::Rect& die_area,
+    const std::vector<int>& layer_extensions,
+    int& pin_out_of_die_count)
+{
+  int obstructions_cnt = 0;
+  odb::dbTech* tech = db_->getTech();
+  int pX, pY;
 
-    odb::dbTransform transform(inst->getOrient(), origin);
+  odb::dbMaster* master = inst->getMaster();
 
-    bool isMacro = false;
-    if (master->isBlock()) {
-      macros_cnt++;
-      isMacro = true;
-    }
+  inst->getOrigin(pX, pY);
+  odb::Point origin = odb::Point(pX, pY);
 
-    if (isMacro) {
-      std::unordered_map<int, odb::Rect> macro_obs_per_layer;
-      int bottom_layer = std::numeric_limits<int>::max();
-      int top_layer = std::numeric_limits<int>::min();
+  odb::dbTransform transform(inst->getOrient(), origin);
 
-      for (odb::dbBox* box : master->getObstructions()) {
-        int layer = box->getTechLayer()->getRoutingLevel();
-        if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
-          odb::Rect rect = box->getBox();
-          transform.apply(rect);
+  if (master->isBlock()) {
+    std::unordered_map<int, odb::Rect> macro_obs_per_layer;
+    int bottom_layer = std::numeric_limits<int>::max();
+    int top_layer = std::numeric_limits<int>::min();
 
-          if (macro_obs_per_layer.find(layer) == macro_obs_per_layer.end()) {
-            macro_obs_per_layer[layer] = rect;
-          } else {
-            macro_obs_per_layer[layer].merge(rect);
-          }
-          obstructions_cnt++;
+    for (odb::dbBox* box : master->getObstructions()) {
+      int layer = box->getTechLayer()->getRoutingLevel();
+      if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
+        odb::Rect rect = box->getBox();
+        transform.apply(rect);
 
-          bottom_layer = std::min(bottom_layer, layer);
-          top_layer = std::max(top_layer, layer);
+        if (macro_obs_per_layer.find(layer) == macro_obs_per_layer.end()) {
+          macro_obs_per_layer[layer] = rect;
+        } else {
+          macro_obs_per_layer[layer].merge(rect);
         }
+        obstructions_cnt++;
+
+        bottom_layer = std::min(bottom_layer, layer);
+        top_layer = std::max(top_layer, layer);
       }
+    }
 
-      extendObstructions(macro_obs_per_layer, bottom_layer, top_layer);
+    extendObstructions(macro_obs_per_layer, bottom_layer, top_layer);
 
-      for (auto& [layer, obs] : macro_obs_per_layer) {
-        int layer_extension = layer_extensions[layer];
-        layer_extension += macro_extension_ * grid_->getTileSize();
-        obs.set_xlo(obs.xMin() - layer_extension);
-        obs.set_ylo(obs.yMin() - layer_extension);
-        obs.set_xhi(obs.xMax() + layer_extension);
-        obs.set_yhi(obs.yMax() + layer_extension);
-        applyObstructionAdjustment(obs, tech->findRoutingLayer(layer));
-      }
-    } else {
-      for (odb::dbBox* box : master->getObstructions()) {
-        int layer = box->getTechLayer()->getRoutingLevel();
-        if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
-          odb::Rect rect = box->getBox();
-          transform.apply(rect);
-
-          odb::Point lower_bound = odb::Point(rect.xMin(), rect.yMin());
-          odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
-          odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
-          if (!die_area.contains(obstruction_rect)) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            38,
-                            "Found blockage outside die area in instance {}.",
-                            inst->getConstName());
-          }
-          applyObstructionAdjustment(obstruction_rect, box->getTechLayer());
-          obstructions_cnt++;
+    for (auto& [layer, obs] : macro_obs_per_layer) {
+      int layer_extension = layer_extensions[layer];
+      layer_extension += macro_extension_ * grid_->getTileSize();
+      obs.set_xlo(obs.xMin() - layer_extension);
+      obs.set_ylo(obs.yMin() - layer_extension);
+      obs.set_xhi(obs.xMax() + layer_extension);
+      obs.set_yhi(obs.yMax() + layer_extension);
+      applyObstructionAdjustment(obs, tech->findRoutingLayer(layer));
+    }
+  } else {
+    for (odb::dbBox* box : master->getObstructions()) {
+      int layer = box->getTechLayer()->getRoutingLevel();
+      if (min_routing_layer_ <= layer && layer <= max_routing_layer_) {
+        odb::Rect rect = box->getBox();
+        transform.apply(rect);
+
+        odb::Point lower_bound = odb::Point(rect.xMin(), rect.yMin());
+        odb::Point upper_bound = odb::Point(rect.xMax(), rect.yMax());
+        odb::Rect obstruction_rect = odb::Rect(lower_bound, upper_bound);
+        if (!die_area.contains(obstruction_rect)) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          38,
+                          "Found blockage outside die area in instance {}.",
+                          inst->getConstName());
         }
+        applyObstructionAdjustment(obstruction_rect, box->getTechLayer());
+        obstructions_cnt++;
       }
     }
+  }
 
-    for (odb::dbMTerm* mterm : master->getMTerms()) {
-      for (odb::dbMPin* mpin : mterm->getMPins()) {
-        odb::Point lower_bound;
-        odb::Point upper_bound;
-        odb::Rect pin_box;
-        int pin_layer;
+  for (odb::dbMTerm* mterm : master->getMTerms()) {
+    for (odb::dbMPin* mpin : mterm->getMPins()) {
+      odb::Point lower_bound;
+      odb::Point upper_bound;
+      odb::Rect pin_box;
+      int pin_layer;
 
-        for (odb::dbBox* box : mpin->getGeometry()) {
-          odb::Rect rect = box->getBox();
-          transform.apply(rect);
+      for (odb::dbBox* box : mpin->getGeometry()) {
+        odb::Rect rect = box->getBox();
+        transform.apply(rect);
 
-          odb::dbTechLayer* tech_layer = box->getTechLayer();
-          if (!tech_layer
-              || tech_layer->getType() != odb::dbTechLayerType::ROUTING) {
-            continue;
-          }
+        odb::dbTechLayer* tech_layer = box->getTechLayer();
+        if (!tech_layer
+            || tech_layer->getType() != odb::dbTechLayerType::ROUTING) {
+          continue;
+        }
 
-          pin_layer = tech_layer->getRoutingLevel();
-          if (min_routing_layer_ <= pin_layer
-              && pin_layer <= max_routing_layer_) {
-            lower_bound = odb::Point(rect.xMin(), rect.yMin());
-            upper_bound = odb::Point(rect.xMax(), rect.yMax());
-            pin_box = odb::Rect(lower_bound, upper_bound);
-            if (!die_area.contains(pin_box)) {
-              logger_->error(GRT,
-                             39,
-                             "Found pin {} outside die area in instance {}.",
-                             mterm->getConstName(),
-                             inst->getConstName());
-              pin_out_of_die_count++;
-            }
-            applyObstructionAdjustment(pin_box, box->getTechLayer());
+        pin_layer = tech_layer->getRoutingLevel();
+        if (min_routing_layer_ <= pin_layer && pin_layer <= max_routing_layer_) {
+          lower_bound = odb::Point(rect.xMin(), rect.yMin());
+          upper_bound = odb::Point(rect.xMax(), rect.yMax());
+          pin_box = odb::Rect(lower_bound, upper_bound);
+          if (!die_area.contains(pin_box)) {
+            logger_->error(GRT,
+                           39,
+                           "Found pin {} outside die area in instance {}.",
+                           mterm->getConstName(),
+                           inst->getConstName());
+            pin_out_of_die_count++;
           }
+          applyObstructionAdjustment(pin_box, box->getTechLayer());
         }
       }
     }
   }
 
-  if (pin_out_of_die_count > 0) {
-    if (verbose_)
-      logger_->warn(
-          GRT, 28, "Found {} pins outside die area.", pin_out_of_die_count);
-  }
-
-  if (verbose_)
-    logger_->info(GRT, 3, "Macros: {}", macros_cnt);
   return obstructions_cnt;
 }
 
@@ -3371,6 +3423,8 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
                                 db_net->getConstName());
               }
               applyObstructionAdjustment(obstruction_rect, s->getTechLayer());
+              fixed_obstructions_.emplace_back(obstruction_rect,
+                                               s->getTechLayer());
             }
           }
         }
@@ -3404,6 +3458,8 @@ void GlobalRouter::findNetsObstructions(odb::Rect& die_area)
               }
               applyObstructionAdjustment(obstruction_rect,
                                          pshape.shape.getTechLayer());
+              fixed_obstructions_.emplace_back(obstruction_rect,
+                                               pshape.shape.getTechLayer());
             }
           }
         }
@@ -3920,6 +3976,8 @@ IncrementalGRoute::~IncrementalGRoute()
   // don't bother updating it.
   // groute_->updateDbCongestion();
   db_cbk_.removeOwner();
+  // without the callbacks the index can not follow the db
+  groute_->clearDirtyRegionIndex();
 }
 
 void GlobalRouter::setRenderer(
@@ -3937,8 +3995,246 @@ void GlobalRouter::addDirtyNet(odb::dbNet* net)
   dirty_nets_.insert(net);
 }
 
+void GlobalRouter::addDirtyRegion(const odb::Rect& region)
+{
+  dirty_regions_.push_back(region);
+}
+
+// Converts a rect in dbu to the range of gcells it covers, extended by
+// margin gcells and clamped to the grid.
+odb::Rect GlobalRouter::rectToTiles(const odb::Rect& rect, const int margin)
+{
+  const int tile_size = grid_->getTileSize();
+  const int x_max = grid_->getXGrids() - 1;
+  const int y_max = grid_->getYGrids() - 1;
+  auto clamp = [](int value, int max) { return std::clamp(value, 0, max); };
+  return odb::Rect(
+      clamp((rect.xMin() - grid_->getXMin()) / tile_size - margin, x_max),
+      clamp((rect.yMin() - grid_->getYMin()) / tile_size - margin, y_max),
+      clamp((rect.xMax() - grid_->getXMin()) / tile_size + margin, x_max),
+      clamp((rect.yMax() - grid_->getYMin()) / tile_size + margin, y_max));
+}
+
+// Converts a range of gcells back to dbu, extended by margin dbu. Windows
+// touching the border of the grid also cover everything outside of it, as
+// rectToTiles clamps those shapes to the border gcells.
+odb::Rect GlobalRouter::tileWindowToDbu(const odb::Rect& window,
+                                        const int margin)
+{
+  const int tile_size = grid_->getTileSize();
+  const int x_max = grid_->getXGrids() - 1;
+  const int y_max = grid_->getYGrids() - 1;
+  const int lowest = std::numeric_limits<int>::min();
+  const int highest = std::numeric_limits<int>::max();
+  return odb::Rect(
+      window.xMin() == 0
+          ? lowest
+          : grid_->getXMin() + window.xMin() * tile_size - margin,
+      window.yMin() == 0
+          ? lowest
+          : grid_->getYMin() + window.yMin() * tile_size - margin,
+      window.xMax() == x_max
+          ? highest
+          : grid_->getXMin() + (window.xMax() + 1) * tile_size + margin,
+      window.yMax() == y_max
+          ? highest
+          : grid_->getYMin() + (window.yMax() + 1) * tile_size + margin);
+}
+
+// Replaces overlapping windows by their bounding box until the windows are
+// disjoint. The merged windows can cover more gcells than the originals,
+// which only costs recomputing gcells that did not change.
+void GlobalRouter::mergeTileWindows(std::vector<odb::Rect>& tile_windows)
+{
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < tile_windows.size(); i++) {
+      for (size_t j = i + 1; j < tile_windows.size();) {
+        if (tile_windows[i].overlaps(tile_windows[j])) {
+          tile_windows[i].merge(tile_windows[j]);
+          tile_windows[j] = tile_windows.back();
+          tile_windows.pop_back();
+          merged = true;
+        } else {
+          j++;
+        }
+      }
+    }
+  }
+}
+
+void GlobalRouter::buildDirtyRegionIndex()
+{
+  dirty_region_index_ = std::make_unique<DirtyRegionIndex>();
+
+  std::vector<std::pair<DirtyRegionIndex::box, odb::dbInst*>> insts;
+  insts.reserve(block_->getInsts().size());
+  for (odb::dbInst* inst : block_->getInsts()) {
+    insts.emplace_back(
+        DirtyRegionIndex::toBox(inst->getBBox()->getBox()), inst);
+  }
+  // the packing constructor builds a better tree than inserting one by one
+  dirty_region_index_->insts = DirtyRegionIndex::inst_tree(insts);
+
+  std::vector<std::pair<DirtyRegionIndex::box, int>> obstructions;
+  obstructions.reserve(fixed_obstructions_.size());
+  for (int i = 0; i < static_cast<int>(fixed_obstructions_.size()); i++) {
+    obstructions.emplace_back(
+        DirtyRegionIndex::toBox(fixed_obstructions_[i].first), i);
+  }
+  dirty_region_index_->obstructions = DirtyRegionIndex::obs_tree(obstructions);
+}
+
+void GlobalRouter::clearDirtyRegionIndex()
+{
+  dirty_region_index_.reset();
+}
+
+// Called by the db callbacks before an instance changes and after it, so
+// the box in the index is always the one the instance had when inserted.
+void GlobalRouter::updateInstIndex(odb::dbInst* inst, const bool insert)
+{
+  if (dirty_region_index_ == nullptr) {
+    return;
+  }
+  auto value = std::make_pair(
+      DirtyRegionIndex::toBox(inst->getBBox()->getBox()), inst);
+  if (insert) {
+    dirty_region_index_->insts.insert(value);
+  } else {
+    dirty_region_index_->insts.remove(value);
+  }
+}
+
+// Computes again the capacities of the gcells around the dirty regions.
+// The gcells go back to the capacities before the obstructions and the
+// shapes touching them are applied again, in the same order used by
+// applyAdjustments.
+void GlobalRouter::updateDirtyCapacities()
+{
+  if (dirty_regions_.empty()) {
+    return;
+  }
+  if (!fastroute_->hasBaseCapacities()) {
+    // capacities were not computed by this router yet
+    dirty_regions_.clear();
+    return;
+  }
+
+  std::vector<int> layer_extensions;
+  findLayerExtensions(layer_extensions);
+  const int max_extension
+      = *std::max_element(layer_extensions.begin(), layer_extensions.end())
+        + macro_extension_ * grid_->getTileSize();
+
+  std::vector<odb::Rect> tile_windows;
+  tile_windows.reserve(dirty_regions_.size());
+  for (odb::Rect region : dirty_regions_) {
+    region.bloat(max_extension, region);
+    tile_windows.push_back(rectToTiles(region, 1));
+  }
+  dirty_regions_.clear();
+  mergeTileWindows(tile_windows);
+
+  debugPrint(logger_,
+             GRT,
+             "incr",
+             1,
+             "Updating capacities of {} dirty windows.",
+             tile_windows.size());
+
+  if (dirty_region_index_ == nullptr) {
+    buildDirtyRegionIndex();
+  }
+
+  fastroute_->beginAdjustmentUpdate(tile_windows);
+
+  // The shapes touching a window are found in the index, with the same
+  // margins rectToTiles adds, and applied in their original order.
+  const int tile_size = grid_->getTileSize();
+  std::vector<int> obstructions;
+  std::vector<odb::dbInst*> insts;
+  for (const odb::Rect& window : tile_windows) {
+    const DirtyRegionIndex::box obs_query
+        = DirtyRegionIndex::toBox(tileWindowToDbu(window, tile_size));
+    for (auto it = dirty_region_index_->obstructions.qbegin(
+             bgi::intersects(obs_query));
+         it != dirty_region_index_->obstructions.qend();
+         ++it) {
+      obstructions.push_back(it->second);
+    }
+    const DirtyRegionIndex::box inst_query = DirtyRegionIndex::toBox(
+        tileWindowToDbu(window, tile_size + max_extension));
+    for (auto it
+         = dirty_region_index_->insts.qbegin(bgi::intersects(inst_query));
+         it != dirty_region_index_->insts.qend();
+         ++it) {
+      insts.push_back(it->second);
+    }
+  }
+  // the windows are disjoint but a shape can touch more than one
+  std::sort(obstructions.begin(), obstructions.end());
+  obstructions.erase(std::unique(obstructions.begin(), obstructions.end()),
+                     obstructions.end());
+  auto inst_less = [](odb::dbInst* inst1, odb::dbInst* inst2) {
+    return inst1->getId() < inst2->getId();
+  };
+  std::sort(insts.begin(), insts.end(), inst_less);
+  insts.erase(std::unique(insts.begin(), insts.end()), insts.end());
+
+  for (const int obstruction : obstructions) {
+    const auto& [rect, layer] = fixed_obstructions_[obstruction];
+    applyObstructionAdjustment(rect, layer);
+  }
+
+  odb::Rect die_area(
+      grid_->getXMin(), grid_->getYMin(), grid_->getXMax(), grid_->getYMax());
+  int pin_out_of_die_count = 0;
+  for (odb::dbInst* inst : insts) {
+    findInstanceObstructions(
+        inst, die_area, layer_extensions, pin_out_of_die_count);
+  }
+
+  std::vector<int> track_space = grid_->getMinWidths();
+  fastroute_->initBlockedIntervals(track_space);
+
+  const int x_grids = grid_->getXGrids();
+  const int y_grids = grid_->getYGrids();
+  for (int layer = 1; layer <= max_routing_layer_; layer++) {
+    const float adjustment = adjustments_[layer];
+    if (adjustment == 0) {
+      continue;
+    }
+    // the windows can overlap, so use the gcells marked by fastroute
+    for (const odb::Point& tile : fastroute_->getAdjustableTiles()) {
+      if (tile.x() >= x_grids - 1 || tile.y() >= y_grids - 1) {
+        continue;
+      }
+      if (horizontal_capacities_[layer - 1] != 0) {
+        applyLayerAdjustment(tile.x(), tile.y(), layer, adjustment, true);
+      }
+      if (vertical_capacities_[layer - 1] != 0) {
+        applyLayerAdjustment(tile.x(), tile.y(), layer, adjustment, false);
+      }
+    }
+  }
+
+  computePinOffsetAdjustments();
+
+  for (RegionAdjustment region_adjustment : region_adjustments_) {
+    computeRegionAdjustments(region_adjustment.getRegion(),
+                             region_adjustment.getLayer(),
+                             region_adjustment.getAdjustment());
+  }
+
+  fastroute_->endAdjustmentUpdate();
+}
+
 void GlobalRouter::updateDirtyRoutes()
 {
+  updateDirtyCapacities();
+
   if (!dirty_nets_.empty()) {
     fastroute_->setVerbose(false);
     if (verbose_)
@@ -4010,16 +4306,55 @@ GRouteDbCbk::GRouteDbCbk(GlobalRouter* grouter) : grouter_(grouter)
 {
 }
 
+void GRouteDbCbk::inDbInstCreate(odb::dbInst* inst)
+{
+  instRegionDirty(inst);
+  grouter_->updateInstIndex(inst, true);
+}
+
+void GRouteDbCbk::inDbInstCreate(odb::dbInst* inst, odb::dbRegion* region)
+{
+  inDbInstCreate(inst);
+}
+
+void GRouteDbCbk::inDbInstDestroy(odb::dbInst* inst)
+{
+  instRegionDirty(inst);
+  grouter_->updateInstIndex(inst, false);
+}
+
+void GRouteDbCbk::inDbPreMoveInst(odb::dbInst* inst)
+{
+  instRegionDirty(inst);
+  grouter_->updateInstIndex(inst, false);
+}
+
 void GRouteDbCbk::inDbPostMoveInst(odb::dbInst* inst)
 {
+  instRegionDirty(inst);
+  grouter_->updateInstIndex(inst, true);
   instItermsDirty(inst);
 }
 
+void GRouteDbCbk::inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                           odb::dbMaster* master)
+{
+  instRegionDirty(inst);
+  grouter_->updateInstIndex(inst, false);
+}
+
 void GRouteDbCbk::inDbInstSwapMasterAfter(odb::dbInst* inst)
 {
+  instRegionDirty(inst);
+  grouter_->updateInstIndex(inst, true);
   instItermsDirty(inst);
 }
 
+void GRouteDbCbk::instRegionDirty(odb::dbInst* inst)
+{
+  grouter_->addDirtyRegion(inst->getBBox()->getBox());
+}
+
 void GRouteDbCbk::instItermsDirty(odb::dbInst* inst)
 {
   for (odb::dbITerm* iterm : inst->getITerms()) {
@@ -119,6 +119,18 @@ set_overflow_iterations(int iterations)
   getGlobalRouter()->setOverflowIterations(iterations);
 }
 
+void
+set_maze_threads(int threads)
+{
+  getGlobalRouter()->setMazeThreads(threads);
+}
+
+void
+set_maze_radix_heap(bool radix_heap)
+{
+  getGlobalRouter()->setMazeRadixHeap(radix_heap);
+}
+
 void set_congestion_report_file (const char * file_name)
 {
   getGlobalRouter()->setCongestionReportFile(file_name);
@@ -198,6 +198,8 @@ sta::define_cmd_args "global_route" {[-guide_file out_file] \
                                   [-critical_nets_percentage percent] \
                                   [-allow_congestion] \
                                   [-allow_overflow] \
+                                  [-parallel_maze_route] \
+                                  [-maze_radix_heap] \
                                   [-verbose] \
                                   [-start_incremental] \
                                   [-end_incremental]
@@ -208,7 +210,9 @@ proc global_route { args } {
     keys {-guide_file -congestion_iterations -congestion_report_file \
           -overflow_iterations -grid_origin -critical_nets_percentage
          } \
-    flags {-allow_congestion -allow_overflow -verbose -start_incremental -end_incremental}
+    flags {-allow_congestion -allow_overflow -parallel_maze_route \
+           -maze_radix_heap -verbose \
+           -start_incremental -end_incremental}
 
   sta::check_argc_eq0 "global_route" $args
 
@@ -267,6 +271,14 @@ proc global_route { args } {
   set allow_congestion [expr [info exists flags(-allow_congestion)] || [info exists flags(-allow_overflow)]]
   grt::set_allow_congestion $allow_congestion
 
+  if { [info exists flags(-parallel_maze_route)] } {
+    grt::set_maze_threads [ord::thread_count]
+  } else {
+    grt::set_maze_threads 1
+  }
+
+  grt::set_maze_radix_heap [info exists flags(-maze_radix_heap)]
+
   set start_incremental [info exists flags(-start_incremental)]
   set end_incremental [info exists flags(-end_incremental)]
 
@@ -217,6 +217,13 @@ struct TreeEdge
   Route route;
 };
 
+// predecessor of a cell in the 3D maze search
+struct parent3D
+{
+  short l;
+  int x, y;
+};
+
 struct StTree
 {
   int num_nodes = 0;
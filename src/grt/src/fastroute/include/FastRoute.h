@@ -40,11 +40,13 @@
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_set.hpp>
 #include <boost/multi_array.hpp>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include "AbstractMakeWireParasitics.h"
 #include "DataType.h"
+#include "MazeHeap.h"
 #include "grt/GRoute.h"
 #include "odb/geom.h"
 #include "stt/SteinerTreeBuilder.h"
@@ -88,6 +90,41 @@ struct DebugSetting
   bool isOn() const { return renderer_ != nullptr; }
 };
 
+// Search state of the 2D maze router. There is one per thread when
+// nets are ripped up and rerouted in parallel.
+struct MazeWorkspace
+{
+  multi_array<float, 2> d1;  // distance from the source subtree
+  multi_array<float, 2> d2;  // distance from the destination subtree
+  MazeHeap<float> src_heap;
+  std::vector<float*> dest_heap;
+  std::vector<bool> pop_heap2;
+  multi_array<short, 2> parent_x1;
+  multi_array<short, 2> parent_y1;
+  multi_array<short, 2> parent_x3;
+  multi_array<short, 2> parent_y3;
+  multi_array<bool, 2> hv;
+  multi_array<bool, 2> hyper_v;
+  multi_array<bool, 2> hyper_h;
+  multi_array<int, 2> corr_edge;
+  std::vector<OrderNetEdge> net_eo;
+  // enlarge of the last ripped up edge of the net, -1 if none
+  int last_enlarge = -1;
+};
+
+// Search state of the 3D maze router, kept between calls
+struct MazeWorkspace3D
+{
+  multi_array<Direction, 3> directions;
+  multi_array<int, 3> corr_edge;
+  multi_array<parent3D, 3> parents;
+  multi_array<int, 3> d1;  // distance from the source subtree
+  multi_array<int, 3> d2;  // distance from the destination subtree
+  MazeHeap<int> src_heap;
+  std::vector<int*> dest_heap;
+  std::vector<bool> pop_heap2;
+};
+
 using stt::Tree;
 
 class FastRouteCore
@@ -145,6 +182,18 @@ class FastRouteCore
       const interval<int>::type& first_tile_reduce_interval,
       const interval<int>::type& last_tile_reduce_interval);
   void initBlockedIntervals(std::vector<int>& track_space);
+  // Keep the capacities before the obstruction adjustments, so the
+  // capacities of some gcells can be computed again after instances move.
+  void saveBaseCapacities();
+  bool hasBaseCapacities() const { return h_base_cap_3D_.num_elements() > 0; }
+  // Restore the saved capacities of the gcells in tile_windows and limit the
+  // following adjustments to them until endAdjustmentUpdate().
+  void beginAdjustmentUpdate(const std::vector<odb::Rect>& tile_windows);
+  void endAdjustmentUpdate();
+  const std::vector<odb::Point>& getAdjustableTiles() const
+  {
+    return adjustable_tile_list_;
+  }
   void initAuxVar();
   NetRouteMap run();
   int totalOverflow() const { return total_overflow_; }
@@ -166,6 +215,8 @@ class FastRouteCore
   void setUpdateSlack(int u);
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
   void setOverflowIterations(int iterations);
+  void setMazeThreads(int threads);
+  void setMazeRadixHeap(bool radix_heap);
   void getCongestionNets(std::set<odb::dbNet*>& congestion_nets);
   void computeCongestionInformation();
   std::vector<int> getOriginalResources();
@@ -225,6 +276,38 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteNet(const int netID,
+                    const int iter,
+                    const int expand,
+                    const float cost_height,
+                    const int ripup_threshold,
+                    const int maze_edge_threshold,
+                    const int cost_type,
+                    const float logis_cof,
+                    const int via,
+                    const int slope,
+                    const int L,
+                    const float slack_th,
+                    const odb::Rect* window,
+                    MazeWorkspace& ws);
+  void mazeRouteNetsParallel(const std::vector<int>& net_ids,
+                             const int iter,
+                             const int expand,
+                             const float cost_height,
+                             const int ripup_threshold,
+                             const int maze_edge_threshold,
+                             const int cost_type,
+                             const float logis_cof,
+                             const int via,
+                             const int slope,
+                             const int L,
+                             const float slack_th);
+  odb::Rect getMazeRouteWindow(const int netID,
+                               const int iter,
+                               const int expand,
+                               const int maze_edge_threshold) const;
+  MazeWorkspace& getMazeWorkspace(const int thread);
+  MazeWorkspace3D& getMazeWorkspace3D();
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -261,10 +344,7 @@ class FastRouteCore
   void convertToMazerouteNet(const int netID);
   void setupHeap(const int netID,
                  const int edgeID,
-                 std::vector<float*>& src_heap,
-                 std::vector<float*>& dest_heap,
-                 multi_array<float, 2>& d1,
-                 multi_array<float, 2>& d2,
+                 MazeWorkspace& ws,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -308,7 +388,7 @@ class FastRouteCore
                             int layerOrientation);
   void setupHeap3D(int netID,
                    int edgeID,
-                   std::vector<int*>& src_heap_3D,
+                   MazeHeap<int>& src_heap_3D,
                    std::vector<int*>& dest_heap_3D,
                    multi_array<Direction, 3>& directions_3D,
                    multi_array<int, 3>& corr_edge_3D,
@@ -459,7 +539,7 @@ class FastRouteCore
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -482,6 +562,12 @@ class FastRouteCore
 
   typedef std::tuple<int, int, int> Tile;
 
+  void applyBlockedIntervals(const Tile& tile,
+                             const interval_set<int>& intervals,
+                             bool vertical,
+                             const std::vector<int>& track_space);
+  bool isAdjustable(int x, int y) const;
+
   static const int MAXLEN = 20000;
   static const int BIG_INT = 1e9;  // big integer used as infinity
   static const int HCOST = 5000;
@@ -494,6 +580,8 @@ class FastRouteCore
   std::vector<int> max_v_overflow_;
   odb::dbDatabase* db_;
   int overflow_iterations_;
+  int maze_threads_;
+  bool maze_radix_heap_;
   int layer_orientation_;
   int x_range_;
   int y_range_;
@@ -540,7 +628,6 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -555,17 +642,11 @@ class FastRouteCore
   multi_array<Edge, 2> h_edges_;       // The way it is indexed is (Y, X)
   multi_array<Edge3D, 3> h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
   multi_array<Edge3D, 3> v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<int, 2> corr_edge_;
   multi_array<int, 2> layer_grid_;
   multi_array<int, 2> via_link_;
-  multi_array<short, 2> parent_x1_;
-  multi_array<short, 2> parent_y1_;
-  multi_array<short, 2> parent_x3_;
-  multi_array<short, 2> parent_y3_;
-  multi_array<bool, 2> hv_;
-  multi_array<bool, 2> hyper_v_;
-  multi_array<bool, 2> hyper_h_;
-  multi_array<bool, 2> in_region_;
+  // 2D maze search state, one per maze routing thread
+  std::vector<std::unique_ptr<MazeWorkspace>> maze_workspaces_;
+  std::unique_ptr<MazeWorkspace3D> maze_workspace_3D_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
@@ -580,6 +661,18 @@ class FastRouteCore
       vertical_blocked_intervals_;
   std::unordered_map<Tile, interval_set<int>, boost::hash<Tile>>
       horizontal_blocked_intervals_;
+
+  // capacities before the obstruction adjustments
+  multi_array<unsigned short, 3> h_base_cap_3D_;
+  multi_array<unsigned short, 3> v_base_cap_3D_;
+  multi_array<unsigned short, 2> h_base_cap_;
+  multi_array<unsigned short, 2> v_base_cap_;
+  multi_array<unsigned short, 2> h_base_red_;
+  multi_array<unsigned short, 2> v_base_red_;
+  // gcells open to adjustments during an incremental capacity update
+  multi_array<bool, 2> adjustable_tiles_;
+  std::vector<odb::Point> adjustable_tile_list_;
+  bool restrict_adjustments_;
 };
 
 }  // namespace grt
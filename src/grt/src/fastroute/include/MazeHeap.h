@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2018, Iowa State University All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its contributors
+// may be used to endorse or promote products derived from this software
+// without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace grt {
+
+// Priority queue of the maze routers. The entries are addresses of the cells
+// of a distance grid and the key of an entry is the distance stored in its
+// cell, so decreasing a key is done by writing the cell and calling
+// decrease().
+//
+// Two implementations are available:
+// - a binary heap that keeps the position of every cell in the heap, so
+//   decrease() does not have to search for the entry. It pops the cells in
+//   the same order as the original FastRoute heap.
+// - a monotone radix heap over the bits of the distances. It is only valid
+//   for Dijkstra style searches, where no key pushed is smaller than the
+//   last popped one. Decreased cells are pushed again and the outdated
+//   entries are dropped when they reach the front. Cells with the same
+//   distance may be popped in a different order than with the binary heap.
+//
+// Every pushed cell is remembered until clearTouched(), so the caller can
+// restore the cells it wrote instead of clearing the whole grid.
+template <typename T>
+class MazeHeap
+{
+ public:
+  // base is the first of the size cells of the distance grid
+  void init(T* base, const int size, const bool radix)
+  {
+    base_ = base;
+    radix_ = radix;
+    pos_.assign(radix ? 0 : size, 0);
+    touched_.clear();
+    clear();
+  }
+
+  // remove all the entries, the touched cells are kept
+  void clear()
+  {
+    heap_.clear();
+    for (std::vector<Entry>& bucket : buckets_) {
+      bucket.clear();
+    }
+    last_ = 0;
+  }
+
+  void push(T* cell)
+  {
+    touched_.push_back(cell - base_);
+    if (radix_) {
+      pushRadix(cell);
+    } else {
+      heap_.push_back(cell);
+      siftUp(heap_.size() - 1);
+    }
+  }
+
+  // the distance of a cell already in the heap was lowered
+  void decrease(T* cell)
+  {
+    if (radix_) {
+      pushRadix(cell);
+    } else {
+      siftUp(pos_[cell - base_]);
+    }
+  }
+
+  bool empty()
+  {
+    if (radix_) {
+      return !normalize();
+    }
+    return heap_.empty();
+  }
+
+  T* top()
+  {
+    if (radix_) {
+      normalize();
+      return buckets_[0].back().cell;
+    }
+    return heap_[0];
+  }
+
+  void pop()
+  {
+    if (radix_) {
+      normalize();
+      buckets_[0].pop_back();
+    } else {
+      heap_[0] = heap_.back();
+      siftDown();
+      heap_.pop_back();
+    }
+  }
+
+  // cell indexes pushed since the last clearTouched()
+  const std::vector<int>& touched() const { return touched_; }
+  void clearTouched() { touched_.clear(); }
+
+ private:
+  struct Entry
+  {
+    uint32_t key;
+    T* cell;
+  };
+
+  // the bits of a non negative distance sort in the same order as its value
+  static uint32_t radixKey(const int value)
+  {
+    return static_cast<uint32_t>(value);
+  }
+  static uint32_t radixKey(const float value)
+  {
+    uint32_t key;
+    std::memcpy(&key, &value, sizeof(key));
+    return key;
+  }
+
+  int bucketIndex(const uint32_t key) const
+  {
+    if (key <= last_) {
+      return 0;
+    }
+    return 32 - __builtin_clz(key ^ last_);
+  }
+
+  void pushRadix(T* cell)
+  {
+    const uint32_t key = radixKey(*cell);
+    buckets_[bucketIndex(key)].push_back({key, cell});
+  }
+
+  bool isCurrent(const Entry& entry) const
+  {
+    return radixKey(*entry.cell) == entry.key;
+  }
+
+  // move the smallest entries to the first bucket, returns false when the
+  // heap has no current entry
+  bool normalize()
+  {
+    std::vector<Entry>& first = buckets_[0];
+    while (true) {
+      while (!first.empty() && !isCurrent(first.back())) {
+        first.pop_back();
+      }
+      if (!first.empty()) {
+        return true;
+      }
+
+      int b = 1;
+      while (b < (int) buckets_.size() && buckets_[b].empty()) {
+        b++;
+      }
+      if (b == (int) buckets_.size()) {
+        return false;
+      }
+
+      std::vector<Entry>& bucket = buckets_[b];
+      bool found = false;
+      uint32_t min_key = 0;
+      for (const Entry& entry : bucket) {
+        if (isCurrent(entry) && (!found || entry.key < min_key)) {
+          min_key = entry.key;
+          found = true;
+        }
+      }
+      if (found) {
+        last_ = min_key;
+        for (const Entry& entry : bucket) {
+          if (isCurrent(entry)) {
+            buckets_[bucketIndex(entry.key)].push_back(entry);
+          }
+        }
+      }
+      bucket.clear();
+    }
+  }
+
+  void place(const int i, T* cell)
+  {
+    heap_[i] = cell;
+    pos_[cell - base_] = i;
+  }
+
+  void siftUp(int i)
+  {
+    T* cell = heap_[i];
+    while (i > 0 && *heap_[(i - 1) / 2] > *cell) {
+      const int parent = (i - 1) / 2;
+      place(i, heap_[parent]);
+      i = parent;
+    }
+    place(i, cell);
+  }
+
+  // non recursive heapify of the root
+  void siftDown()
+  {
+    const int heap_size = heap_.size();
+    T* cell = heap_[0];
+    int i = 0;
+    while (true) {
+      const int l = 2 * i + 1;
+      const int r = 2 * i + 2;
+      int smallest;
+      if (l < heap_size && *heap_[l] < *cell) {
+        smallest = l;
+        if (r < heap_size && *heap_[r] < *heap_[l]) {
+          smallest = r;
+        }
+      } else {
+        smallest = i;
+        if (r < heap_size && *heap_[r] < *cell) {
+          smallest = r;
+        }
+      }
+      if (smallest == i) {
+        break;
+      }
+      place(i, heap_[smallest]);
+      i = smallest;
+    }
+    place(i, cell);
+  }
+
+  T* base_ = nullptr;
+  bool radix_ = false;
+  // binary heap
+  std::vector<T*> heap_;
+  std::vector<int> pos_;
+  // radix heap, bucket b holds the keys whose highest bit differing from
+  // last_ is b - 1
+  std::array<std::vector<Entry>, 33> buckets_;
+  uint32_t last_ = 0;
+  std::vector<int> touched_;
+};
+
+}  // namespace grt
@@ -54,6 +54,9 @@ FastRouteCore::FastRouteCore(odb::dbDatabase* db,
     : max_degree_(0),
       db_(db),
       overflow_iterations_(0),
+      maze_threads_(1),
+      maze_radix_heap_(false),
+      restrict_adjustments_(false),
       layer_orientation_(0),
       x_range_(0),
       y_range_(0),
@@ -114,24 +117,23 @@ void FastRouteCore::clear()
   h_edges_3D_.resize(boost::extents[0][0][0]);
   v_edges_3D_.resize(boost::extents[0][0][0]);
 
-  parent_x1_.resize(boost::extents[0][0]);
-  parent_y1_.resize(boost::extents[0][0]);
-  parent_x3_.resize(boost::extents[0][0]);
-  parent_y3_.resize(boost::extents[0][0]);
+  maze_workspaces_.clear();
+  maze_workspace_3D_.reset();
 
-  net_eo_.clear();
+  h_base_cap_3D_.resize(boost::extents[0][0][0]);
+  v_base_cap_3D_.resize(boost::extents[0][0][0]);
+  h_base_cap_.resize(boost::extents[0][0]);
+  v_base_cap_.resize(boost::extents[0][0]);
+  h_base_red_.resize(boost::extents[0][0]);
+  v_base_red_.resize(boost::extents[0][0]);
+  adjustable_tiles_.resize(boost::extents[0][0]);
+  adjustable_tile_list_.clear();
+  restrict_adjustments_ = false;
 
   xcor_.clear();
   ycor_.clear();
   dcor_.clear();
 
-  hv_.resize(boost::extents[0][0]);
-  hyper_v_.resize(boost::extents[0][0]);
-  hyper_h_.resize(boost::extents[0][0]);
-  corr_edge_.resize(boost::extents[0][0]);
-
-  in_region_.resize(boost::extents[0][0]);
-
   v_capacity_3D_.clear();
   h_capacity_3D_.clear();
 
@@ -190,12 +192,9 @@ void FastRouteCore::setGridsAndLayers(int x, int y, int nLayers)
   layer_grid_.resize(boost::extents[num_layers_][MAXLEN]);
   via_link_.resize(boost::extents[num_layers_][MAXLEN]);
 
-  hv_.resize(boost::extents[y_range_][x_range_]);
-  hyper_v_.resize(boost::extents[y_range_][x_range_]);
-  hyper_h_.resize(boost::extents[y_range_][x_range_]);
-  corr_edge_.resize(boost::extents[y_range_][x_range_]);
-
-  in_region_.resize(boost::extents[y_range_][x_range_]);
+  // the maze workspaces are sized by the grid
+  maze_workspaces_.clear();
+  maze_workspace_3D_.reset();
 
   cost_hvh_.resize(x_range_);  // Horizontal first Z
   cost_vhv_.resize(y_range_);  // Vertical first Z
@@ -356,6 +355,10 @@ void FastRouteCore::addAdjustment(int x1,
                                   int reducedCap,
                                   bool isReduce)
 {
+  if (!isAdjustable(x1, y1)) {
+    return;
+  }
+
   const int k = layer - 1;
 
   if (y1 == y2) {
@@ -481,6 +484,9 @@ void FastRouteCore::addVerticalAdjustments(
   // add intervals to set for each tile
   for (int x = first_tile.getX(); x <= last_tile.getX(); x++) {
     for (int y = first_tile.getY(); y < last_tile.getY(); y++) {
+      if (!isAdjustable(x, y)) {
+        continue;
+      }
       if (x == first_tile.getX()) {
         vertical_blocked_intervals_[std::make_tuple(x, y, layer)]
             += first_tile_reduce_interval;
@@ -504,6 +510,9 @@ void FastRouteCore::addHorizontalAdjustments(
   // add intervals to each tiles
   for (int x = first_tile.getX(); x < last_tile.getX(); x++) {
     for (int y = first_tile.getY(); y <= last_tile.getY(); y++) {
+      if (!isAdjustable(x, y)) {
+        continue;
+      }
       if (y == first_tile.getY()) {
         horizontal_blocked_intervals_[std::make_tuple(x, y, layer)]
             += first_tile_reduce_interval;
@@ -519,46 +528,145 @@ void FastRouteCore::addHorizontalAdjustments(
 
 void FastRouteCore::initBlockedIntervals(std::vector<int>& track_space)
 {
-  // Calculate reduce for vertical tiles
-  for (const auto& [tile, intervals] : vertical_blocked_intervals_) {
-    int x = std::get<0>(tile);
-    int y = std::get<1>(tile);
-    int layer = std::get<2>(tile);
-    int edge_cap = getEdgeCapacity(x, y, x, y + 1, layer);
-    if (edge_cap > 0) {
-      int reduce = 0;
-      for (auto interval_it : intervals) {
-        reduce += ceil(static_cast<float>(
-                           std::abs(interval_it.upper() - interval_it.lower()))
-                       / track_space[layer - 1]);
+  if (restrict_adjustments_) {
+    // only look at the tiles being updated
+    for (const odb::Point& tile : adjustable_tile_list_) {
+      for (int layer = 1; layer <= num_layers_; layer++) {
+        const Tile key = std::make_tuple(tile.getX(), tile.getY(), layer);
+        auto v_it = vertical_blocked_intervals_.find(key);
+        if (v_it != vertical_blocked_intervals_.end()) {
+          applyBlockedIntervals(key, v_it->second, true, track_space);
+        }
+        auto h_it = horizontal_blocked_intervals_.find(key);
+        if (h_it != horizontal_blocked_intervals_.end()) {
+          applyBlockedIntervals(key, h_it->second, false, track_space);
+        }
       }
-      edge_cap -= reduce;
-      if (edge_cap < 0)
-        edge_cap = 0;
-      addAdjustment(x, y, x, y + 1, layer, edge_cap, true);
     }
+    return;
+  }
+
+  // Calculate reduce for vertical tiles
+  for (const auto& [tile, intervals] : vertical_blocked_intervals_) {
+    applyBlockedIntervals(tile, intervals, true, track_space);
   }
   // Calculate reduce for horizontal tiles
   for (const auto& [tile, intervals] : horizontal_blocked_intervals_) {
-    int x = std::get<0>(tile);
-    int y = std::get<1>(tile);
-    int layer = std::get<2>(tile);
-    int edge_cap = getEdgeCapacity(x, y, x + 1, y, layer);
-    if (edge_cap > 0) {
-      int reduce = 0;
-      for (const auto& interval_it : intervals) {
-        reduce += ceil(static_cast<float>(
-                           std::abs(interval_it.upper() - interval_it.lower()))
-                       / track_space[layer - 1]);
+    applyBlockedIntervals(tile, intervals, false, track_space);
+  }
+}
+
+void FastRouteCore::applyBlockedIntervals(const Tile& tile,
+                                          const interval_set<int>& intervals,
+                                          const bool vertical,
+                                          const std::vector<int>& track_space)
+{
+  const int x = std::get<0>(tile);
+  const int y = std::get<1>(tile);
+  const int layer = std::get<2>(tile);
+  const int x2 = vertical ? x : x + 1;
+  const int y2 = vertical ? y + 1 : y;
+  int edge_cap = getEdgeCapacity(x, y, x2, y2, layer);
+  if (edge_cap > 0) {
+    int reduce = 0;
+    for (const auto& interval_it : intervals) {
+      reduce += ceil(static_cast<float>(
+                         std::abs(interval_it.upper() - interval_it.lower()))
+                     / track_space[layer - 1]);
+    }
+    edge_cap -= reduce;
+    if (edge_cap < 0)
+      edge_cap = 0;
+    addAdjustment(x, y, x2, y2, layer, edge_cap, true);
+  }
+}
+
+void FastRouteCore::saveBaseCapacities()
+{
+  h_base_cap_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+  v_base_cap_3D_.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+  h_base_cap_.resize(boost::extents[y_grid_][x_grid_ - 1]);
+  v_base_cap_.resize(boost::extents[y_grid_ - 1][x_grid_]);
+  h_base_red_.resize(boost::extents[y_grid_][x_grid_ - 1]);
+  v_base_red_.resize(boost::extents[y_grid_ - 1][x_grid_]);
+
+  for (int y = 0; y < y_grid_; y++) {
+    for (int x = 0; x < x_grid_; x++) {
+      for (int k = 0; k < num_layers_; k++) {
+        h_base_cap_3D_[k][y][x] = h_edges_3D_[k][y][x].cap;
+        v_base_cap_3D_[k][y][x] = v_edges_3D_[k][y][x].cap;
+      }
+      if (x < x_grid_ - 1) {
+        h_base_cap_[y][x] = h_edges_[y][x].cap;
+        h_base_red_[y][x] = h_edges_[y][x].red;
       }
-      edge_cap -= reduce;
-      if (edge_cap < 0)
-        edge_cap = 0;
-      addAdjustment(x, y, x + 1, y, layer, edge_cap, true);
+      if (y < y_grid_ - 1) {
+        v_base_cap_[y][x] = v_edges_[y][x].cap;
+        v_base_red_[y][x] = v_edges_[y][x].red;
+      }
+    }
+  }
+}
+
+void FastRouteCore::beginAdjustmentUpdate(
+    const std::vector<odb::Rect>& tile_windows)
+{
+  if (!hasBaseCapacities()) {
+    logger_->error(GRT, 252, "Base capacities were not saved.");
+  }
+
+  adjustable_tiles_.resize(boost::extents[y_grid_][x_grid_]);
+  for (const odb::Rect& window : tile_windows) {
+    for (int y = std::max(window.yMin(), 0);
+         y <= std::min(window.yMax(), y_grid_ - 1);
+         y++) {
+      for (int x = std::max(window.xMin(), 0);
+           x <= std::min(window.xMax(), x_grid_ - 1);
+           x++) {
+        if (!adjustable_tiles_[y][x]) {
+          adjustable_tiles_[y][x] = true;
+          adjustable_tile_list_.emplace_back(x, y);
+        }
+      }
+    }
+  }
+  restrict_adjustments_ = true;
+
+  // go back to the capacities before the obstructions were applied
+  for (const odb::Point& tile : adjustable_tile_list_) {
+    const int x = tile.getX();
+    const int y = tile.getY();
+    for (int k = 0; k < num_layers_; k++) {
+      h_edges_3D_[k][y][x].cap = h_base_cap_3D_[k][y][x];
+      v_edges_3D_[k][y][x].cap = v_base_cap_3D_[k][y][x];
+      vertical_blocked_intervals_.erase(std::make_tuple(x, y, k + 1));
+      horizontal_blocked_intervals_.erase(std::make_tuple(x, y, k + 1));
+    }
+    if (x < x_grid_ - 1) {
+      h_edges_[y][x].cap = h_base_cap_[y][x];
+      h_edges_[y][x].red = h_base_red_[y][x];
+    }
+    if (y < y_grid_ - 1) {
+      v_edges_[y][x].cap = v_base_cap_[y][x];
+      v_edges_[y][x].red = v_base_red_[y][x];
     }
   }
 }
 
+void FastRouteCore::endAdjustmentUpdate()
+{
+  for (const odb::Point& tile : adjustable_tile_list_) {
+    adjustable_tiles_[tile.getY()][tile.getX()] = false;
+  }
+  adjustable_tile_list_.clear();
+  restrict_adjustments_ = false;
+}
+
+bool FastRouteCore::isAdjustable(const int x, const int y) const
+{
+  return !restrict_adjustments_ || adjustable_tiles_[y][x];
+}
+
 int FastRouteCore::getEdgeCapacity(int x1, int y1, int x2, int y2, int layer)
 {
   const int k = layer - 1;
@@ -621,11 +729,6 @@ void FastRouteCore::initAuxVar()
   initNetAuxVars();
 
   grid_hv_ = x_range_ * y_range_;
-
-  parent_x1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y1_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_x3_.resize(boost::extents[y_grid_][x_grid_]);
-  parent_y3_.resize(boost::extents[y_grid_][x_grid_]);
 }
 
 void FastRouteCore::initNetAuxVars()
@@ -821,7 +924,6 @@ NetRouteMap FastRouteCore::run()
   xcor_.resize(max_degree2);
   ycor_.resize(max_degree2);
   dcor_.resize(max_degree2);
-  net_eo_.reserve(max_degree2);
 
   int THRESH_M = 20;
   const int ENLARGE = 15;  // 5
@@ -1238,7 +1340,6 @@ NetRouteMap FastRouteCore::run()
   }
 
   NetRouteMap routes = getRoutes();
-  net_eo_.clear();
   return routes;
 }
 
@@ -1263,6 +1364,16 @@ void FastRouteCore::setOverflowIterations(int iterations)
   overflow_iterations_ = iterations;
 }
 
+void FastRouteCore::setMazeThreads(int threads)
+{
+  maze_threads_ = std::max(threads, 1);
+}
+
+void FastRouteCore::setMazeRadixHeap(bool radix_heap)
+{
+  maze_radix_heap_ = radix_heap;
+}
+
 std::vector<int> FastRouteCore::getOriginalResources()
 {
   std::vector<int> original_resources(num_layers_);
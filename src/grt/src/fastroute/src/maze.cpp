@@ -30,30 +30,26 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
-using utl::GRT;
-
-static int parent_index(int i)
-{
-  return (i - 1) / 2;
-}
+// Each maze thread owns a MazeWorkspace covering the whole grid: two float
+// distance planes, the heap positions, four short parent planes, three
+// flag planes and the edge map, about this many bytes per gcell.
+static constexpr size_t kMazeWorkspaceBytesPerCell = 32;
+// The parallel maze threads are capped so that their workspaces stay
+// within this budget.
+static constexpr size_t kMazeWorkspaceBudget = size_t(4) << 30;
 
-static int left_index(int i)
-{
-  return 2 * i + 1;
-}
-
-static int right_index(int i)
-{
-  return 2 * i + 2;
-}
+using utl::GRT;
 
 void FastRouteCore::fixEmbeddedTrees()
 {
@@ -519,57 +515,6 @@ void FastRouteCore::convertToMazeroute()
   check2DEdgesUsage();
 }
 
-// non recursive version of heapify
-static void heapify(std::vector<float*>& array)
-{
-  bool stop = false;
-  const int heapSize = array.size();
-  int i = 0;
-
-  float* tmp = array[i];
-  do {
-    const int l = left_index(i);
-    const int r = right_index(i);
-
-    int smallest;
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      stop = true;
-    }
-  } while (!stop);
-}
-
-static void updateHeap(std::vector<float*>& array, int i)
-{
-  float* tmpi = array[i];
-  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
-    const int parent = parent_index(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// remove the entry with minimum distance from Priority queue
-static void removeMin(std::vector<float*>& array)
-{
-  array[0] = array.back();
-  heapify(array);
-  array.pop_back();
-}
-
 /*
  * num_iteration : the total number of iterations for maze route to run
  * round : the number of maze route stages runned
@@ -740,25 +685,27 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 // put all the nodes in the subtree t1 and t2 into src_heap and dest_heap
 // netID     - the ID for the net
 // edgeID    - the ID for the tree edge to route
-// d1        - the distance of any grid from the source subtree t1
-// d2        - the distance of any grid from the destination subtree t2
-// src_heap  - the heap storing the addresses for d1
-// dest_heap - the heap storing the addresses for d2
+// ws        - the maze workspace, holding
+//   d1        - the distance of any grid from the source subtree t1
+//   d2        - the distance of any grid from the destination subtree t2
+//   src_heap  - the heap storing the addresses for d1
+//   dest_heap - the heap storing the addresses for d2
 void FastRouteCore::setupHeap(const int netID,
                               const int edgeID,
-                              std::vector<float*>& src_heap,
-                              std::vector<float*>& dest_heap,
-                              multi_array<float, 2>& d1,
-                              multi_array<float, 2>& d2,
+                              MazeWorkspace& ws,
                               const int regionX1,
                               const int regionX2,
                               const int regionY1,
                               const int regionY2)
 {
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
-  }
+  MazeHeap<float>& src_heap = ws.src_heap;
+  std::vector<float*>& dest_heap = ws.dest_heap;
+  multi_array<float, 2>& d1 = ws.d1;
+  multi_array<float, 2>& d2 = ws.d2;
+  multi_array<int, 2>& corr_edge = ws.corr_edge;
+  auto in_region = [=](const int x, const int y) {
+    return x >= regionX1 && x <= regionX2 && y >= regionY1 && y <= regionY2;
+  };
 
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
@@ -777,7 +724,7 @@ void FastRouteCore::setupHeap(const int netID,
   if (num_terminals == 2)  // 2-pin net
   {
     d1[y1][x1] = 0;
-    src_heap.push_back(&d1[y1][x1]);
+    src_heap.push(&d1[y1][x1]);
     d2[y2][x2] = 0;
     dest_heap.push_back(&d2[y2][x2]);
   } else {  // net with more than 2 pins
@@ -791,7 +738,7 @@ void FastRouteCore::setupHeap(const int netID,
     if (n1 < num_terminals) {  // n1 is a Pin node
       // just need to put n1 itself into src_heap
       d1[y1][x1] = 0;
-      src_heap.push_back(&d1[y1][x1]);
+      src_heap.push(&d1[y1][x1]);
       visited[n1] = true;
     } else {  // n1 is a Steiner node
       int queuehead = 0;
@@ -799,7 +746,7 @@ void FastRouteCore::setupHeap(const int netID,
 
       // add n1 into src_heap
       d1[y1][x1] = 0;
-      src_heap.push_back(&d1[y1][x1]);
+      src_heap.push(&d1[y1][x1]);
       visited[n1] = true;
 
       // add n1 into the queue
@@ -831,12 +778,12 @@ void FastRouteCore::setupHeap(const int netID,
           if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
             // put nbr into src_heap if in enlarged region
             const TreeNode& nbr_node = treenodes[nbr];
-            if (in_region_[nbr_node.y][nbr_node.x]) {
+            if (in_region(nbr_node.x, nbr_node.y)) {
               const int nbrX = nbr_node.x;
               const int nbrY = nbr_node.y;
               d1[nbrY][nbrX] = 0;
-              src_heap.push_back(&d1[nbrY][nbrX]);
-              corr_edge_[nbrY][nbrX] = edge;
+              src_heap.push(&d1[nbrY][nbrX]);
+              corr_edge[nbrY][nbrX] = edge;
             }
 
             const Route* route = &(treeedges[edge].route);
@@ -849,10 +796,10 @@ void FastRouteCore::setupHeap(const int netID,
               const int x_grid = route->gridsX[j];
               const int y_grid = route->gridsY[j];
 
-              if (in_region_[y_grid][x_grid]) {
+              if (in_region(x_grid, y_grid)) {
                 d1[y_grid][x_grid] = 0;
-                src_heap.push_back(&d1[y_grid][x_grid]);
-                corr_edge_[y_grid][x_grid] = edge;
+                src_heap.push(&d1[y_grid][x_grid]);
+                corr_edge[y_grid][x_grid] = edge;
               }
             }
           }  // if not a degraded edge (len>0)
@@ -911,12 +858,12 @@ void FastRouteCore::setupHeap(const int netID,
           if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
             // put nbr into dest_heap
             const TreeNode& nbr_node = treenodes[nbr];
-            if (in_region_[nbr_node.y][nbr_node.x]) {
+            if (in_region(nbr_node.x, nbr_node.y)) {
               const int nbrX = nbr_node.x;
               const int nbrY = nbr_node.y;
               d2[nbrY][nbrX] = 0;
               dest_heap.push_back(&d2[nbrY][nbrX]);
-              corr_edge_[nbrY][nbrX] = edge;
+              corr_edge[nbrY][nbrX] = edge;
             }
 
             const Route* route = &(treeedges[edge].route);
@@ -928,10 +875,10 @@ void FastRouteCore::setupHeap(const int netID,
             for (int j = 1; j < route->routelen; j++) {
               const int x_grid = route->gridsX[j];
               const int y_grid = route->gridsY[j];
-              if (in_region_[y_grid][x_grid]) {
+              if (in_region(x_grid, y_grid)) {
                 d2[y_grid][x_grid] = 0;
                 dest_heap.push_back(&d2[y_grid][x_grid]);
-                corr_edge_[y_grid][x_grid] = edge;
+                corr_edge[y_grid][x_grid] = edge;
               }
             }
           }  // if the edge is not degraded (len>0)
@@ -943,11 +890,6 @@ void FastRouteCore::setupHeap(const int netID,
       }    // while queue is not empty
     }      // else n2 is not a Pin node
   }        // net with more than two pins
-
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
-  }
 }
 
 int FastRouteCore::copyGrids(const TreeNode* treenodes,
@@ -1329,819 +1271,1093 @@ float getCost(const int i,
   return cost;
 }
 
-void FastRouteCore::mazeRouteMSMD(const int iter,
-                                  const int expand,
-                                  const float cost_height,
-                                  const int ripup_threshold,
-                                  const int maze_edge_threshold,
-                                  const bool ordering,
-                                  const int cost_type,
-                                  const float logis_cof,
-                                  const int via,
-                                  const int slope,
-                                  const int L,
-                                  float& slack_th)
+// Rip up and reroute the tree edges of a single net.
+// When window is set, the maze search never leaves it.
+// Returns false when the tree of the net is broken and has to be
+// rebuilt with reInitTree() before routing the net again.
+bool FastRouteCore::mazeRouteNet(const int netID,
+                                 const int iter,
+                                 const int expand,
+                                 const float cost_height,
+                                 const int ripup_threshold,
+                                 const int maze_edge_threshold,
+                                 const int cost_type,
+                                 const float logis_cof,
+                                 const int via,
+                                 const int slope,
+                                 const int L,
+                                 const float slack_th,
+                                 const odb::Rect* window,
+                                 MazeWorkspace& ws)
 {
-  // maze routing for multi-source, multi-destination
   int tmpX, tmpY;
 
-  const int max_usage_multiplier = 40;
-
-  // allocate memory for distance and parent and pop_heap
-  h_cost_table_.resize(max_usage_multiplier * h_capacity_);
-  v_cost_table_.resize(max_usage_multiplier * v_capacity_);
+  multi_array<float, 2>& d1 = ws.d1;
+  multi_array<float, 2>& d2 = ws.d2;
+  MazeHeap<float>& src_heap = ws.src_heap;
+  std::vector<float*>& dest_heap = ws.dest_heap;
+  std::vector<bool>& pop_heap2 = ws.pop_heap2;
+  multi_array<short, 2>& parent_x1 = ws.parent_x1;
+  multi_array<short, 2>& parent_y1 = ws.parent_y1;
+  multi_array<short, 2>& parent_x3 = ws.parent_x3;
+  multi_array<short, 2>& parent_y3 = ws.parent_y3;
+  multi_array<bool, 2>& hv = ws.hv;
+  multi_array<bool, 2>& hyper_v = ws.hyper_v;
+  multi_array<bool, 2>& hyper_h = ws.hyper_h;
+  multi_array<int, 2>& corr_edge = ws.corr_edge;
+  std::vector<OrderNetEdge>& net_eo = ws.net_eo;
+
+  ws.last_enlarge = -1;
 
-  for (int i = 0; i < max_usage_multiplier * h_capacity_; i++) {
-    h_cost_table_[i]
-        = getCost(i, logis_cof, cost_height, slope, h_capacity_, cost_type);
-  }
-  for (int i = 0; i < max_usage_multiplier * v_capacity_; i++) {
-    v_cost_table_[i]
-        = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
-  }
-
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
-  if (ordering) {
-    if (update_slack_) {
-      slack_th = CalculatePartialSlack();
-    }
-    StNetOrder();
-  }
-
-  std::vector<float*> src_heap;
-  std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
+  const int num_terminals = sttrees_[netID].num_terminals;
 
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
+  const int origENG = expand;
 
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
+  netedgeOrderDec(netID, net_eo);
 
-  for (int nidRPC = 0; nidRPC < netCount(); nidRPC++) {
-    const int netID = ordering ? tree_order_cong_[nidRPC].treeIndex : nidRPC;
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
 
-    if (nets_[netID]->isRouted())
+    const int n1 = treeedge->n1;
+    const int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
       continue;
+    }
 
-    const int num_terminals = sttrees_[netID].num_terminals;
-
-    const int origENG = expand;
-
-    netedgeOrderDec(netID);
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      const int n1 = treeedge->n1;
-      const int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
-      }
+    if (!enter) {
+      continue;
+    }
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
-
-      if (!enter) {
-        continue;
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    const int enlarge
+        = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+    ws.last_enlarge = enlarge;
+
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    int regionX1 = std::max(xmin - enlarge + decrease, 0);
+    int regionX2 = std::min(xmax + enlarge - decrease, x_grid_ - 1);
+    int regionY1 = std::max(ymin - enlarge + decrease, 0);
+    int regionY2 = std::min(ymax + enlarge - decrease, y_grid_ - 1);
+
+    // stay inside the window reserved for the net
+    if (window != nullptr) {
+      regionX1 = std::max(regionX1, window->xMin());
+      regionX2 = std::min(regionX2, window->xMax());
+      regionY1 = std::max(regionY1, window->yMin());
+      regionY2 = std::min(regionY2, window->yMax());
+    }
+
+    // restore d1[][] to BIG_INT only on the cells reached by the previous
+    // search; d2[][] is only used to address pop_heap2
+    for (const int cell : src_heap.touched()) {
+      d1.data()[cell] = BIG_INT;
+      hyper_h.data()[cell] = false;
+      hyper_v.data()[cell] = false;
+    }
+    src_heap.clearTouched();
+
+    // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
+    // grids on the two subtrees
+    setupHeap(netID,
+              edgeID,
+              ws,
+              regionX1,
+              regionX2,
+              regionY1,
+              regionY2);
+
+    // while loop to find shortest path
+    int ind1 = (src_heap.top() - &d1[0][0]);
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = ind1 % x_range_;
+      const int curY = ind1 / x_range_;
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv[curY][curX]) {
+          preX = parent_x1[curY][curX];
+          preY = parent_y1[curY][curX];
+        } else {
+          preX = parent_x3[curY][curX];
+          preY = parent_y3[curY][curX];
+        }
+      } else {
+        preX = curX;
+        preY = curY;
       }
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+      src_heap.pop();
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX - 1].usage_red()
+                         + L * h_edges_[curY][(curX - 1)].last_usage;
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
 
-      int decrease = 0;
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_[curY][curX].usage_red()
+                             + L * h_edges_[curY][curX].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY][curX + 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
+            }
+          }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX - 1;  // the left neighbor
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // left neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push(&d1[curY][tmpX]);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.decrease(&d1[curY][tmpX]);
         }
       }
-
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+      // right
+      if (curX < regionX2) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX].usage_red()
+                         + L * h_edges_[curY][curX].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
         } else {
-          preX = curX;
-          preY = curY;
-        }
-
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_[curY][curX - 1].usage_red()
+                             + L * h_edges_[curY][curX - 1].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY][curX - 1] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // right
-        if (curX < regionX2) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
-            }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
-          }
+        tmpX = curX + 1;  // the right neighbor
+
+        if (d1[curY][tmpX]
+            >= BIG_INT)  // right neighbor not been put into src_heap
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push(&d1[curY][tmpX]);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.decrease(&d1[curY][tmpX]);
         }
-        // bottom
-        if (curY > regionY1) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // bottom
+      if (curY > regionY1) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY - 1][curX].usage_red()
+                         + L * v_edges_[curY - 1][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_[curY][curX].usage_red()
+                             + L * v_edges_[curY][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            const int tmp_cost = d1[curY + 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // top
-        if (curY < regionY2) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+        tmpY = curY - 1;  // the bottom neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // bottom neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push(&d1[tmpY][curX]);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.decrease(&d1[tmpY][curX]);
+        }
+      }
+      // top
+      if (curY < regionY2) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY][curX].usage_red()
+                         + L * v_edges_[curY][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_[curY - 1][curX].usage_red()
+                             + L * v_edges_[curY - 1][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            const int tmp_cost = d1[curY - 1][curX] + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpY = curY + 1;  // the top neighbor
+        if (d1[tmpY][curX]
+            >= BIG_INT)  // top neighbor not been put into src_heap
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push(&d1[tmpY][curX]);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.decrease(&d1[tmpY][curX]);
         }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = (src_heap.top() - &d1[0][0]);
 
-      }  // while loop
+    }  // while loop
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (int i = 0; i < dest_heap.size(); i++)
+      pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = ind1 % x_range_;
+    const int crossY = ind1 / x_range_;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv[tmpY][tmpX]) {
+          curY = parent_y1[tmpY][tmpX];
+        } else {
+          curX = parent_x3[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
+
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
+      }
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes.get(),
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges.get(),
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes.get(),
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges.get(),
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes.get(),
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges.get(),
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          151,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes.get(),
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges.get(),
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            151,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+    // (2) consider subtree2
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
+      }
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes.get(),
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges.get(),
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          152,
+                          "Net {} has errors during updateRouteType1.",
+                          nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes.get(),
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges.get(),
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            152,
-                            "Net {} has errors during updateRouteType1.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes.get(),
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges.get(),
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          153,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes.get(),
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges.get(),
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            153,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
+
+    int edgeCost = nets_[netID]->getEdgeCost();
+
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[min_y][gridsX[i]].usage += edgeCost;
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][min_x].usage += edgeCost;
       }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
+  }  // loop edgeID
+
+  return true;
+}
+
+// Bounding box, in gcells, of every grid a call to mazeRouteNet() can touch
+// for the net: the current tree, its routes and the largest search region.
+odb::Rect FastRouteCore::getMazeRouteWindow(const int netID,
+                                            const int iter,
+                                            const int expand,
+                                            const int maze_edge_threshold) const
+{
+  const auto& treeedges = sttrees_[netID].edges;
+  const auto& treenodes = sttrees_[netID].nodes;
+
+  int xmin = x_grid_ - 1;
+  int ymin = y_grid_ - 1;
+  int xmax = 0;
+  int ymax = 0;
+  for (int i = 0; i < sttrees_[netID].num_nodes; i++) {
+    xmin = std::min(xmin, (int) treenodes[i].x);
+    ymin = std::min(ymin, (int) treenodes[i].y);
+    xmax = std::max(xmax, (int) treenodes[i].x);
+    ymax = std::max(ymax, (int) treenodes[i].y);
+  }
+
+  int max_routelen = 0;
+  for (int edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    const TreeEdge& treeedge = treeedges[edgeID];
+    const Route& route = treeedge.route;
+    if (route.type == RouteType::MazeRoute) {
+      for (int i = 0; i <= route.routelen; i++) {
+        xmin = std::min(xmin, (int) route.gridsX[i]);
+        ymin = std::min(ymin, (int) route.gridsY[i]);
+        xmax = std::max(xmax, (int) route.gridsX[i]);
+        ymax = std::max(ymax, (int) route.gridsY[i]);
       }
+    }
+    const TreeNode& n1 = treenodes[treeedge.n1];
+    const TreeNode& n2 = treenodes[treeedge.n2];
+    const int len = abs(n2.x - n1.x) + abs(n2.y - n1.y);
+    if (len > maze_edge_threshold) {
+      max_routelen = std::max(max_routelen, route.routelen);
+    }
+  }
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+  const int margin = std::min(expand, (iter / 6 + 3) * max_routelen);
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
+  return odb::Rect(std::max(xmin - margin, 0),
+                   std::max(ymin - margin, 0),
+                   std::min(xmax + margin, x_grid_ - 1),
+                   std::min(ymax + margin, y_grid_ - 1));
+}
+
+MazeWorkspace& FastRouteCore::getMazeWorkspace(const int thread)
+{
+  if ((int) maze_workspaces_.size() <= thread) {
+    maze_workspaces_.resize(thread + 1);
+  }
+
+  std::unique_ptr<MazeWorkspace>& ws = maze_workspaces_[thread];
+  if (ws == nullptr) {
+    ws = std::make_unique<MazeWorkspace>();
+    ws->d1.resize(boost::extents[y_range_][x_range_]);
+    ws->d2.resize(boost::extents[y_range_][x_range_]);
+    std::fill_n(ws->d1.data(), ws->d1.num_elements(), BIG_INT);
+    ws->src_heap.init(ws->d1.data(), ws->d1.num_elements(), maze_radix_heap_);
+    ws->dest_heap.reserve(y_grid_ * x_grid_);
+    ws->pop_heap2.assign(y_grid_ * x_range_, false);
+    ws->parent_x1.resize(boost::extents[y_range_][x_range_]);
+    ws->parent_y1.resize(boost::extents[y_range_][x_range_]);
+    ws->parent_x3.resize(boost::extents[y_range_][x_range_]);
+    ws->parent_y3.resize(boost::extents[y_range_][x_range_]);
+    ws->hv.resize(boost::extents[y_range_][x_range_]);
+    ws->hyper_v.resize(boost::extents[y_range_][x_range_]);
+    ws->hyper_h.resize(boost::extents[y_range_][x_range_]);
+    std::fill_n(ws->hyper_v.data(), ws->hyper_v.num_elements(), false);
+    std::fill_n(ws->hyper_h.data(), ws->hyper_h.num_elements(), false);
+    ws->corr_edge.resize(boost::extents[y_range_][x_range_]);
+    ws->net_eo.reserve(2 * max_degree_);
+  }
+
+  return *ws;
+}
+
+// Route the nets in batches whose search windows do not share any gcell,
+// so the nets of a batch can be ripped up and rerouted concurrently.
+// A net is always placed in a later batch than every net before it in
+// net_ids that it overlaps, so the order between interacting nets is the
+// same as in the single threaded flow. Confining each net to its window
+// may still change the result slightly compared to maze_threads_ == 1,
+// but it never depends on the number of threads.
+void FastRouteCore::mazeRouteNetsParallel(const std::vector<int>& net_ids,
+                                          const int iter,
+                                          const int expand,
+                                          const float cost_height,
+                                          const int ripup_threshold,
+                                          const int maze_edge_threshold,
+                                          const int cost_type,
+                                          const float logis_cof,
+                                          const int via,
+                                          const int slope,
+                                          const int L,
+                                          const float slack_th)
+{
+  const int batch_tile_size = 8;
+  const int tiles_x = (x_grid_ + batch_tile_size - 1) / batch_tile_size;
+  const int tiles_y = (y_grid_ + batch_tile_size - 1) / batch_tile_size;
+
+  // the next free batch of every tile
+  std::vector<int> tile_batch(tiles_x * tiles_y, 0);
+  std::vector<odb::Rect> windows;
+  std::vector<std::vector<int>> batches;
+  windows.reserve(net_ids.size());
+  for (int i = 0; i < net_ids.size(); i++) {
+    const odb::Rect window
+        = getMazeRouteWindow(net_ids[i], iter, expand, maze_edge_threshold);
+    windows.push_back(window);
+
+    const int tx1 = window.xMin() / batch_tile_size;
+    const int tx2 = window.xMax() / batch_tile_size;
+    const int ty1 = window.yMin() / batch_tile_size;
+    const int ty2 = window.yMax() / batch_tile_size;
+    int batch = 0;
+    for (int ty = ty1; ty <= ty2; ty++) {
+      for (int tx = tx1; tx <= tx2; tx++) {
+        batch = std::max(batch, tile_batch[ty * tiles_x + tx]);
+      }
+    }
+    for (int ty = ty1; ty <= ty2; ty++) {
+      for (int tx = tx1; tx <= tx2; tx++) {
+        tile_batch[ty * tiles_x + tx] = batch + 1;
+      }
+    }
+    if ((int) batches.size() <= batch) {
+      batches.resize(batch + 1);
+    }
+    batches[batch].push_back(i);
+  }
+
+  // More threads than nets in the largest batch would sit idle, and every
+  // thread costs a full grid workspace.
+  size_t max_batch = 1;
+  for (const std::vector<int>& batch : batches) {
+    max_batch = std::max(max_batch, batch.size());
+  }
+  const size_t workspace_bytes
+      = (size_t) x_range_ * y_range_ * kMazeWorkspaceBytesPerCell;
+  const size_t budget_threads
+      = std::max<size_t>(1, kMazeWorkspaceBudget / workspace_bytes);
+  const int threads
+      = std::min<size_t>({(size_t) maze_threads_, max_batch, budget_threads});
+  debugPrint(logger_,
+             GRT,
+             "mazeRoute",
+             1,
+             "{} maze threads, {} MB of workspace per thread.",
+             threads,
+             workspace_bytes >> 20);
+
+  // the workspaces are not allocated inside the parallel region
+  for (int thread = 0; thread < threads; thread++) {
+    getMazeWorkspace(thread);
+  }
+
+  std::vector<int> last_enlarge(net_ids.size(), -1);
+  for (const std::vector<int>& batch : batches) {
+    std::vector<char> routed(batch.size(), true);
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+    for (int i = 0; i < (int) batch.size(); i++) {
+      try {
+        MazeWorkspace& ws = *maze_workspaces_[omp_get_thread_num()];
+        const int idx = batch[i];
+        routed[i] = mazeRouteNet(net_ids[idx],
+                                 iter,
+                                 expand,
+                                 cost_height,
+                                 ripup_threshold,
+                                 maze_edge_threshold,
+                                 cost_type,
+                                 logis_cof,
+                                 via,
+                                 slope,
+                                 L,
+                                 slack_th,
+                                 &windows[idx],
+                                 ws);
+        last_enlarge[idx] = ws.last_enlarge;
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+
+    // rebuilding a broken tree is not thread safe, redo those nets serially
+    MazeWorkspace& ws = getMazeWorkspace(0);
+    for (int i = 0; i < batch.size(); i++) {
+      const int idx = batch[i];
+      while (!routed[i]) {
+        reInitTree(net_ids[idx]);
+        routed[i] = mazeRouteNet(net_ids[idx],
+                                 iter,
+                                 expand,
+                                 cost_height,
+                                 ripup_threshold,
+                                 maze_edge_threshold,
+                                 cost_type,
+                                 logis_cof,
+                                 via,
+                                 slope,
+                                 L,
+                                 slack_th,
+                                 &windows[idx],
+                                 ws);
+        if (ws.last_enlarge >= 0) {
+          last_enlarge[idx] = ws.last_enlarge;
         }
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+  }
+
+  for (auto it = last_enlarge.rbegin(); it != last_enlarge.rend(); it++) {
+    if (*it >= 0) {
+      enlarge_ = *it;
+      break;
+    }
+  }
+}
+
+void FastRouteCore::mazeRouteMSMD(const int iter,
+                                  const int expand,
+                                  const float cost_height,
+                                  const int ripup_threshold,
+                                  const int maze_edge_threshold,
+                                  const bool ordering,
+                                  const int cost_type,
+                                  const float logis_cof,
+                                  const int via,
+                                  const int slope,
+                                  const int L,
+                                  float& slack_th)
+{
+  // maze routing for multi-source, multi-destination
+  const int max_usage_multiplier = 40;
+
+  // allocate memory for distance and parent and pop_heap
+  h_cost_table_.resize(max_usage_multiplier * h_capacity_);
+  v_cost_table_.resize(max_usage_multiplier * v_capacity_);
+
+  for (int i = 0; i < max_usage_multiplier * h_capacity_; i++) {
+    h_cost_table_[i]
+        = getCost(i, logis_cof, cost_height, slope, h_capacity_, cost_type);
+  }
+  for (int i = 0; i < max_usage_multiplier * v_capacity_; i++) {
+    v_cost_table_[i]
+        = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
+  }
+
+  if (ordering) {
+    if (update_slack_) {
+      slack_th = CalculatePartialSlack();
+    }
+    StNetOrder();
+  }
+
+  if (maze_threads_ > 1) {
+    std::vector<int> net_ids;
+    for (int nidRPC = 0; nidRPC < netCount(); nidRPC++) {
+      const int netID = ordering ? tree_order_cong_[nidRPC].treeIndex : nidRPC;
+      if (!nets_[netID]->isRouted()) {
+        net_ids.push_back(netID);
+      }
+    }
+    mazeRouteNetsParallel(net_ids,
+                          iter,
+                          expand,
+                          cost_height,
+                          ripup_threshold,
+                          maze_edge_threshold,
+                          cost_type,
+                          logis_cof,
+                          via,
+                          slope,
+                          L,
+                          slack_th);
+  } else {
+    MazeWorkspace& ws = getMazeWorkspace(0);
+    for (int nidRPC = 0; nidRPC < netCount(); nidRPC++) {
+      const int netID = ordering ? tree_order_cong_[nidRPC].treeIndex : nidRPC;
+
+      if (nets_[netID]->isRouted())
+        continue;
+
+      bool routed;
+      do {
+        routed = mazeRouteNet(netID,
+                              iter,
+                              expand,
+                              cost_height,
+                              ripup_threshold,
+                              maze_edge_threshold,
+                              cost_type,
+                              logis_cof,
+                              via,
+                              slope,
+                              L,
+                              slack_th,
+                              nullptr,
+                              ws);
+        if (ws.last_enlarge >= 0) {
+          enlarge_ = ws.last_enlarge;
+        }
+        if (!routed) {
+          reInitTree(netID);
+        }
+      } while (!routed);
+    }
+  }
 
   h_cost_table_.clear();
   v_cost_table_.clear();
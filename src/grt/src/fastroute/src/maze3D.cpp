@@ -40,81 +40,9 @@ namespace grt {
 
 using utl::GRT;
 
-struct parent3D
-{
-  short l;
-  int x, y;
-};
-
-static int parent_index(int i)
-{
-  return (i - 1) / 2;
-}
-
-static int left_index(int i)
-{
-  return 2 * i + 1;
-}
-
-static int right_index(int i)
-{
-  return 2 * i + 2;
-}
-
-// non recursive version of heapify-
-static void heapify3D(std::vector<int*>& array)
-{
-  bool stop = false;
-  const int heapSize = array.size();
-  int i = 0;
-
-  int* tmp = array[i];
-  do {
-    const int l = left_index(i);
-    const int r = right_index(i);
-
-    int smallest;
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      stop = true;
-    }
-  } while (!stop);
-}
-
-static void updateHeap3D(std::vector<int*>& array, int i)
-{
-  int* tmpi = array[i];
-  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
-    const int parent = parent_index(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// extract the entry with minimum distance from Priority queue
-static void removeMin3D(std::vector<int*>& array)
-{
-  array[0] = array.back();
-  heapify3D(array);
-  array.pop_back();
-}
-
 void FastRouteCore::setupHeap3D(int netID,
                                 int edgeID,
-                                std::vector<int*>& src_heap_3D,
+                                MazeHeap<int>& src_heap_3D,
                                 std::vector<int*>& dest_heap_3D,
                                 multi_array<Direction, 3>& directions_3D,
                                 multi_array<int, 3>& corr_edge_3D,
@@ -125,6 +53,10 @@ void FastRouteCore::setupHeap3D(int netID,
                                 int regionY1,
                                 int regionY2)
 {
+  auto in_region = [=](const int x, const int y) {
+    return x >= regionX1 && x <= regionX2 && y >= regionY1 && y <= regionY2;
+  };
+
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
 
@@ -143,17 +75,11 @@ void FastRouteCore::setupHeap3D(int netID,
   if (num_terminals == 2) {  // 2-pin net
     d1_3D[0][y1][x1] = 0;
     directions_3D[0][y1][x1] = Direction::Origin;
-    src_heap_3D.push_back(&d1_3D[0][y1][x1]);
+    src_heap_3D.push(&d1_3D[0][y1][x1]);
     d2_3D[0][y2][x2] = 0;
     directions_3D[0][y2][x2] = Direction::Origin;
     dest_heap_3D.push_back(&d2_3D[0][y2][x2]);
   } else {  // net with more than 2 pins
-    for (int i = regionY1; i <= regionY2; i++) {
-      for (int j = regionX1; j <= regionX2; j++) {
-        in_region_[i][j] = true;
-      }
-    }
-
     const int numNodes = sttrees_[netID].num_nodes;
     std::vector<bool> heapVisited(numNodes, false);
     std::vector<int> heapQueue(numNodes);
@@ -166,7 +92,7 @@ void FastRouteCore::setupHeap3D(int netID,
 
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d1_3D[l][y1][x1] = 0;
-        src_heap_3D.push_back(&d1_3D[l][y1][x1]);
+        src_heap_3D.push(&d1_3D[l][y1][x1]);
         directions_3D[l][y1][x1] = Direction::Origin;
         heapVisited[n1] = true;
       }
@@ -180,7 +106,7 @@ void FastRouteCore::setupHeap3D(int netID,
       for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
         d1_3D[l][y1][x1] = 0;
         directions_3D[l][y1][x1] = Direction::Origin;
-        src_heap_3D.push_back(&d1_3D[l][y1][x1]);
+        src_heap_3D.push(&d1_3D[l][y1][x1]);
         heapVisited[n1] = true;
       }
 
@@ -211,14 +137,14 @@ void FastRouteCore::setupHeap3D(int netID,
           if (treeedges[edge].route.routelen > 0) {
             // not a degraded edge
             // put nbr into src_heap_3D if in enlarged region
-            if (in_region_[treenodes[nbr].y][treenodes[nbr].x]) {
+            if (in_region(treenodes[nbr].x, treenodes[nbr].y)) {
               const int nbrX = treenodes[nbr].x;
               const int nbrY = treenodes[nbr].y;
               nt = treenodes[nbr].stackAlias;
               for (int l = treenodes[nt].botL; l <= treenodes[nt].topL; l++) {
                 d1_3D[l][nbrY][nbrX] = 0;
                 directions_3D[l][nbrY][nbrX] = Direction::Origin;
-                src_heap_3D.push_back(&d1_3D[l][nbrY][nbrX]);
+                src_heap_3D.push(&d1_3D[l][nbrY][nbrX]);
                 corr_edge_3D[l][nbrY][nbrX] = edge;
               }
             }
@@ -233,9 +159,9 @@ void FastRouteCore::setupHeap3D(int netID,
                 const int y_grid = route->gridsY[j];
                 const int l_grid = route->gridsL[j];
 
-                if (in_region_[y_grid][x_grid]) {
+                if (in_region(x_grid, y_grid)) {
                   d1_3D[l_grid][y_grid][x_grid] = 0;
-                  src_heap_3D.push_back(&d1_3D[l_grid][y_grid][x_grid]);
+                  src_heap_3D.push(&d1_3D[l_grid][y_grid][x_grid]);
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
                   corr_edge_3D[l_grid][y_grid][x_grid] = edge;
                 }
@@ -306,7 +232,7 @@ void FastRouteCore::setupHeap3D(int netID,
           if (treeedges[edge].route.routelen > 0) {
             // not a degraded edge
             // put nbr into dest_heap_3D
-            if (in_region_[treenodes[nbr].y][treenodes[nbr].x]) {
+            if (in_region(treenodes[nbr].x, treenodes[nbr].y)) {
               const int nbrX = treenodes[nbr].x;
               const int nbrY = treenodes[nbr].y;
               const int nt = treenodes[nbr].stackAlias;
@@ -330,7 +256,7 @@ void FastRouteCore::setupHeap3D(int netID,
                 const int x_grid = route->gridsX[j];
                 const int y_grid = route->gridsY[j];
                 const int l_grid = route->gridsL[j];
-                if (in_region_[y_grid][x_grid]) {
+                if (in_region(x_grid, y_grid)) {
                   d2_3D[l_grid][y_grid][x_grid] = 0;
                   directions_3D[l_grid][y_grid][x_grid] = Direction::Origin;
                   dest_heap_3D.push_back(&d2_3D[l_grid][y_grid][x_grid]);
@@ -348,13 +274,7 @@ void FastRouteCore::setupHeap3D(int netID,
         }  // loop i (3 neigbors for cur node)
       }    // while heapQueue is not empty
     }      // else n2 is not a Pin node
-
-    for (int i = regionY1; i <= regionY2; i++) {
-      for (int j = regionX1; j <= regionX2; j++) {
-        in_region_[i][j] = false;
-      }
-    }
-  }  // net with more than two pins
+  }        // net with more than two pins
 }
 
 void FastRouteCore::newUpdateNodeLayers(TreeNode* treenodes,
@@ -848,39 +768,41 @@ void FastRouteCore::updateRouteType23D(int netID,
   }
 }
 
+MazeWorkspace3D& FastRouteCore::getMazeWorkspace3D()
+{
+  if (maze_workspace_3D_ == nullptr) {
+    maze_workspace_3D_ = std::make_unique<MazeWorkspace3D>();
+    MazeWorkspace3D& ws = *maze_workspace_3D_;
+    ws.directions.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+    ws.corr_edge.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+    ws.parents.resize(boost::extents[num_layers_][y_grid_][x_grid_]);
+    ws.d1.resize(boost::extents[num_layers_][y_range_][x_range_]);
+    ws.d2.resize(boost::extents[num_layers_][y_range_][x_range_]);
+    std::fill_n(ws.d1.data(), ws.d1.num_elements(), BIG_INT);
+    ws.src_heap.init(ws.d1.data(), ws.d1.num_elements(), maze_radix_heap_);
+    ws.pop_heap2.assign(ws.d2.num_elements(), false);
+  }
+
+  return *maze_workspace_3D_;
+}
+
 void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                                          int ripupTHlb,
                                          int ripupTHub,
                                          int layerOrientation)
 {
-  static multi_array<Direction, 3> directions_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<int, 3> corr_edge_3D(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-  static multi_array<parent3D, 3> pr_3D_(
-      boost::extents[num_layers_][y_grid_][x_grid_]);
-
-  int64 total_size = static_cast<int64>(num_layers_) * y_range_ * x_range_;
-  static std::vector<bool> pop_heap2_3D(total_size, false);
-
-  // allocate memory for priority queue
-  total_size = static_cast<int64>(y_grid_) * x_grid_ * num_layers_;
-  static std::vector<int*> src_heap_3D(total_size);
-  static std::vector<int*> dest_heap_3D(total_size);
-
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++) {
-      in_region_[i][j] = false;
-    }
-  }
+  MazeWorkspace3D& ws = getMazeWorkspace3D();
+  multi_array<Direction, 3>& directions_3D = ws.directions;
+  multi_array<int, 3>& corr_edge_3D = ws.corr_edge;
+  multi_array<parent3D, 3>& pr_3D_ = ws.parents;
+  multi_array<int, 3>& d1_3D = ws.d1;
+  multi_array<int, 3>& d2_3D = ws.d2;
+  MazeHeap<int>& src_heap_3D = ws.src_heap;
+  std::vector<int*>& dest_heap_3D = ws.dest_heap;
+  std::vector<bool>& pop_heap2_3D = ws.pop_heap2;
 
   const int endIND = tree_order_pv_.size() * 0.9;
 
-  static multi_array<int, 3> d1_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-  static multi_array<int, 3> d2_3D(
-      boost::extents[num_layers_][y_range_][x_range_]);
-
   for (int orderIndex = 0; orderIndex < endIND; orderIndex++) {
     const int netID = tree_order_pv_[orderIndex].treeIndex;
     FrNet* net = nets_[netID];
@@ -930,17 +852,12 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
       int n1a = treeedge->n1a;
       int n2a = treeedge->n2a;
 
-      // initialize pop_src_heap_3D_[] and pop_heap2_3D[] as false (for
-      // detecting the shortest path is found or not)
-
-      for (int k = 0; k < num_layers_; k++) {
-        for (int i = regionY1; i <= regionY2; i++) {
-          for (int j = regionX1; j <= regionX2; j++) {
-            d1_3D[k][i][j] = BIG_INT;
-            d2_3D[k][i][j] = BIG_INT;
-          }
-        }
+      // restore d1_3D[][] to BIG_INT only on the cells reached by the
+      // previous search; d2_3D[][] is only used to address pop_heap2_3D
+      for (const int cell : src_heap_3D.touched()) {
+        d1_3D.data()[cell] = BIG_INT;
       }
+      src_heap_3D.clearTouched();
 
       // setup src_heap_3D, dest_heap_3D and initialize d1_3D[][] and
       // d2_3D[][] for all the grids on the two subtrees
@@ -958,7 +875,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                   regionY2);
 
       // while loop to find shortest path
-      int ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
+      int ind1 = (src_heap_3D.top() - &d1_3D[0][0][0]);
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
         pop_heap2_3D[dest_heap_3D[i] - &d2_3D[0][0][0]] = true;
@@ -973,7 +890,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
         const int remd = ind1 % (grid_hv_);
         const int curX = remd % x_range_;
         const int curY = remd / x_range_;
-        removeMin3D(src_heap_3D);
+        src_heap_3D.pop();
 
         const bool Horizontal = (((curL % 2) - layerOrientation) == 0);
 
@@ -995,8 +912,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][curY][tmpX]);
               } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // left neighbor been put into src_heap_3D
                                  // but needs update
@@ -1006,11 +922,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::West;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][curY][tmpX]);
               }
             }
           }
@@ -1032,8 +944,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
-                src_heap_3D.push_back(&d1_3D[curL][curY][tmpX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][curY][tmpX]);
               } else if (d1_3D[curL][curY][tmpX]
                          > tmp)  // right neighbor been put into src_heap_3D
                                  // but needs update
@@ -1043,11 +954,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][curY][tmpX].x = curX;
                 pr_3D_[curL][curY][tmpX].y = curY;
                 directions_3D[curL][curY][tmpX] = Direction::East;
-                const int* dtmp = &d1_3D[curL][curY][tmpX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][curY][tmpX]);
               }
             }
           }
@@ -1069,8 +976,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][tmpY][curX]);
               } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // bottom neighbor been put into
                                  // src_heap_3D but needs update
@@ -1080,11 +986,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::North;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][tmpY][curX]);
               }
             }
           }
@@ -1104,8 +1006,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
-                src_heap_3D.push_back(&d1_3D[curL][tmpY][curX]);
-                updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+                src_heap_3D.push(&d1_3D[curL][tmpY][curX]);
               } else if (d1_3D[curL][tmpY][curX]
                          > tmp)  // top neighbor been put into src_heap_3D
                                  // but needs update
@@ -1115,11 +1016,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                 pr_3D_[curL][tmpY][curX].x = curX;
                 pr_3D_[curL][tmpY][curX].y = curY;
                 directions_3D[curL][tmpY][curX] = Direction::South;
-                const int* dtmp = &d1_3D[curL][tmpY][curX];
-                int ind = 0;
-                while (src_heap_3D[ind] != dtmp)
-                  ind++;
-                updateHeap3D(src_heap_3D, ind);
+                src_heap_3D.decrease(&d1_3D[curL][tmpY][curX]);
               }
             }
           }
@@ -1138,8 +1035,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            src_heap_3D.push(&d1_3D[tmpL][curY][curX]);
           } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
@@ -1149,11 +1045,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Down;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            src_heap_3D.decrease(&d1_3D[tmpL][curY][curX]);
           }
         }
 
@@ -1170,8 +1062,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
-            src_heap_3D.push_back(&d1_3D[tmpL][curY][curX]);
-            updateHeap3D(src_heap_3D, src_heap_3D.size() - 1);
+            src_heap_3D.push(&d1_3D[tmpL][curY][curX]);
           } else if (d1_3D[tmpL][curY][curX]
                      > tmp)  // bottom neighbor been put into src_heap_3D
                              // but needs update
@@ -1181,11 +1072,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
             pr_3D_[tmpL][curY][curX].x = curX;
             pr_3D_[tmpL][curY][curX].y = curY;
             directions_3D[tmpL][curY][curX] = Direction::Up;
-            const int* dtmp = &d1_3D[tmpL][curY][curX];
-            int ind = 0;
-            while (src_heap_3D[ind] != dtmp)
-              ind++;
-            updateHeap3D(src_heap_3D, ind);
+            src_heap_3D.decrease(&d1_3D[tmpL][curY][curX]);
           }
         }
 
@@ -1196,7 +1083,7 @@ void FastRouteCore::mazeRouteMSMDOrder3D(int expand,
                          nets_[netID]->getName());
         }
         // update ind1 for next loop
-        ind1 = (src_heap_3D[0] - &d1_3D[0][0][0]);
+        ind1 = (src_heap_3D.top() - &d1_3D[0][0][0]);
       }  // while loop
 
       for (int i = 0; i < dest_heap_3D.size(); i++)
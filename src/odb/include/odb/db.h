@@ -358,20 +358,22 @@ class dbDatabase : public dbObject
   void read(std::ifstream& f);
 
   ///
-  /// Write a database to this stream.
+  /// Write a database to this stream.  With compress the stream is stored
+  /// as zlib compressed chunks, each with a crc32; the read functions
+  /// recognize that format.
   /// Throws ZIOError..
   ///
-  void write(FILE* file);
+  void write(FILE* file, bool compress = false);
 
   /// Throws ZIOError..
   void writeTech(FILE* file);
   void writeLib(FILE* file, dbLib* lib);
   void writeLibs(FILE* file);
-  void writeBlock(FILE* file, dbBlock* block);
+  void writeBlock(FILE* file, dbBlock* block, bool compress = false);
   void writeChip(FILE* file);
-  void writeWires(FILE* file, dbBlock* block);
-  void writeNets(FILE* file, dbBlock* block);
-  void writeParasitics(FILE* file, dbBlock* block);
+  void writeWires(FILE* file, dbBlock* block, bool compress = false);
+  void writeNets(FILE* file, dbBlock* block, bool compress = false);
+  void writeParasitics(FILE* file, dbBlock* block, bool compress = false);
   void readTech(std::ifstream& f);
   void readLib(std::ifstream& f, dbLib*);
   void readLibs(std::ifstream& f);
@@ -432,6 +434,13 @@ class dbDatabase : public dbObject
   ///
   void setLogger(utl::Logger* logger);
 
+  ///
+  /// Number of threads used to read, write and index the database.
+  /// The default is one.
+  ///
+  void setThreadCount(int threads);
+  int getThreadCount();
+
   ///
   /// Initializes the database to nothing.
   ///
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <vector>
+
+#include "dbBlockCallBackObj.h"
+#include "odb.h"
+
+namespace odb {
+
+class dbBlock;
+class dbInst;
+class dbITerm;
+class dbNet;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbConnectivityIndex - A compressed sparse row snapshot of the iterms of
+/// every net and every instance of a block.
+///
+/// dbNet::getITerms() follows a linked list through the iterm table, which
+/// touches a different table page for almost every pin.  The snapshot
+/// stores the iterms of each net (in the same order as dbNet::getITerms())
+/// and of each instance contiguously, so walking them is a linear scan.
+///
+/// The index registers itself as a callback on the block.  Creating or
+/// destroying nets, instances or iterms, (dis)connecting iterms and
+/// swapping masters drop the snapshot; the next query rebuilds it.
+/// Reversing a net's iterm set only changes the order and is not tracked.
+/// The index is meant for read-mostly phases: while the netlist is being
+/// edited, check isValid() and fall back to dbNet::getITerms() to avoid
+/// rebuilds.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+class dbConnectivityIndex : public dbBlockCallBackObj
+{
+ public:
+  class ITermRange
+  {
+   public:
+    ITermRange(dbITerm* const* begin, dbITerm* const* end)
+        : begin_(begin), end_(end)
+    {
+    }
+
+    dbITerm* const* begin() const { return begin_; }
+    dbITerm* const* end() const { return end_; }
+    uint size() const { return end_ - begin_; }
+    bool empty() const { return begin_ == end_; }
+
+   private:
+    dbITerm* const* begin_;
+    dbITerm* const* end_;
+  };
+
+  explicit dbConnectivityIndex(dbBlock* block);
+
+  ///
+  /// True if the snapshot reflects the current netlist.
+  ///
+  bool isValid() const { return valid_; }
+
+  ///
+  /// Build the snapshot if it is not valid.  The nets and instances are
+  /// processed in parallel on dbDatabase::getThreadCount() threads.
+  ///
+  void build();
+
+  ///
+  /// The iterms of net or inst, building the snapshot if needed.
+  ///
+  ITermRange getITerms(dbNet* net);
+  ITermRange getITerms(dbInst* inst);
+
+  void inDbInstCreate(dbInst*) override { invalidate(); }
+  void inDbInstCreate(dbInst*, dbRegion*) override { invalidate(); }
+  void inDbInstDestroy(dbInst*) override { invalidate(); }
+  void inDbInstSwapMasterAfter(dbInst*) override { invalidate(); }
+  void inDbNetCreate(dbNet*) override { invalidate(); }
+  void inDbNetDestroy(dbNet*) override { invalidate(); }
+  void inDbITermCreate(dbITerm*) override { invalidate(); }
+  void inDbITermDestroy(dbITerm*) override { invalidate(); }
+  void inDbITermPostConnect(dbITerm*) override { invalidate(); }
+  void inDbITermPostDisconnect(dbITerm*, dbNet*) override { invalidate(); }
+  void inDbBlockReadNetsBefore(dbBlock*) override { invalidate(); }
+
+ private:
+  void invalidate() { valid_ = false; }
+
+  dbBlock* block_;
+  bool valid_;
+  // iterms of the net with id i are net_iterms_[net_begin_[i]] up to
+  // net_iterms_[net_begin_[i + 1]]; likewise for instances
+  std::vector<uint> net_begin_;
+  std::vector<dbITerm*> net_iterms_;
+  std::vector<uint> inst_begin_;
+  std::vector<dbITerm*> inst_iterms_;
+};
+
+}  // namespace odb
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "odb.h"
+
+namespace odb {
+
+class dbBlock;
+class dbInst;
+class dbITerm;
+class dbMaster;
+class dbMTerm;
+class dbNet;
+
+///////////////////////////////////////////////////////////////////////////////
+///
+/// dbCreationStage - Netlist edits staged by several threads and applied
+/// to a block in a deterministic order.
+///
+/// dbTable<T>::create and the block name hash tables are not thread-safe,
+/// so nets and instances must be created on one thread.  A stage has one
+/// Arena per task.  Threads record creations and connections in their own
+/// arenas without touching the block; commit() then runs on one thread
+/// and replays the arenas in index order, each in the order it was filled.
+/// The resulting object ids and names therefore depend only on how the
+/// work was split into arenas, never on thread scheduling.
+///
+/// commit() goes through dbNet::create, dbInst::create and
+/// dbITerm::connect, so callbacks and the journal see the usual sequence
+/// of edits.  The staged names are checked first: if any of them is
+/// already in use, or staged twice, nothing is created.
+///
+///////////////////////////////////////////////////////////////////////////////
+
+class dbCreationStage
+{
+ public:
+  ///
+  /// A net or instance staged in an arena.  It can be used by the arena
+  /// that returned it and, after commit(), resolved with getNet() or
+  /// getInst().
+  ///
+  struct Handle
+  {
+    int arena = -1;
+    int index = -1;
+  };
+
+  class Arena
+  {
+   public:
+    Handle createNet(const std::string& name);
+    Handle createInst(dbMaster* master, const std::string& name);
+
+    ///
+    /// Connect the iterm of mterm on a staged instance to a net.
+    ///
+    void connect(Handle inst, dbMTerm* mterm, Handle net);
+    void connect(Handle inst, dbMTerm* mterm, dbNet* net);
+
+    ///
+    /// Move an existing iterm to a staged net.
+    ///
+    void connect(dbITerm* iterm, Handle net);
+
+   private:
+    enum OpType
+    {
+      CREATE_NET,
+      CREATE_INST,
+      CONNECT
+    };
+
+    struct Op
+    {
+      OpType type;
+      int index;       // net or instance created, or instance connected
+      int staged_net;  // staged net connected, if net is null
+      dbMaster* master;
+      dbMTerm* mterm;
+      dbITerm* iterm;
+      dbNet* net;
+    };
+
+    explicit Arena(int id) : id_(id) {}
+
+    int id_;
+    std::vector<std::string> net_names_;
+    std::vector<std::string> inst_names_;
+    std::vector<Op> ops_;
+    std::vector<dbNet*> nets_;
+    std::vector<dbInst*> insts_;
+
+    friend class dbCreationStage;
+  };
+
+  dbCreationStage(dbBlock* block, int arena_count);
+
+  int getArenaCount() const { return arenas_.size(); }
+  Arena& getArena(int i) { return arenas_[i]; }
+
+  ///
+  /// Apply the staged edits to the block and empty the arenas.  Returns
+  /// false, and creates nothing, if a staged name is already taken.
+  ///
+  bool commit();
+
+  ///
+  /// The objects created by the last commit().
+  ///
+  dbNet* getNet(const Handle& net) const;
+  dbInst* getInst(const Handle& inst) const;
+
+ private:
+  bool checkNames() const;
+
+  dbBlock* block_;
+  std::vector<Arena> arenas_;
+};
+
+}  // namespace odb
@@ -35,7 +35,10 @@
 #include <array>
 #include <cstring>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "ZException.h"
 #include "dbObject.h"
@@ -47,12 +50,44 @@ namespace odb {
 
 class _dbDatabase;
 
+// Cuts the bytes written to it into fixed size chunks that are compressed
+// and written with a crc32 each.  Up to one chunk per thread is collected
+// before the chunks are compressed in parallel, so memory stays bounded.
+// finish() writes the last chunks and the end marker.  dbIStream
+// recognizes the container and inflates it transparently.
+class dbCompressedWriter
+{
+  FILE* _f;
+  int _threads;
+  std::string _raw;
+  std::vector<std::string> _chunks;
+  std::vector<uint32_t> _crcs;
+
+  void put(const void* data, size_t size);
+  void writeChunks();
+
+ public:
+  dbCompressedWriter(FILE* f, int threads);
+
+  void write(const void* data, size_t size);
+  void finish();
+};
+
+// Fields are collected in a large buffer that is written with one fwrite
+// when full, instead of one fwrite per field.  flush() must be called
+// before the FILE is flushed or closed.  A stream may instead collect its
+// output in memory, which is how tables are encoded in parallel, or pass
+// it to a dbCompressedWriter.
 class dbOStream
 {
   _dbDatabase* _db;
   FILE* _f;
+  std::string* _sink;
+  dbCompressedWriter* _compressed;
   double _lef_area_factor;
   double _lef_dist_factor;
+  std::unique_ptr<char[]> _buf;
+  size_t _pos;
 
   void write_error()
   {
@@ -60,11 +95,39 @@ class dbOStream
                      strerror(ferror(_f)));
   }
 
+  void writeBytesSlow(const void* data, size_t size);
+  void writeOut(const void* data, size_t size);
+
  public:
+  static constexpr size_t kBufferSize = 1 << 20;
+
   dbOStream(_dbDatabase* db, FILE* f);
+  dbOStream(_dbDatabase* db, std::string& sink);
+  dbOStream(_dbDatabase* db, dbCompressedWriter& compressed);
+  ~dbOStream();
 
   _dbDatabase* getDatabase() { return _db; }
 
+  void writeBytes(const void* data, size_t size)
+  {
+    if (size <= kBufferSize - _pos) {
+      memcpy(_buf.get() + _pos, data, size);
+      _pos += size;
+    } else {
+      writeBytesSlow(data, size);
+    }
+  }
+
+  void flush();
+
+  // Runs each writer on its own in-memory stream, one per database thread,
+  // and appends the results in order, so the bytes match a sequential
+  // write.  Only one writer per thread is held in memory at a time.  With
+  // a single thread the writers run directly on this stream.  The writers
+  // must only read the database.
+  using Writer = std::function<void(dbOStream&)>;
+  void writeInParallel(const std::vector<Writer>& writers);
+
   dbOStream& operator<<(bool c)
   {
     unsigned char b = (c == true ? 1 : 0);
@@ -73,100 +136,67 @@ class dbOStream
 
   dbOStream& operator<<(char c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned char c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int16_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(uint16_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(uint64_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(unsigned int c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(int8_t c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(float c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(double c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
   dbOStream& operator<<(long double c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
@@ -177,10 +207,7 @@ class dbOStream
     } else {
       int l = strlen(c) + 1;
       *this << l;
-      int n = fwrite(c, l, 1, _f);
-      if (n != 1) {
-        write_error();
-      }
+      writeBytes(c, l);
     }
 
     return *this;
@@ -188,10 +215,7 @@ class dbOStream
 
   dbOStream& operator<<(dbObjectType c)
   {
-    int n = fwrite(&c, sizeof(c), 1, _f);
-    if (n != 1) {
-      write_error();
-    }
+    writeBytes(&c, sizeof(c));
     return *this;
   }
 
@@ -248,18 +272,67 @@ class dbOStream
   double lefdist(int value) { return ((double) value * _lef_dist_factor); }
 };
 
+// Wraps "stream << table" for dbOStream::writeInParallel.
+template <typename T>
+dbOStream::Writer tableWriter(const T& table)
+{
+  return [&table](dbOStream& stream) { stream << table; };
+}
+
+// Reads the file in large blocks.  The file position is restored to the
+// end of the consumed data when the stream is destroyed, so several
+// streams can read one file in sequence.  A compressed container is
+// inflated up to one chunk per thread at a time.
 class dbIStream
 {
-  std::ifstream& _f;
+  struct Chunk
+  {
+    uint32_t size;
+    uint32_t compressed_size;
+    uint32_t crc;
+    size_t offset;
+    std::string data;
+  };
+
+  std::ifstream* _f;
   _dbDatabase* _db;
   double _lef_area_factor;
   double _lef_dist_factor;
+  std::unique_ptr<char[]> _buf;
+  const char* _data;
+  size_t _pos;
+  size_t _end;
+
+  // compressed input
+  std::streambuf* _compressed;
+  int _threads;
+  std::vector<Chunk> _chunks;
+  Chunk _next;
+  uint64_t _chunk_index;
+  std::string _inflated;
+
+  void readChunkHeader(Chunk& chunk);
+  bool readChunks();
+  void readBytesSlow(void* data, size_t size);
 
  public:
+  static constexpr size_t kBufferSize = 1 << 20;
+
   dbIStream(_dbDatabase* db, std::ifstream& f);
+  ~dbIStream();
 
   _dbDatabase* getDatabase() { return _db; }
 
+  void readBytes(void* data, size_t size)
+  {
+    if (size <= _end - _pos) {
+      memcpy(data, _data + _pos, size);
+      _pos += size;
+    } else {
+      readBytesSlow(data, size);
+    }
+  }
+
   dbIStream& operator>>(bool& c)
   {
     unsigned char b;
@@ -270,67 +343,67 @@ class dbIStream
 
   dbIStream& operator>>(char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(uint64_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(unsigned int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(int8_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(float& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
   dbIStream& operator>>(long double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
@@ -343,7 +416,7 @@ class dbIStream
       c = nullptr;
     } else {
       c = (char*) malloc(l);
-      _f.read(reinterpret_cast<char*>(c), l);
+      readBytes(c, l);
     }
 
     return *this;
@@ -351,7 +424,7 @@ class dbIStream
 
   dbIStream& operator>>(dbObjectType& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readBytes(&c, sizeof(c));
     return *this;
   }
 
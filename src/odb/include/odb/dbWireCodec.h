@@ -241,6 +241,12 @@ class dbWireEncoder
   ///
   ~dbWireEncoder();
 
+  ///
+  /// Encoders can be moved, e.g. into a vector holding one per wire.
+  ///
+  dbWireEncoder(dbWireEncoder&&) = default;
+  dbWireEncoder& operator=(dbWireEncoder&&) = default;
+
   ///
   /// Begin a new encoding.
   ///
@@ -449,6 +455,12 @@ class dbWireEncoder
   ///
   /// End the encoding and apply the result to the dbWire.
   ///
+  /// Up to this call the encoder only reads the database, so the wires of
+  /// different nets may be encoded concurrently, one encoder per wire.
+  /// end() modifies the block and invokes its callbacks; it must not run
+  /// concurrently with other database edits.  Calling it in a fixed order
+  /// keeps the result deterministic.
+  ///
   void end();
 
   ///
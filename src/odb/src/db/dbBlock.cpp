@@ -920,47 +920,49 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
     stream << block._children;
 
   stream << block._currentCcAdjOrder;
-  stream << *block._bterm_tbl;
-  stream << *block._iterm_tbl;
-  stream << *block._net_tbl;
-  stream << *block._inst_hdr_tbl;
-  stream << *block._inst_tbl;
-  stream << *block._module_tbl;
-  stream << *block._modinst_tbl;
-  stream << *block._powerdomain_tbl;
-  stream << *block._logicport_tbl;
-  stream << *block._powerswitch_tbl;
-  stream << *block._isolation_tbl;
-  stream << *block._group_tbl;
-  stream << *block.ap_tbl_;
-  stream << *block.global_connect_tbl_;
-  stream << *block._guide_tbl;
-  stream << *block._net_tracks_tbl;
-  stream << *block._box_tbl;
-  stream << *block._via_tbl;
-  stream << *block._gcell_grid_tbl;
-  stream << *block._track_grid_tbl;
-  stream << *block._obstruction_tbl;
-  stream << *block._blockage_tbl;
-  stream << *block._wire_tbl;
-  stream << *block._swire_tbl;
-  stream << *block._sbox_tbl;
-  stream << *block._row_tbl;
-  stream << *block._fill_tbl;
-  stream << *block._region_tbl;
-  stream << *block._hier_tbl;
-  stream << *block._bpin_tbl;
-  stream << *block._non_default_rule_tbl;
-  stream << *block._layer_rule_tbl;
-  stream << *block._prop_tbl;
-  stream << *block._name_cache;
-  stream << *block._r_val_tbl;
-  stream << *block._c_val_tbl;
-  stream << *block._cc_val_tbl;
-  stream << *block._cap_node_tbl;  // DKF - 2/21/05
-  stream << *block._r_seg_tbl;     // DKF - 2/21/05
-  stream << *block._cc_seg_tbl;
-  stream << *block._extControl;
+  // The tables don't refer to each other while being written, so they are
+  // encoded concurrently and appended in order.
+  stream.writeInParallel({tableWriter(*block._bterm_tbl),
+                          tableWriter(*block._iterm_tbl),
+                          tableWriter(*block._net_tbl),
+                          tableWriter(*block._inst_hdr_tbl),
+                          tableWriter(*block._inst_tbl),
+                          tableWriter(*block._module_tbl),
+                          tableWriter(*block._modinst_tbl),
+                          tableWriter(*block._powerdomain_tbl),
+                          tableWriter(*block._logicport_tbl),
+                          tableWriter(*block._powerswitch_tbl),
+                          tableWriter(*block._isolation_tbl),
+                          tableWriter(*block._group_tbl),
+                          tableWriter(*block.ap_tbl_),
+                          tableWriter(*block.global_connect_tbl_),
+                          tableWriter(*block._guide_tbl),
+                          tableWriter(*block._net_tracks_tbl),
+                          tableWriter(*block._box_tbl),
+                          tableWriter(*block._via_tbl),
+                          tableWriter(*block._gcell_grid_tbl),
+                          tableWriter(*block._track_grid_tbl),
+                          tableWriter(*block._obstruction_tbl),
+                          tableWriter(*block._blockage_tbl),
+                          tableWriter(*block._wire_tbl),
+                          tableWriter(*block._swire_tbl),
+                          tableWriter(*block._sbox_tbl),
+                          tableWriter(*block._row_tbl),
+                          tableWriter(*block._fill_tbl),
+                          tableWriter(*block._region_tbl),
+                          tableWriter(*block._hier_tbl),
+                          tableWriter(*block._bpin_tbl),
+                          tableWriter(*block._non_default_rule_tbl),
+                          tableWriter(*block._layer_rule_tbl),
+                          tableWriter(*block._prop_tbl),
+                          tableWriter(*block._name_cache),
+                          tableWriter(*block._r_val_tbl),
+                          tableWriter(*block._c_val_tbl),
+                          tableWriter(*block._cc_val_tbl),
+                          tableWriter(*block._cap_node_tbl),
+                          tableWriter(*block._r_seg_tbl),
+                          tableWriter(*block._cc_seg_tbl),
+                          tableWriter(*block._extControl)});
 
   //---------------------------------------------------------- stream out
   // properties
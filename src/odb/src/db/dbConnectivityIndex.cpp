@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbConnectivityIndex.h"
+
+#include <algorithm>
+
+#include "db.h"
+#include "dbBlock.h"
+#include "dbITerm.h"
+#include "dbInst.h"
+#include "dbNet.h"
+#include "dbParallel.h"
+#include "dbTable.h"
+
+namespace odb {
+
+// nets and instances are handed to the threads in blocks of this many
+static constexpr size_t kGrain = 256;
+
+dbConnectivityIndex::dbConnectivityIndex(dbBlock* block)
+    : block_(block), valid_(false)
+{
+  addOwner(block);
+}
+
+void dbConnectivityIndex::build()
+{
+  if (valid_) {
+    return;
+  }
+
+  _dbBlock* block = (_dbBlock*) block_;
+  dbTable<_dbITerm>* iterm_tbl = block->_iterm_tbl;
+  const int threads = block_->getDataBase()->getThreadCount();
+
+  std::vector<_dbNet*> nets;
+  uint max_net_id = 0;
+  for (dbNet* net : block_->getNets()) {
+    nets.push_back((_dbNet*) net);
+    max_net_id = std::max(max_net_id, net->getId());
+  }
+  std::vector<_dbInst*> insts;
+  uint max_inst_id = 0;
+  for (dbInst* inst : block_->getInsts()) {
+    insts.push_back((_dbInst*) inst);
+    max_inst_id = std::max(max_inst_id, inst->getId());
+  }
+
+  // Size every row first so the rows can then be filled independently.
+  // The net rows are counted with one scan of the iterm table rather than
+  // a walk of every net's list.
+  net_begin_.assign(max_net_id + 2, 0);
+  for (dbITerm* iterm : block_->getITerms()) {
+    const uint net_id = ((_dbITerm*) iterm)->_net;
+    if (net_id != 0) {
+      ++net_begin_[net_id + 1];
+    }
+  }
+  inst_begin_.assign(max_inst_id + 2, 0);
+  for (_dbInst* inst : insts) {
+    inst_begin_[inst->getOID() + 1] = inst->_iterms.size();
+  }
+  for (size_t i = 1; i < net_begin_.size(); ++i) {
+    net_begin_[i] += net_begin_[i - 1];
+  }
+  for (size_t i = 1; i < inst_begin_.size(); ++i) {
+    inst_begin_[i] += inst_begin_[i - 1];
+  }
+
+  net_iterms_.resize(net_begin_.back());
+  parallelFor(
+      nets.size(),
+      threads,
+      [&](size_t i) {
+        dbITerm** out = &net_iterms_[net_begin_[nets[i]->getOID()]];
+        for (uint id = nets[i]->_iterms; id != 0;) {
+          _dbITerm* iterm = iterm_tbl->getPtr(id);
+          *out++ = (dbITerm*) iterm;
+          id = iterm->_next_net_iterm;
+        }
+      },
+      kGrain);
+  inst_iterms_.resize(inst_begin_.back());
+  parallelFor(
+      insts.size(),
+      threads,
+      [&](size_t i) {
+        dbITerm** out = &inst_iterms_[inst_begin_[insts[i]->getOID()]];
+        for (uint id : insts[i]->_iterms) {
+          *out++ = (dbITerm*) iterm_tbl->getPtr(id);
+        }
+      },
+      kGrain);
+
+  valid_ = true;
+}
+
+dbConnectivityIndex::ITermRange dbConnectivityIndex::getITerms(dbNet* net)
+{
+  build();
+  const uint id = net->getId();
+  dbITerm* const* iterms = net_iterms_.data();
+  return ITermRange(iterms + net_begin_[id], iterms + net_begin_[id + 1]);
+}
+
+dbConnectivityIndex::ITermRange dbConnectivityIndex::getITerms(dbInst* inst)
+{
+  build();
+  const uint id = inst->getId();
+  dbITerm* const* iterms = inst_iterms_.data();
+  return ITermRange(iterms + inst_begin_[id], iterms + inst_begin_[id + 1]);
+}
+
+}  // namespace odb
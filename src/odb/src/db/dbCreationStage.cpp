@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2023, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbCreationStage.h"
+
+#include <cassert>
+#include <unordered_set>
+
+#include "db.h"
+#include "dbParallel.h"
+
+namespace odb {
+
+dbCreationStage::Handle dbCreationStage::Arena::createNet(
+    const std::string& name)
+{
+  const int index = net_names_.size();
+  net_names_.push_back(name);
+  ops_.push_back({CREATE_NET, index, -1, nullptr, nullptr, nullptr, nullptr});
+  return {id_, index};
+}
+
+dbCreationStage::Handle dbCreationStage::Arena::createInst(
+    dbMaster* master,
+    const std::string& name)
+{
+  const int index = inst_names_.size();
+  inst_names_.push_back(name);
+  ops_.push_back({CREATE_INST, index, -1, master, nullptr, nullptr, nullptr});
+  return {id_, index};
+}
+
+void dbCreationStage::Arena::connect(Handle inst, dbMTerm* mterm, Handle net)
+{
+  assert(inst.arena == id_ && inst.index < (int) inst_names_.size());
+  assert(net.arena == id_ && net.index < (int) net_names_.size());
+  ops_.push_back(
+      {CONNECT, inst.index, net.index, nullptr, mterm, nullptr, nullptr});
+}
+
+void dbCreationStage::Arena::connect(Handle inst, dbMTerm* mterm, dbNet* net)
+{
+  assert(inst.arena == id_ && inst.index < (int) inst_names_.size());
+  ops_.push_back({CONNECT, inst.index, -1, nullptr, mterm, nullptr, net});
+}
+
+void dbCreationStage::Arena::connect(dbITerm* iterm, Handle net)
+{
+  assert(net.arena == id_ && net.index < (int) net_names_.size());
+  ops_.push_back({CONNECT, -1, net.index, nullptr, nullptr, iterm, nullptr});
+}
+
+dbCreationStage::dbCreationStage(dbBlock* block, int arena_count)
+    : block_(block)
+{
+  arenas_.reserve(arena_count);
+  for (int i = 0; i < arena_count; ++i) {
+    arenas_.push_back(Arena(i));
+  }
+}
+
+bool dbCreationStage::checkNames() const
+{
+  // The block lookups only read the hash tables and run in parallel.
+  std::vector<char> taken(arenas_.size(), false);
+  parallelFor(arenas_.size(),
+              block_->getDataBase()->getThreadCount(),
+              [&](size_t i) {
+                for (const std::string& name : arenas_[i].net_names_) {
+                  if (block_->findNet(name.c_str()) != nullptr) {
+                    taken[i] = true;
+                    return;
+                  }
+                }
+                for (const std::string& name : arenas_[i].inst_names_) {
+                  if (block_->findInst(name.c_str()) != nullptr) {
+                    taken[i] = true;
+                    return;
+                  }
+                }
+              });
+  for (char arena_taken : taken) {
+    if (arena_taken) {
+      return false;
+    }
+  }
+
+  std::unordered_set<std::string> net_names;
+  std::unordered_set<std::string> inst_names;
+  for (const Arena& arena : arenas_) {
+    for (const std::string& name : arena.net_names_) {
+      if (!net_names.insert(name).second) {
+        return false;
+      }
+    }
+    for (const std::string& name : arena.inst_names_) {
+      if (!inst_names.insert(name).second) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool dbCreationStage::commit()
+{
+  if (!checkNames()) {
+    return false;
+  }
+
+  for (Arena& arena : arenas_) {
+    arena.nets_.assign(arena.net_names_.size(), nullptr);
+    arena.insts_.assign(arena.inst_names_.size(), nullptr);
+    for (const Arena::Op& op : arena.ops_) {
+      switch (op.type) {
+        case Arena::CREATE_NET:
+          arena.nets_[op.index] = dbNet::create(
+              block_, arena.net_names_[op.index].c_str(), true);
+          break;
+        case Arena::CREATE_INST:
+          arena.insts_[op.index] = dbInst::create(
+              block_, op.master, arena.inst_names_[op.index].c_str());
+          break;
+        case Arena::CONNECT: {
+          dbITerm* iterm = op.iterm;
+          if (iterm == nullptr) {
+            iterm = arena.insts_[op.index]->getITerm(op.mterm);
+          }
+          dbNet* net = op.net;
+          if (net == nullptr) {
+            net = arena.nets_[op.staged_net];
+          }
+          iterm->connect(net);
+          break;
+        }
+      }
+    }
+    arena.net_names_.clear();
+    arena.inst_names_.clear();
+    arena.ops_.clear();
+  }
+  return true;
+}
+
+dbNet* dbCreationStage::getNet(const Handle& net) const
+{
+  return arenas_[net.arena].nets_[net.index];
+}
+
+dbInst* dbCreationStage::getInst(const Handle& inst) const
+{
+  return arenas_[inst.arena].insts_[inst.index];
+}
+
+}  // namespace odb
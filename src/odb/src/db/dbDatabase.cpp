@@ -177,6 +177,7 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */)
   _master_id = 0;
   _file = nullptr;
   _logger = nullptr;
+  _threads = 1;
   _unique_id = db_unique_id++;
 
   _chip_tbl = new dbTable<_dbChip>(
@@ -210,6 +211,7 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, int id)
   _master_id = 0;
   _file = nullptr;
   _logger = nullptr;
+  _threads = 1;
   _unique_id = id;
 
   _chip_tbl = new dbTable<_dbChip>(
@@ -240,7 +242,8 @@ _dbDatabase::_dbDatabase(_dbDatabase* /* unused: db */, const _dbDatabase& d)
       _tech(d._tech),
       _unique_id(db_unique_id++),
       _file(nullptr),
-      _logger(nullptr)
+      _logger(nullptr),
+      _threads(d._threads)
 {
   if (d._file) {
     _file = strdup(d._file);
@@ -512,14 +515,33 @@ void dbDatabase::readChip(std::ifstream& file)
   stream >> *chip;
 }
 
-void dbDatabase::write(FILE* file)
+// Runs writer on a stream to file, compressing it on the way if asked.
+template <typename Writer>
+static void writeStream(_dbDatabase* db,
+                        FILE* file,
+                        bool compress,
+                        const Writer& writer)
 {
-  _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream stream(db, file);
-  stream << *db;
+  if (compress) {
+    dbCompressedWriter compressed(file, db->_threads);
+    dbOStream stream(db, compressed);
+    writer(stream);
+    stream.flush();
+    compressed.finish();
+  } else {
+    dbOStream stream(db, file);
+    writer(stream);
+    stream.flush();
+  }
   fflush(file);
 }
 
+void dbDatabase::write(FILE* file, bool compress)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  writeStream(db, file, compress, [db](dbOStream& stream) { stream << *db; });
+}
+
 void dbDatabase::writeTech(FILE* file)
 {
   _dbDatabase* db = (_dbDatabase*) this;
@@ -530,6 +552,7 @@ void dbDatabase::writeTech(FILE* file)
 
   dbOStream stream(db, file);
   stream << *tech;
+  stream.flush();
   fflush(file);
 }
 
@@ -538,6 +561,7 @@ void dbDatabase::writeLib(FILE* file, dbLib* lib)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *(_dbLib*) lib;
+  stream.flush();
   fflush(file);
 }
 
@@ -546,47 +570,50 @@ void dbDatabase::writeLibs(FILE* file)
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
   stream << *db->_lib_tbl;
+  stream.flush();
   fflush(file);
 }
 
-void dbDatabase::writeBlock(FILE* file, dbBlock* block)
+void dbDatabase::writeBlock(FILE* file, dbBlock* block, bool compress)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream stream(db, file);
-  stream << *(_dbBlock*) block;
-  fflush(file);
+  _dbBlock* b = (_dbBlock*) block;
+  writeStream(db, file, compress, [b](dbOStream& stream) { stream << *b; });
 }
 
-void dbDatabase::writeNets(FILE* file, dbBlock* block)
+void dbDatabase::writeNets(FILE* file, dbBlock* block, bool compress)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream stream(db, file);
-  stream << *((_dbBlock*) block)->_net_tbl;
-  fflush(file);
+  _dbBlock* b = (_dbBlock*) block;
+  writeStream(db, file, compress, [b](dbOStream& stream) {
+    stream << *b->_net_tbl;
+  });
 }
 
-void dbDatabase::writeWires(FILE* file, dbBlock* block)
+void dbDatabase::writeWires(FILE* file, dbBlock* block, bool compress)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream stream(db, file);
-  stream << *((_dbBlock*) block)->_wire_tbl;
-  fflush(file);
+  _dbBlock* b = (_dbBlock*) block;
+  writeStream(db, file, compress, [b](dbOStream& stream) {
+    stream << *b->_wire_tbl;
+  });
 }
 
-void dbDatabase::writeParasitics(FILE* file, dbBlock* block)
+void dbDatabase::writeParasitics(FILE* file, dbBlock* block, bool compress)
 {
   _dbDatabase* db = (_dbDatabase*) this;
-  dbOStream stream(db, file);
-  stream << ((_dbBlock*) block)->_num_ext_corners;
-  stream << ((_dbBlock*) block)->_corner_name_list;
-  stream << *((_dbBlock*) block)->_r_val_tbl;
-  stream << *((_dbBlock*) block)->_c_val_tbl;
-  stream << *((_dbBlock*) block)->_cc_val_tbl;
-  stream << *((_dbBlock*) block)->_cap_node_tbl;
-  stream << *((_dbBlock*) block)->_r_seg_tbl;
-  stream << *((_dbBlock*) block)->_cc_seg_tbl;
-  stream << *((_dbBlock*) block)->_extControl;
-  fflush(file);
+  _dbBlock* b = (_dbBlock*) block;
+  writeStream(db, file, compress, [b](dbOStream& stream) {
+    stream << b->_num_ext_corners;
+    stream << b->_corner_name_list;
+    stream.writeInParallel({tableWriter(*b->_r_val_tbl),
+                            tableWriter(*b->_c_val_tbl),
+                            tableWriter(*b->_cc_val_tbl),
+                            tableWriter(*b->_cap_node_tbl),
+                            tableWriter(*b->_r_seg_tbl),
+                            tableWriter(*b->_cc_seg_tbl),
+                            tableWriter(*b->_extControl)});
+  });
 }
 
 void dbDatabase::writeChip(FILE* file)
@@ -595,6 +622,7 @@ void dbDatabase::writeChip(FILE* file)
   _dbChip* chip = (_dbChip*) getChip();
   dbOStream stream(db, file);
   stream << *chip;
+  stream.flush();
   fflush(file);
 }
 
@@ -677,6 +705,7 @@ void dbDatabase::writeEco(dbBlock* block_, const char* filename)
   if (block->_journal_pending) {
     dbOStream stream(block->getDatabase(), file);
     stream << *block->_journal_pending;
+    stream.flush();
   }
 
   fclose(file);
@@ -702,6 +731,18 @@ void dbDatabase::setLogger(utl::Logger* logger)
   _db->_logger = logger;
 }
 
+void dbDatabase::setThreadCount(int threads)
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  db->_threads = std::max(1, threads);
+}
+
+int dbDatabase::getThreadCount()
+{
+  _dbDatabase* db = (_dbDatabase*) this;
+  return db->_threads;
+}
+
 dbDatabase* dbDatabase::create()
 {
   if (db_tbl == nullptr) {
@@ -717,8 +758,10 @@ void dbDatabase::clear()
 {
   _dbDatabase* db = (_dbDatabase*) this;
   int id = db->_unique_id;
+  int threads = db->_threads;
   db->~_dbDatabase();
   new (db) _dbDatabase(db, id);
+  db->_threads = threads;
 }
 
 void dbDatabase::destroy(dbDatabase* db_)
@@ -127,6 +127,7 @@ class _dbDatabase : public _dbObject
 
   char* _file;
   utl::Logger* _logger;
+  int _threads;
 
   _dbDatabase(_dbDatabase* db);
   _dbDatabase(_dbDatabase* db, int id);
@@ -32,12 +32,24 @@
 
 #include "dbStream.h"
 
+#include <zlib.h>
+
+#include <algorithm>
 #include <iostream>
 
 #include "db.h"
+#include "dbParallel.h"
 
 namespace odb {
 
+// Chunked container written by dbCompressedWriter:
+//   magic, version,
+//   then per chunk: raw size, compressed size, crc32 of the raw bytes, data
+//   and a chunk of raw size zero as the end marker
+static constexpr char kCompressedMagic[4] = {'O', 'D', 'B', 'Z'};
+static constexpr uint32_t kCompressedVersion = 2;
+static constexpr size_t kChunkSize = 4 << 20;
+
 dbOStream& operator<<(dbOStream& stream, const Rect& r)
 {
   stream << r.xlo_;
@@ -86,7 +98,81 @@ dbIStream& operator>>(dbIStream& stream, Oct& o)
   return stream;
 }
 
+dbCompressedWriter::dbCompressedWriter(FILE* f, int threads)
+    : _f(f), _threads(std::max(1, threads))
+{
+  put(kCompressedMagic, sizeof(kCompressedMagic));
+  put(&kCompressedVersion, sizeof(kCompressedVersion));
+}
+
+void dbCompressedWriter::put(const void* data, size_t size)
+{
+  if (fwrite(data, 1, size, _f) != size) {
+    throw ZException("write failed on database stream; system io error: (%s)",
+                     strerror(ferror(_f)));
+  }
+}
+
+void dbCompressedWriter::write(const void* data, size_t size)
+{
+  const size_t window = _threads * kChunkSize;
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const size_t n = std::min(size, window - _raw.size());
+    _raw.append(bytes, n);
+    bytes += n;
+    size -= n;
+    if (_raw.size() == window) {
+      writeChunks();
+    }
+  }
+}
+
+void dbCompressedWriter::writeChunks()
+{
+  const size_t num_chunks = (_raw.size() + kChunkSize - 1) / kChunkSize;
+  _chunks.resize(num_chunks);
+  _crcs.resize(num_chunks);
+  parallelFor(num_chunks, _threads, [&](size_t i) {
+    const Bytef* raw
+        = reinterpret_cast<const Bytef*>(_raw.data()) + i * kChunkSize;
+    const uLong size = std::min(kChunkSize, _raw.size() - i * kChunkSize);
+    uLongf compressed_size = compressBound(size);
+    _chunks[i].resize(compressed_size);
+    if (compress2(reinterpret_cast<Bytef*>(&_chunks[i][0]),
+                  &compressed_size,
+                  raw,
+                  size,
+                  Z_BEST_SPEED)
+        != Z_OK) {
+      throw ZException("compression failed on database chunk");
+    }
+    _chunks[i].resize(compressed_size);
+    _crcs[i] = crc32(0, raw, size);
+  });
+
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const uint32_t size = std::min(kChunkSize, _raw.size() - i * kChunkSize);
+    const uint32_t compressed_size = _chunks[i].size();
+    put(&size, sizeof(size));
+    put(&compressed_size, sizeof(compressed_size));
+    put(&_crcs[i], sizeof(_crcs[i]));
+    put(_chunks[i].data(), compressed_size);
+  }
+  _raw.clear();
+}
+
+void dbCompressedWriter::finish()
+{
+  if (!_raw.empty()) {
+    writeChunks();
+  }
+  const uint32_t end[3] = {0, 0, 0};
+  put(end, sizeof(end));
+}
+
 dbOStream::dbOStream(_dbDatabase* db, FILE* f)
+    : _sink(nullptr), _compressed(nullptr), _buf(new char[kBufferSize]), _pos(0)
 {
   _db = db;
   _f = f;
@@ -101,7 +187,97 @@ dbOStream::dbOStream(_dbDatabase* db, FILE* f)
   }
 }
 
-dbIStream::dbIStream(_dbDatabase* db, std::ifstream& f) : _f(f)
+dbOStream::dbOStream(_dbDatabase* db, std::string& sink)
+    : dbOStream(db, nullptr)
+{
+  _sink = &sink;
+}
+
+dbOStream::dbOStream(_dbDatabase* db, dbCompressedWriter& compressed)
+    : dbOStream(db, nullptr)
+{
+  _compressed = &compressed;
+}
+
+dbOStream::~dbOStream()
+{
+  // Only reached with pending data if an exception skipped flush(); the
+  // error was already reported, so this write is best effort.
+  if (_pos > 0) {
+    if (_sink) {
+      _sink->append(_buf.get(), _pos);
+    } else if (_f) {
+      fwrite(_buf.get(), 1, _pos, _f);
+    }
+  }
+}
+
+void dbOStream::writeOut(const void* data, size_t size)
+{
+  if (_sink) {
+    _sink->append(static_cast<const char*>(data), size);
+  } else if (_compressed) {
+    _compressed->write(data, size);
+  } else if (fwrite(data, 1, size, _f) != size) {
+    write_error();
+  }
+}
+
+void dbOStream::flush()
+{
+  if (_pos > 0) {
+    const size_t size = _pos;
+    _pos = 0;
+    writeOut(_buf.get(), size);
+  }
+}
+
+void dbOStream::writeBytesSlow(const void* data, size_t size)
+{
+  flush();
+  if (size >= kBufferSize) {
+    writeOut(data, size);
+  } else {
+    memcpy(_buf.get(), data, size);
+    _pos = size;
+  }
+}
+
+void dbOStream::writeInParallel(const std::vector<Writer>& writers)
+{
+  const size_t threads = std::max(1, ((dbDatabase*) _db)->getThreadCount());
+  if (threads == 1) {
+    for (const Writer& writer : writers) {
+      writer(*this);
+    }
+    return;
+  }
+
+  std::vector<std::string> parts(std::min(threads, writers.size()));
+  for (size_t begin = 0; begin < writers.size(); begin += parts.size()) {
+    const size_t count = std::min(parts.size(), writers.size() - begin);
+    parallelFor(count, threads, [&](size_t i) {
+      parts[i].clear();
+      dbOStream stream(_db, parts[i]);
+      writers[begin + i](stream);
+      stream.flush();
+    });
+    for (size_t i = 0; i < count; ++i) {
+      writeBytes(parts[i].data(), parts[i].size());
+    }
+  }
+}
+
+dbIStream::dbIStream(_dbDatabase* db, std::ifstream& f)
+    : _f(&f),
+      _buf(new char[kBufferSize]),
+      _data(_buf.get()),
+      _pos(0),
+      _end(0),
+      _compressed(nullptr),
+      _threads(1),
+      _next(),
+      _chunk_index(0)
 {
   _db = db;
 
@@ -114,6 +290,143 @@ dbIStream::dbIStream(_dbDatabase* db, std::ifstream& f) : _f(f)
     _lef_dist_factor = 0.0005;
     _lef_area_factor = 0.00000025;
   }
+
+  std::streambuf* buf = f.rdbuf();
+  char magic[sizeof(kCompressedMagic)];
+  const std::streamsize n = buf->sgetn(magic, sizeof(magic));
+  buf->pubseekoff(-n, std::ios::cur, std::ios::in);
+  if (n == sizeof(magic) && memcmp(magic, kCompressedMagic, n) == 0) {
+    uint32_t version;
+    buf->pubseekoff(n, std::ios::cur, std::ios::in);
+    if (buf->sgetn(reinterpret_cast<char*>(&version), sizeof(version))
+        != sizeof(version)) {
+      throw ZException("read failed on database stream; unexpected eof");
+    }
+    if (version != kCompressedVersion) {
+      throw ZException("unsupported compressed database version %u", version);
+    }
+    _f = nullptr;
+    _compressed = buf;
+    _threads = std::max(1, ((dbDatabase*) db)->getThreadCount());
+    readChunkHeader(_next);
+  }
+}
+
+dbIStream::~dbIStream()
+{
+  // give back what was read ahead
+  if (_f && _pos < _end) {
+    _f->rdbuf()->pubseekoff(
+        -static_cast<std::streamoff>(_end - _pos), std::ios::cur, std::ios::in);
+  }
+}
+
+// Reads the header of the next chunk.  The header is read ahead of the
+// data that needs it so the end marker is consumed with the last chunk.
+void dbIStream::readChunkHeader(Chunk& chunk)
+{
+  uint32_t header[3];
+  if (_compressed->sgetn(reinterpret_cast<char*>(header), sizeof(header))
+      != sizeof(header)) {
+    throw ZException("read failed on database stream; unexpected eof");
+  }
+  chunk.size = header[0];
+  chunk.compressed_size = header[1];
+  chunk.crc = header[2];
+  if (chunk.size > kChunkSize
+      || chunk.compressed_size > compressBound(kChunkSize)
+      || (chunk.size == 0 && chunk.compressed_size != 0)) {
+    throw ZException("compressed database is corrupt; bad chunk %llu",
+                     (unsigned long long) _chunk_index);
+  }
+}
+
+// Reads and inflates up to one chunk per thread.  Returns false at the end
+// of the container.
+bool dbIStream::readChunks()
+{
+  size_t num_chunks = 0;
+  size_t raw_size = 0;
+  while (_next.size != 0 && num_chunks < (size_t) _threads) {
+    if (_chunks.size() == num_chunks) {
+      _chunks.emplace_back();
+    }
+    Chunk& chunk = _chunks[num_chunks++];
+    chunk.size = _next.size;
+    chunk.compressed_size = _next.compressed_size;
+    chunk.crc = _next.crc;
+    chunk.offset = raw_size;
+    chunk.data.resize(chunk.compressed_size);
+    if (_compressed->sgetn(&chunk.data[0], chunk.compressed_size)
+        != static_cast<std::streamsize>(chunk.compressed_size)) {
+      throw ZException("read failed on database stream; unexpected eof");
+    }
+    raw_size += chunk.size;
+    ++_chunk_index;
+    readChunkHeader(_next);
+  }
+
+  _inflated.resize(raw_size);
+  const uint64_t first_index = _chunk_index - num_chunks;
+  parallelFor(num_chunks, _threads, [&](size_t i) {
+    const Chunk& chunk = _chunks[i];
+    Bytef* raw = reinterpret_cast<Bytef*>(&_inflated[0]) + chunk.offset;
+    uLongf size = chunk.size;
+    if (uncompress(raw,
+                   &size,
+                   reinterpret_cast<const Bytef*>(chunk.data.data()),
+                   chunk.compressed_size)
+            != Z_OK
+        || size != chunk.size || crc32(0, raw, size) != chunk.crc) {
+      throw ZException("compressed database is corrupt; bad chunk %llu",
+                       (unsigned long long) (first_index + i));
+    }
+  });
+
+  _data = _inflated.data();
+  _pos = 0;
+  _end = raw_size;
+  return raw_size > 0;
+}
+
+void dbIStream::readBytesSlow(void* data, size_t size)
+{
+  char* dst = static_cast<char*>(data);
+  if (_compressed) {
+    for (;;) {
+      const size_t n = std::min(size, _end - _pos);
+      memcpy(dst, _data + _pos, n);
+      _pos += n;
+      dst += n;
+      size -= n;
+      if (size == 0) {
+        return;
+      }
+      if (!readChunks()) {
+        throw ZException("read failed on database stream; unexpected eof");
+      }
+    }
+  }
+
+  const size_t avail = _end - _pos;
+  memcpy(dst, _buf.get() + _pos, avail);
+  dst += avail;
+  size -= avail;
+  _pos = _end = 0;
+
+  std::streambuf* buf = _f->rdbuf();
+  if (size >= kBufferSize) {
+    if (buf->sgetn(dst, size) != static_cast<std::streamsize>(size)) {
+      throw ZException("read failed on database stream; unexpected eof");
+    }
+    return;
+  }
+  _end = buf->sgetn(_buf.get(), kBufferSize);
+  if (_end < size) {
+    throw ZException("read failed on database stream; unexpected eof");
+  }
+  memcpy(dst, _buf.get(), size);
+  _pos = size;
 }
 
 std::ostream& operator<<(std::ostream& os, const Rect& box)
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 
 #include "dbDiff.h"
@@ -132,6 +133,12 @@ inline dbOStream& operator<<(dbOStream& stream, const dbVector<T>& v)
   unsigned int sz = v.size();
   stream << sz;
 
+  // numbers are stored as their raw bytes, so the whole vector is one copy
+  if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+    stream.writeBytes(v.data(), sz * sizeof(T));
+    return stream;
+  }
+
   typename dbVector<T>::const_iterator itr;
 
   for (itr = v.begin(); itr != v.end(); ++itr) {
@@ -148,6 +155,13 @@ inline dbIStream& operator>>(dbIStream& stream, dbVector<T>& v)
   v.clear();
   unsigned int sz;
   stream >> sz;
+
+  if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+    v.resize(sz);
+    stream.readBytes(v.data(), sz * sizeof(T));
+    return stream;
+  }
+
   v.reserve(sz);
 
   T t;
@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE TestConnectivityIndex
+#include <boost/test/included/unit_test.hpp>
+#include <vector>
+
+#include "db.h"
+#include "dbConnectivityIndex.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+struct F_DEFAULT
+{
+  F_DEFAULT()
+  {
+    db = create2LevetDbNoBTerms();
+    db->setThreadCount(4);
+    block = db->getChip()->getBlock();
+  }
+  ~F_DEFAULT() { dbDatabase::destroy(db); }
+  dbDatabase* db;
+  dbBlock* block;
+};
+
+template <typename Range>
+static vector<dbITerm*> toVector(Range range)
+{
+  return vector<dbITerm*>(range.begin(), range.end());
+}
+
+// The index must list the iterms of every net and instance in the same
+// order as the database.
+static void checkIndex(dbBlock* block, dbConnectivityIndex& index)
+{
+  for (dbNet* net : block->getNets()) {
+    BOOST_TEST(toVector(index.getITerms(net)) == toVector(net->getITerms()));
+  }
+  for (dbInst* inst : block->getInsts()) {
+    BOOST_TEST(toVector(index.getITerms(inst))
+               == toVector(inst->getITerms()));
+  }
+  BOOST_TEST(index.isValid());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_edits, F_DEFAULT)
+{
+  dbConnectivityIndex index(block);
+  checkIndex(block, index);
+
+  dbInst* i1 = block->findInst("i1");
+  dbInst* i3 = block->findInst("i3");
+  dbNet* n1 = block->findNet("n1");
+  dbNet* n7 = block->findNet("n7");
+
+  // connect a second iterm to n1
+  i3->findITerm("a")->connect(n1);
+  BOOST_TEST(!index.isValid());
+  checkIndex(block, index);
+  BOOST_TEST(index.getITerms(n1).size() == 2);
+
+  i3->findITerm("a")->disconnect();
+  BOOST_TEST(!index.isValid());
+  checkIndex(block, index);
+  BOOST_TEST(index.getITerms(n1).size() == 1);
+
+  i3->swapMaster(db->findMaster("or2"));
+  BOOST_TEST(!index.isValid());
+  checkIndex(block, index);
+  BOOST_TEST(index.getITerms(n7).size() == 1);
+
+  dbInst::destroy(i1);
+  BOOST_TEST(!index.isValid());
+  checkIndex(block, index);
+  BOOST_TEST(index.getITerms(n1).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_create, F_DEFAULT)
+{
+  dbConnectivityIndex index(block);
+  checkIndex(block, index);
+
+  dbNet* n8 = dbNet::create(block, "n8");
+  dbInst* i4 = dbInst::create(block, db->findMaster("and2"), "i4");
+  BOOST_TEST(!index.isValid());
+  i4->findITerm("a")->connect(n8);
+  i4->findITerm("b")->connect(n8);
+  checkIndex(block, index);
+  BOOST_TEST(index.getITerms(n8).size() == 2);
+  BOOST_TEST(index.getITerms(i4).size() == 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#define BOOST_TEST_MODULE TestCreationStage
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "db.h"
+#include "dbCreationStage.h"
+#include "helper.cpp"
+
+using namespace odb;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+struct F_DEFAULT
+{
+  F_DEFAULT()
+  {
+    db = create2LevetDbNoBTerms();
+    db->setThreadCount(4);
+    block = db->getChip()->getBlock();
+  }
+  ~F_DEFAULT() { dbDatabase::destroy(db); }
+  dbDatabase* db;
+  dbBlock* block;
+};
+
+static constexpr int kArenas = 8;
+static constexpr int kBuffers = 50;
+
+static string name(const char* prefix, int arena, int i)
+{
+  return prefix + to_string(arena) + "_" + to_string(i);
+}
+
+// One line per net and instance: id, name and the connected nets.
+static vector<string> dump(dbBlock* block)
+{
+  vector<string> lines;
+  for (dbNet* net : block->getNets()) {
+    lines.push_back(to_string(net->getId()) + " " + net->getName());
+  }
+  for (dbInst* inst : block->getInsts()) {
+    string line = to_string(inst->getId()) + " " + inst->getName();
+    for (dbITerm* iterm : inst->getITerms()) {
+      dbNet* net = iterm->getNet();
+      line += " " + (net ? net->getName() : string("-"));
+    }
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+BOOST_FIXTURE_TEST_CASE(test_ordered_commit, F_DEFAULT)
+{
+  dbMaster* and2 = db->findMaster("and2");
+  dbMTerm* a = and2->findMTerm("a");
+  dbMTerm* b = and2->findMTerm("b");
+  dbMTerm* o = and2->findMTerm("o");
+  dbNet* n1 = block->findNet("n1");
+
+  // The same edits made serially, arena after arena.
+  dbDatabase* serial_db = create2LevetDbNoBTerms();
+  dbBlock* serial_block = serial_db->getChip()->getBlock();
+  for (int k = 0; k < kArenas; ++k) {
+    for (int i = 0; i < kBuffers; ++i) {
+      dbNet* net = dbNet::create(serial_block, name("s", k, i).c_str());
+      dbInst* inst
+          = dbInst::create(serial_block, and2, name("b", k, i).c_str());
+      inst->getITerm(a)->connect(net);
+      inst->getITerm(b)->connect(serial_block->findNet("n1"));
+      inst->getITerm(o)->connect(net);
+    }
+  }
+  dbNet* moved = dbNet::create(serial_block, "moved");
+  serial_block->findInst("i3")->findITerm("a")->connect(moved);
+
+  dbCreationStage stage(block, kArenas);
+  dbCreationStage::Handle moved_net;
+  vector<dbCreationStage::Handle> insts(kArenas);
+  vector<std::thread> threads;
+  // Fill the arenas from the last to the first to show that the commit
+  // order does not depend on when the arenas were filled.
+  for (int k = kArenas - 1; k >= 0; --k) {
+    threads.emplace_back([&, k]() {
+      dbCreationStage::Arena& arena = stage.getArena(k);
+      for (int i = 0; i < kBuffers; ++i) {
+        auto net = arena.createNet(name("s", k, i));
+        auto inst = arena.createInst(and2, name("b", k, i));
+        arena.connect(inst, a, net);
+        arena.connect(inst, b, n1);
+        arena.connect(inst, o, net);
+        insts[k] = inst;
+      }
+      if (k == kArenas - 1) {
+        moved_net = arena.createNet("moved");
+        arena.connect(block->findInst("i3")->findITerm("a"), moved_net);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  BOOST_TEST(block->findNet("s0_0") == nullptr);
+
+  BOOST_TEST(stage.commit());
+  BOOST_TEST(dump(block) == dump(serial_block));
+  BOOST_TEST(stage.getNet(moved_net)->getName() == "moved");
+  BOOST_TEST(stage.getInst(insts[3])->getName() == name("b", 3, kBuffers - 1));
+  dbDatabase::destroy(serial_db);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_name_clash, F_DEFAULT)
+{
+  dbMaster* and2 = db->findMaster("and2");
+  const vector<string> before = dump(block);
+
+  dbCreationStage stage(block, 2);
+  stage.getArena(0).createInst(and2, "b0");
+  stage.getArena(1).createNet("n1");
+  BOOST_TEST(!stage.commit());
+  BOOST_TEST(dump(block) == before);
+
+  dbCreationStage twice(block, 2);
+  twice.getArena(0).createNet("s0");
+  twice.getArena(1).createNet("s0");
+  BOOST_TEST(!twice.commit());
+  BOOST_TEST(dump(block) == before);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,50 @@
+# write_db -compress round trip and detection of a corrupt chunk
+source "helpers.tcl"
+
+set db [ord::get_db]
+read_lef "data/gscl45nm.lef"
+read_def "data/design.def"
+
+set_thread_count 2
+
+set plain_file [make_result_file "db_read_write_plain.odb"]
+set compressed_file [make_result_file "db_read_write_compressed.odb"]
+write_db $plain_file
+write_db -compress $compressed_file
+
+set plain_db [odb::dbDatabase_create]
+odb::read_db $plain_db $plain_file
+set compressed_db [odb::dbDatabase_create]
+odb::read_db $compressed_db $compressed_file
+
+if { [odb::db_diff $plain_db $compressed_db] } {
+  puts "FAIL: Differences found between plain and compressed db"
+  exit 1
+}
+
+# Flip a byte inside the first chunk, past the 8 byte container header and
+# the 12 byte chunk header.
+set stream [open $compressed_file rb]
+set bytes [read $stream]
+close $stream
+binary scan $bytes @64c byte
+set bytes [string replace $bytes 64 64 \
+             [binary format c [expr { $byte ^ 0x55 }]]]
+set corrupt_file [make_result_file "db_read_write_corrupt.odb"]
+set stream [open $corrupt_file wb]
+puts -nonewline $stream $bytes
+close $stream
+
+if { ![catch { odb::read_db [odb::dbDatabase_create] $corrupt_file } msg] } {
+  puts "FAIL: Corrupt chunk was not detected"
+  exit 1
+}
+if { ![string match "*corrupt*" $msg] } {
+  puts "FAIL: Unexpected error reading corrupt db: $msg"
+  exit 1
+}
+
+file delete diffs.rpt
+
+puts "pass"
+exit 0
@@ -33,6 +33,7 @@ record_tests {
 
 record_pass_fail_tests {
   cpp_tests
+  db_read_write_compressed
   dump_netlists
   dump_netlists_withfill
   parser_unit_test
@@ -317,6 +317,10 @@ public:
   // resizeSlackPreamble must be called before the first findResizeSlacks.
   void resizeSlackPreamble();
   void findResizeSlacks();
+  // Incremental flavor of findResizeSlacks for repeated passes.
+  // Only the parasitics of moved_nets and of nets touched by the previous
+  // pass are re-estimated; the rest keep their previous estimates.
+  void findResizeSlacks(const vector<dbNet*> &moved_nets);
   // Return nets with worst slack.
   NetSeq &resizeWorstSlackNets();
   // Return net slack, if any (indicated by the bool).
@@ -1150,6 +1150,29 @@ Resizer::findResizeSlacks()
   findResizeSlacks1();
   journalRestore(resize_count_, inserted_buffer_count_, cloned_gate_count_);
 }
+
+void
+Resizer::findResizeSlacks(const vector<dbNet*> &moved_nets)
+{
+  // Nothing to update incrementally before the first full estimate.
+  if (parasitics_src_ != ParasiticsSrc::placement) {
+    findResizeSlacks();
+    return;
+  }
+  journalBegin();
+  // The journal restore of the previous pass already left the nets it
+  // touched in parasitics_invalid_.
+  for (dbNet *db_net : moved_nets)
+    parasiticsInvalid(db_net);
+  updateParasitics();
+  int repaired_net_count, slew_violations, cap_violations;
+  int fanout_violations, length_violations;
+  repair_design_->repairDesign(max_wire_length_, 0.0, 0.0,
+                               repaired_net_count, slew_violations, cap_violations,
+                               fanout_violations, length_violations);
+  findResizeSlacks1();
+  journalRestore(resize_count_, inserted_buffer_count_, cloned_gate_count_);
+}
   
 void
 Resizer::findResizeSlacks1()